@@ -0,0 +1,336 @@
+/* Copyright 2018 by Multy.io
+ * Licensed under Multy.io license.
+ *
+ * See LICENSE for details
+ */
+
+/** Concurrency stress test and scaling benchmark for the public C API.
+ *
+ * Runs each workload on 1, 2, 4, ... up to max threads, every thread
+ * repeatedly calling the library with no external synchronization,
+ * and reports throughput and speedup relative to a single thread.
+ * Every result is checked against one made on the main thread beforehand,
+ * so the program exits with non-zero status on any error or mismatch.
+ *
+ * Usage: multy_bench_concurrency [--duration-ms=N] [--max-threads=N] [workload...]
+ * Build with MULTY_WITH_THREAD_SANITIZER=ON to check for data races.
+ */
+
+#include "multy_core/account.h"
+#include "multy_core/big_int.h"
+#include "multy_core/binary_data.h"
+#include "multy_core/blockchain.h"
+#include "multy_core/error.h"
+#include "multy_core/ethereum.h"
+#include "multy_core/json_api.h"
+#include "multy_core/properties.h"
+#include "multy_core/transaction.h"
+
+#include "multy_core/src/error_utility.h"
+#include "multy_core/src/u_ptr.h"
+#include "multy_core/src/utility.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using namespace multy_core::internal;
+
+const BlockchainType ETHEREUM_RINKEBY = {BLOCKCHAIN_ETHEREUM, ETHEREUM_CHAIN_ID_RINKEBY};
+const char* PRIVATE_KEY = "5a37680b86fabdec299fa02bdfba8c9dfad08d796dc58c1d07527a751905bf71";
+
+const char* TRANSACTION_JSON = R"json({
+    "blockchain": "Ethereum",
+    "net_type": 4,
+    "account": {
+        "type": 0,
+        "private_key": "5a37680b86fabdec299fa02bdfba8c9dfad08d796dc58c1d07527a751905bf71"
+    },
+    "builder": {
+        "type": "basic",
+        "payload":{
+            "balance": "7500000000000000000",
+            "destination_address": "0xd1b48a11e2251555c3c6d8b93e13f9aa2f51ea19",
+            "destination_amount": "2305843009213693952"
+        }
+    },
+    "transaction": {
+        "nonce": 4,
+        "fee": {
+            "gas_price": "64424509440",
+            "gas_limit": "21001"
+        }
+    }
+})json";
+
+void set_big_int(Properties* properties, const char* name, const char* value)
+{
+    BigIntPtr big_int;
+    throw_if_error(make_big_int(value, reset_sp(big_int)));
+    throw_if_error(properties_set_big_int_value(properties, name, big_int.get()));
+}
+
+std::string to_hex(const BinaryData& data)
+{
+    static const char DIGITS[] = "0123456789abcdef";
+    std::string result;
+    result.reserve(data.len * 2);
+    for (size_t i = 0; i < data.len; ++i)
+    {
+        result.push_back(DIGITS[data.data[i] >> 4]);
+        result.push_back(DIGITS[data.data[i] & 0x0F]);
+    }
+    return result;
+}
+
+std::string run_make_account()
+{
+    AccountPtr account;
+    throw_if_error(make_account(ETHEREUM_RINKEBY, ACCOUNT_TYPE_DEFAULT,
+            PRIVATE_KEY, reset_sp(account)));
+
+    ConstCharPtr address;
+    throw_if_error(account_get_address_string(account.get(), reset_sp(address)));
+
+    return address.get();
+}
+
+std::string run_make_transaction()
+{
+    AccountPtr account;
+    throw_if_error(make_account(ETHEREUM_RINKEBY, ACCOUNT_TYPE_DEFAULT,
+            PRIVATE_KEY, reset_sp(account)));
+
+    TransactionPtr transaction;
+    throw_if_error(make_transaction(account.get(), reset_sp(transaction)));
+
+    Properties* properties = nullptr;
+    throw_if_error(transaction_get_properties(transaction.get(), &properties));
+    set_big_int(properties, "nonce", "4");
+
+    Properties* source = nullptr;
+    throw_if_error(transaction_add_source(transaction.get(), &source));
+    set_big_int(source, "amount", "7500000000000000000");
+
+    Properties* destination = nullptr;
+    throw_if_error(transaction_add_destination(transaction.get(), &destination));
+    set_big_int(destination, "amount", "2305843009213693952");
+    throw_if_error(properties_set_string_value(destination, "address",
+            "d1b48a11e2251555c3c6d8b93e13f9aa2f51ea19"));
+
+    Properties* fee = nullptr;
+    throw_if_error(transaction_get_fee(transaction.get(), &fee));
+    set_big_int(fee, "gas_price", "64424509440");
+    set_big_int(fee, "gas_limit", "21001");
+
+    BinaryDataPtr serialized;
+    throw_if_error(transaction_serialize(transaction.get(), reset_sp(serialized)));
+
+    return to_hex(*serialized);
+}
+
+std::string run_make_transaction_from_json()
+{
+    ConstCharPtr result;
+    throw_if_error(make_transaction_from_json(TRANSACTION_JSON, reset_sp(result)));
+
+    return result.get();
+}
+
+struct Workload
+{
+    const char* name;
+    std::string (*run)();
+    // JSON API account cache is set to this capacity before running the workload.
+    size_t account_cache_capacity;
+};
+
+const Workload WORKLOADS[] = {
+    {"make_account", &run_make_account, 0},
+    {"make_transaction", &run_make_transaction, 0},
+    {"make_transaction_from_json", &run_make_transaction_from_json, 0},
+    {"make_transaction_from_json_cached", &run_make_transaction_from_json, 16},
+};
+
+struct RunResult
+{
+    size_t operations;
+    size_t failures;
+    double seconds;
+};
+
+RunResult run_workload(const Workload& workload,
+        const std::string& expected,
+        size_t threads_count,
+        std::chrono::milliseconds duration)
+{
+    std::atomic<bool> is_started(false);
+    std::atomic<bool> is_stopped(false);
+    std::atomic<size_t> operations(0);
+    std::atomic<size_t> failures(0);
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threads_count; ++i)
+    {
+        threads.emplace_back([&]()
+        {
+            while (!is_started)
+            {
+                std::this_thread::yield();
+            }
+
+            size_t thread_operations = 0;
+            size_t thread_failures = 0;
+            while (!is_stopped)
+            {
+                try
+                {
+                    if (workload.run() != expected)
+                    {
+                        ++thread_failures;
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    if (thread_failures == 0)
+                    {
+                        fprintf(stderr, "%s failed: %s\n", workload.name, e.what());
+                    }
+                    ++thread_failures;
+                }
+                ++thread_operations;
+            }
+            operations += thread_operations;
+            failures += thread_failures;
+        });
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    is_started = true;
+    std::this_thread::sleep_for(duration);
+    is_stopped = true;
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    return RunResult{operations, failures, elapsed.count()};
+}
+
+std::vector<size_t> get_threads_counts(size_t max_threads)
+{
+    std::vector<size_t> result;
+    for (size_t threads = 1; threads < max_threads; threads *= 2)
+    {
+        result.push_back(threads);
+    }
+    result.push_back(max_threads);
+
+    return result;
+}
+
+bool parse_size_argument(const char* argument, const char* prefix, size_t* value)
+{
+    const size_t prefix_length = strlen(prefix);
+    if (strncmp(argument, prefix, prefix_length) != 0)
+    {
+        return false;
+    }
+    *value = static_cast<size_t>(strtoull(argument + prefix_length, nullptr, 10));
+
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    size_t duration_ms = 1000;
+    size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<const Workload*> workloads;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (parse_size_argument(argv[i], "--duration-ms=", &duration_ms)
+                || parse_size_argument(argv[i], "--max-threads=", &max_threads))
+        {
+            continue;
+        }
+
+        const auto workload = std::find_if(std::begin(WORKLOADS), std::end(WORKLOADS),
+                [&](const Workload& w) { return strcmp(w.name, argv[i]) == 0; });
+        if (workload == std::end(WORKLOADS))
+        {
+            fprintf(stderr, "Usage: %s [--duration-ms=N] [--max-threads=N] [workload...]\n"
+                    "Workloads:", argv[0]);
+            for (const auto& w : WORKLOADS)
+            {
+                fprintf(stderr, " %s", w.name);
+            }
+            fprintf(stderr, "\n");
+            return EXIT_FAILURE;
+        }
+        workloads.push_back(workload);
+    }
+    if (workloads.empty())
+    {
+        for (const auto& workload : WORKLOADS)
+        {
+            workloads.push_back(&workload);
+        }
+    }
+    max_threads = std::max<size_t>(max_threads, 1);
+
+    size_t total_failures = 0;
+    for (const Workload* workload : workloads)
+    {
+        std::string expected;
+        try
+        {
+            throw_if_error(json_api_set_account_cache_capacity(
+                    workload->account_cache_capacity));
+            expected = workload->run();
+        }
+        catch (const std::exception& e)
+        {
+            fprintf(stderr, "%s failed: %s\n", workload->name, e.what());
+            ++total_failures;
+            continue;
+        }
+
+        printf("%s\n%8s %14s %9s %11s %9s\n", workload->name,
+                "threads", "ops/s", "speedup", "efficiency", "failures");
+
+        double single_thread_throughput = 0;
+        for (const size_t threads_count : get_threads_counts(max_threads))
+        {
+            const RunResult result = run_workload(*workload, expected,
+                    threads_count, std::chrono::milliseconds(duration_ms));
+            const double throughput = result.operations / result.seconds;
+            if (threads_count == 1)
+            {
+                single_thread_throughput = throughput;
+            }
+            const double speedup = single_thread_throughput > 0
+                    ? throughput / single_thread_throughput : 0;
+
+            printf("%8zu %14.1f %8.2fx %10.1f%% %9zu\n",
+                    threads_count, throughput, speedup,
+                    speedup * 100 / threads_count, result.failures);
+            fflush(stdout);
+            total_failures += result.failures;
+        }
+        printf("\n");
+    }
+
+    return total_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
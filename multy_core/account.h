@@ -68,6 +68,26 @@ MULTY_CORE_API struct Error* make_hd_leaf_account(
         uint32_t index,
         struct Account** new_account);
 
+/** Derive addresses of leaf HD accounts for a range of indices.
+ *
+ * Same as make_hd_leaf_account() + account_get_address_string() for each
+ * index in [first_index, first_index + count), but much faster.
+ * All addresses are stored in one contiguous buffer of NUL-terminated strings,
+ * out_addresses[0] points to the beginning of that buffer and
+ * MUST be freed by caller with free_string(), other items point inside of it.
+ * @param base_account - base account, for which leafs are generated.
+ * @param address_type - type of address for account: internal or external.
+ * @param first_index - index of the first leaf account within base account.
+ * @param count - number of addresses to derive, must be non-zero.
+ * @param out_addresses - (out) caller-allocated array of count pointers.
+ */
+MULTY_CORE_API struct Error* hd_account_derive_addresses(
+        const struct HDAccount* base_account,
+        enum AddressType address_type,
+        uint32_t first_index,
+        uint32_t count,
+        const char** out_addresses);
+
 /** Make regular account from private key and Blockchain.
  * @param Blockchain - Blockchain to use account for.
  * @param account_type - ACCOUNT_TYPE_DEFAULT or blockchain-specific account type.
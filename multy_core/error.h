@@ -143,6 +143,7 @@ enum ErrorCode
     ERROR_TRANSACTION_TOKEN_TRANSFER_MISSING_METHOD,
     ERROR_TRANSACTION_TOKEN_TRANSFER_INVALID_STANDARD,
     ERROR_TRANSACTION_TOKEN_TRANSFER_INVALID_METHOD,
+    ERROR_TRANSACTION_BUFFER_TOO_SMALL,
 
     ERROR_TRANSACTION_SOURCE_SPECIFIC_ERROR_BASE = MULTY_SCOPE_SPECIFIC_ERROR_BASE(ERROR_SCOPE_TRANSACTION_SOURCE),
     ERROR_TRANSACTION_SOURCE_INVALID_PREV_TX_SCRIPT_PUBKEY,
@@ -25,6 +25,45 @@ struct Transaction;
  */
 MULTY_CORE_API struct Error* make_transaction_from_json(const char* json_string, const char** out_transaction_json);
 
+/** Make many transactions from JSON at once, processing them in parallel.
+ *  Each request is handled independently, failure of one doesn't affect others.
+ *  @param json_string - either JSON array of requests or newline-delimited JSON
+ *      (one request per line, empty lines are skipped), each request is the
+ *      same as for make_transaction_from_json().
+ *  @param threads_count - number of threads to use, including the calling one,
+ *      0 means as many as there are cores.
+ *  @param out_transactions_json - JSON array with results in the order of requests,
+ *      each is either same as make_transaction_from_json() output or
+ *      {"error":{"code":<ErrorCode>,"message":"..."}} if request has failed.
+ *  @return Error non null if input can't be split into requests, null otherwise.
+ */
+MULTY_CORE_API struct Error* make_transactions_from_json(const char* json_string,
+        size_t threads_count,
+        const char** out_transactions_json);
+
+/** Set capacity of cache of accounts made from private keys in JSON requests.
+ *  Cache is disabled (capacity is 0) by default, enabling it saves decoding
+ *  and validating same private key again and again, e.g. for a hot wallet.
+ *  Cached keys are never exposed, when capacity is exceeded least recently used
+ *  accounts are evicted and their private key data is wiped.
+ *  @param capacity - max number of cached accounts, 0 disables caching
+ *      and evicts everything.
+ *  @return Error non null if something went wrong, null otherwise.
+ */
+MULTY_CORE_API struct Error* json_api_set_account_cache_capacity(size_t capacity);
+
+/** Get number of accounts currently in the cache.
+ *  @param out_size - number of cached accounts.
+ *  @return Error non null if something went wrong, null otherwise.
+ */
+MULTY_CORE_API struct Error* json_api_get_account_cache_size(size_t* out_size);
+
+/** Evict all accounts from the cache, wiping their private key data.
+ *  Capacity is unchanged.
+ *  @return Error non null if something went wrong, null otherwise.
+ */
+MULTY_CORE_API struct Error* json_api_purge_account_cache();
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -9,6 +9,7 @@
 
 #include "multy_core/api.h"
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -94,6 +95,47 @@ MULTY_CORE_API struct Error* properties_set_private_key_value(
         const char* name,
         const struct PrivateKey* value);
 
+enum PropertyValueType
+{
+    PROPERTY_VALUE_TYPE_INT32,
+    PROPERTY_VALUE_TYPE_STRING,
+    PROPERTY_VALUE_TYPE_BIG_INT,
+    PROPERTY_VALUE_TYPE_BINARY_DATA,
+    PROPERTY_VALUE_TYPE_PRIVATE_KEY,
+};
+
+/** Named value of a property, type of the value is determined by the type tag.
+ * Values are not owned and only have to be valid during properties_set_values() call.
+ */
+struct PropertyValue
+{
+    const char* name;
+    enum PropertyValueType type;
+    union
+    {
+        int32_t int32_value;
+        const char* string_value;
+        const struct BigInt* big_int_value;
+        const struct BinaryData* binary_data_value;
+        const struct PrivateKey* private_key_value;
+    } value;
+};
+
+/** Set multiple property values at once.
+ *
+ * Same as calling properties_set_*_value() for each of values in order.
+ * All values are checked for null names and null pointers first, nothing is
+ * set if any of those is invalid. If setting some value fails, values before
+ * it remain set.
+ * @param properties - non null valid properties object.
+ * @param values - array of count values, may be null if count is 0.
+ * @param count - number of values.
+ * @return null if no error, Error object otherwise.
+ */
+MULTY_CORE_API struct Error* properties_set_values(
+        struct Properties* properties,
+        const struct PropertyValue* values,
+        size_t count);
 
 /** Reset property value by key name.
  *
@@ -6,9 +6,19 @@
 
 #include "multy_core/src/account_base.h"
 
+#include "multy_core/binary_data.h"
+#include "multy_core/src/error_utility.h"
 #include "multy_core/src/exception.h"
+#include "multy_core/src/exception_stream.h"
 #include "multy_core/src/api/key_impl.h"
 #include "multy_core/src/utility.h"
+#include "multy_core/src/worker_pool.h"
+
+#include "wally_crypto.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
 
 namespace
 {
@@ -32,6 +42,10 @@ static_assert(
         BIP44_TESTNET_CHAIN_CODE == 0x80000001,
         "invalid hardened index derivation function implementation");
 
+// Deriving a single address is quick, so it is not worth to start
+// a thread for fewer addresses than that.
+const uint32_t MIN_ADDRESSES_PER_THREAD = 64;
+
 } // namepace
 
 namespace multy_core
@@ -134,5 +148,96 @@ AccountPtr HDAccountBase::make_leaf_account(
     return  make_account(*key_ptr, type, index);
 }
 
+std::vector<std::string> HDAccountBase::derive_addresses(
+        AddressType type, uint32_t first_index, uint32_t count) const
+{
+    if (first_index >= HARDENED_INDEX_BASE
+            || count > HARDENED_INDEX_BASE - first_index)
+    {
+        THROW_EXCEPTION2(ERROR_INVALID_ARGUMENT,
+                "Address indices must not exceed non-hardened index range.")
+                << " First index: " << first_index << ", count: " << count << ".";
+    }
+
+    // Private parent -> public child, leafs are derived with public keys only,
+    // that way no private keys are derived and no private keys are
+    // converted to public ones.
+    ExtendedKey chain_public_key;
+    THROW_IF_WALLY_ERROR2(
+            bip32_key_from_parent(
+                    &m_account_key->key, static_cast<uint32_t>(type),
+                    BIP32_FLAG_KEY_PUBLIC, &chain_public_key.key),
+            ERROR_KEY_CANT_DERIVE_CHILD_KEY,
+            "Failed to make public child key.");
+
+    std::vector<std::string> result(count);
+    auto derive_range = [this, &chain_public_key, &result, first_index](
+            size_t begin, size_t end)
+    {
+        ext_key leaf_key;
+        const size_t key_size = sizeof(leaf_key.pub_key);
+        std::vector<uint8_t> public_keys((end - begin) * key_size);
+        for (size_t i = begin; i < end; ++i)
+        {
+            THROW_IF_WALLY_ERROR2(
+                    bip32_key_from_parent(
+                            &chain_public_key.key,
+                            first_index + static_cast<uint32_t>(i),
+                            BIP32_FLAG_KEY_PUBLIC | BIP32_FLAG_SKIP_HASH,
+                            &leaf_key),
+                    ERROR_KEY_CANT_DERIVE_CHILD_KEY,
+                    "Failed to make public child key.");
+            std::copy(leaf_key.pub_key, leaf_key.pub_key + key_size,
+                    public_keys.begin() + (i - begin) * key_size);
+        }
+        make_addresses_from_public_keys(
+                as_binary_data(public_keys), &result[begin]);
+    };
+
+    const size_t threads_count = std::min<size_t>(
+            std::max(1u, std::thread::hardware_concurrency()),
+            count / MIN_ADDRESSES_PER_THREAD);
+    if (threads_count <= 1)
+    {
+        derive_range(0, count);
+        return result;
+    }
+
+    // Calling thread is also doing the work.
+    WorkerPool pool(threads_count - 1);
+    const size_t chunk_size = (count + threads_count - 1) / threads_count;
+    pool.run_for_each(threads_count, [&](size_t chunk)
+    {
+        derive_range(chunk * chunk_size,
+                std::min<size_t>((chunk + 1) * chunk_size, count));
+    });
+
+    return result;
+}
+
+std::string HDAccountBase::make_address_from_public_key(
+        const BinaryData& /*public_key*/) const
+{
+    THROW_EXCEPTION2(ERROR_FEATURE_NOT_SUPPORTED,
+            "Deriving address from public key is not supported for this blockchain.")
+            << " Blockchain: " << to_string(get_blockchain_type()) << ".";
+
+    return std::string();
+}
+
+void HDAccountBase::make_addresses_from_public_keys(
+        const BinaryData& public_keys, std::string* addresses) const
+{
+    const size_t key_size = EC_PUBLIC_KEY_LEN;
+    INVARIANT(public_keys.len % key_size == 0);
+    INVARIANT(addresses != nullptr || public_keys.len == 0);
+
+    for (size_t i = 0; i < public_keys.len / key_size; ++i)
+    {
+        addresses[i] = make_address_from_public_key(
+                slice(public_keys, i * key_size, key_size));
+    }
+}
+
 } // namespace multy_core
 } // namespace internal
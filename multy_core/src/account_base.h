@@ -18,8 +18,10 @@
 #include <array>
 #include <memory>
 #include <stddef.h>
+#include <string>
 #include <vector>
 
+struct BinaryData;
 struct ExtendedKey;
 
 namespace multy_core
@@ -60,6 +62,11 @@ public:
 
     AccountPtr make_leaf_account(AddressType type, uint32_t index) const override;
 
+    // Derives leaf public keys from the public (xpub) key of the chain,
+    // without private keys, on as many threads as there are cores.
+    std::vector<std::string> derive_addresses(
+            AddressType type, uint32_t first_index, uint32_t count) const override;
+
 protected:
     HDAccountBase(
             BlockchainType blockchain_type,
@@ -76,6 +83,16 @@ protected:
             AddressType type,
             uint32_t index) const = 0;
 
+    // Same as make_account(...)->get_address(), but from the compressed
+    // public key of the leaf. Throws ERROR_FEATURE_NOT_SUPPORTED by default.
+    virtual std::string make_address_from_public_key(const BinaryData& public_key) const;
+
+    // Same as make_address_from_public_key() for each of compressed public
+    // keys laid back to back in public_keys, addresses must have room for
+    // all of them. Override to process all keys at once.
+    virtual void make_addresses_from_public_keys(
+            const BinaryData& public_keys, std::string* addresses) const;
+
 private:
     const BlockchainType m_blockchain_type;
     ExtendedKeyPtr m_account_key;
@@ -0,0 +1,167 @@
+/* Copyright 2018 by Multy.io
+ * Licensed under Multy.io license.
+ *
+ * See LICENSE for details
+ */
+
+#include "multy_core/src/account_cache.h"
+
+#include "multy_core/src/api/account_impl.h"
+#include "multy_core/src/blockchain_facade_base.h"
+#include "multy_core/src/error_utility.h"
+
+#include "wally_core.h"
+#include "wally_crypto.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace multy_core
+{
+namespace internal
+{
+
+size_t AccountCache::DigestHasher::operator()(const Digest& digest) const
+{
+    // Digest is already uniformly distributed.
+    size_t result = 0;
+    memcpy(&result, digest.data(), sizeof(result));
+
+    return result;
+}
+
+AccountCache::AccountCache(size_t capacity)
+    : m_mutex(),
+      m_capacity(capacity),
+      m_digest_key(),
+      m_entries(),
+      m_index()
+{
+    std::random_device random;
+    for (auto& byte : m_digest_key)
+    {
+        byte = static_cast<uint8_t>(random());
+    }
+}
+
+AccountCache::~AccountCache()
+{
+    purge();
+    wally_bzero(m_digest_key.data(), m_digest_key.size());
+}
+
+AccountCache::AccountSharedPtr AccountCache::get_account(
+        const BlockchainFacadeBase& facade,
+        BlockchainType blockchain_type,
+        uint32_t account_type,
+        const char* serialized_private_key)
+{
+    // Invalid arguments are left for make_account() to report.
+    if (serialized_private_key == nullptr || get_capacity() == 0)
+    {
+        return AccountSharedPtr(facade.make_account(
+                blockchain_type, account_type, serialized_private_key));
+    }
+
+    const Digest digest = make_digest(
+            blockchain_type, account_type, serialized_private_key);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto i = m_index.find(digest);
+        if (i != m_index.end())
+        {
+            m_entries.splice(m_entries.begin(), m_entries, i->second);
+            return i->second->second;
+        }
+    }
+
+    // Making an account is slow, so it is done without holding the lock,
+    // if some other thread has cached same account meanwhile, that one is used.
+    AccountSharedPtr account(facade.make_account(
+            blockchain_type, account_type, serialized_private_key));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto i = m_index.find(digest);
+    if (i != m_index.end())
+    {
+        m_entries.splice(m_entries.begin(), m_entries, i->second);
+        return i->second->second;
+    }
+    if (m_capacity == 0)
+    {
+        return account;
+    }
+
+    m_entries.emplace_front(digest, account);
+    m_index.emplace(digest, m_entries.begin());
+    evict(m_capacity);
+
+    return account;
+}
+
+void AccountCache::set_capacity(size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_capacity = capacity;
+    evict(m_capacity);
+}
+
+size_t AccountCache::get_capacity() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_capacity;
+}
+
+size_t AccountCache::get_size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+void AccountCache::purge()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    evict(0);
+}
+
+AccountCache::Digest AccountCache::make_digest(
+        BlockchainType blockchain_type,
+        uint32_t account_type,
+        const char* serialized_private_key) const
+{
+    const uint64_t header[] = {
+        static_cast<uint64_t>(blockchain_type.blockchain),
+        static_cast<uint64_t>(blockchain_type.net_type),
+        static_cast<uint64_t>(account_type)
+    };
+    const size_t key_size = strlen(serialized_private_key);
+
+    std::vector<uint8_t> message(sizeof(header) + key_size);
+    memcpy(message.data(), header, sizeof(header));
+    memcpy(message.data() + sizeof(header), serialized_private_key, key_size);
+
+    Digest result;
+    const int wally_result = wally_hmac_sha256(
+            m_digest_key.data(), m_digest_key.size(),
+            message.data(), message.size(),
+            result.data(), result.size());
+    wally_bzero(message.data(), message.size());
+    THROW_IF_WALLY_ERROR(wally_result, "Failed to compute account cache key.");
+
+    return result;
+}
+
+void AccountCache::evict(size_t max_size)
+{
+    while (m_entries.size() > max_size)
+    {
+        Entry& entry = m_entries.back();
+        m_index.erase(entry.first);
+        wally_bzero(entry.first.data(), entry.first.size());
+        m_entries.pop_back();
+    }
+}
+
+} // namespace internal
+} // namespace multy_core
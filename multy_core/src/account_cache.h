@@ -0,0 +1,96 @@
+/* Copyright 2018 by Multy.io
+ * Licensed under Multy.io license.
+ *
+ * See LICENSE for details
+ */
+
+#ifndef MULTY_CORE_SRC_ACCOUNT_CACHE_H
+#define MULTY_CORE_SRC_ACCOUNT_CACHE_H
+
+#include "multy_core/api.h"
+#include "multy_core/blockchain.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+struct Account;
+
+namespace multy_core
+{
+namespace internal
+{
+class BlockchainFacadeBase;
+
+/** Bounded LRU cache of accounts made from serialized private keys.
+ *
+ * Entries are looked up by HMAC-SHA256 of blockchain type, account type and
+ * serialized key, with a random per-cache HMAC key, so neither the key string
+ * nor its plain hash is stored. Evicted accounts are destroyed as soon as
+ * the last user releases them, which wipes private key data.
+ *
+ * Thread-safe. Capacity of 0 (default) disables caching altogether.
+ */
+class MULTY_CORE_API AccountCache
+{
+public:
+    typedef std::shared_ptr<Account> AccountSharedPtr;
+
+    explicit AccountCache(size_t capacity = 0);
+    ~AccountCache();
+
+    AccountCache(const AccountCache&) = delete;
+    AccountCache& operator=(const AccountCache&) = delete;
+
+    /** Returns cached account or makes new one with facade.make_account().
+     * Errors of make_account() are propagated, failures are not cached.
+     */
+    AccountSharedPtr get_account(const BlockchainFacadeBase& facade,
+            BlockchainType blockchain_type,
+            uint32_t account_type,
+            const char* serialized_private_key);
+
+    /// Evicts least recently used entries if there are more than capacity.
+    void set_capacity(size_t capacity);
+    size_t get_capacity() const;
+
+    /// Number of cached accounts.
+    size_t get_size() const;
+
+    /// Evicts all entries.
+    void purge();
+
+private:
+    typedef std::array<uint8_t, 32> Digest;
+    typedef std::pair<Digest, AccountSharedPtr> Entry;
+    typedef std::list<Entry> Entries;
+
+    struct DigestHasher
+    {
+        size_t operator()(const Digest& digest) const;
+    };
+
+    Digest make_digest(BlockchainType blockchain_type,
+            uint32_t account_type,
+            const char* serialized_private_key) const;
+
+    // Must be called with m_mutex locked.
+    void evict(size_t max_size);
+
+private:
+    mutable std::mutex m_mutex;
+    size_t m_capacity;
+    Digest m_digest_key;
+    // Most recently used first.
+    Entries m_entries;
+    std::unordered_map<Digest, Entries::iterator, DigestHasher> m_index;
+};
+
+} // namespace internal
+} // namespace multy_core
+
+#endif // MULTY_CORE_SRC_ACCOUNT_CACHE_H
@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace
 {
@@ -71,6 +72,46 @@ Error* make_hd_leaf_account(
     return nullptr;
 }
 
+Error* hd_account_derive_addresses(
+        const HDAccount* base_account,
+        AddressType address_type,
+        uint32_t first_index,
+        uint32_t count,
+        const char** out_addresses)
+{
+    ARG_CHECK_OBJECT(base_account);
+    ARG_CHECK(address_type == ADDRESS_INTERNAL
+            || address_type == ADDRESS_EXTERNAL);
+    ARG_CHECK(first_index < HARDENED_INDEX_BASE);
+    ARG_CHECK(count != 0);
+    ARG_CHECK(count <= HARDENED_INDEX_BASE - first_index);
+    ARG_CHECK(out_addresses);
+
+    try
+    {
+        const std::vector<std::string> addresses = base_account->derive_addresses(
+                address_type, first_index, count);
+
+        std::string buffer;
+        for (const auto& address : addresses)
+        {
+            buffer.append(address.c_str(), address.size() + 1);
+        }
+
+        char* result = copy_string(buffer.data(), buffer.size());
+        for (size_t i = 0, offset = 0; i < addresses.size(); ++i)
+        {
+            out_addresses[i] = result + offset;
+            offset += addresses[i].size() + 1;
+        }
+    }
+    CATCH_EXCEPTION_RETURN_ERROR(ERROR_SCOPE_ACCOUNT);
+
+    OUT_CHECK(out_addresses[0]);
+
+    return nullptr;
+}
+
 Error* make_account(
         BlockchainType blockchain,
         uint32_t account_type,
@@ -33,6 +33,19 @@ HDAccount::HDAccount()
 HDAccount::~HDAccount()
 {}
 
+std::vector<std::string> HDAccount::derive_addresses(
+        AddressType type, uint32_t first_index, uint32_t count) const
+{
+    std::vector<std::string> result;
+    result.reserve(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        result.push_back(make_leaf_account(type, first_index + i)->get_address());
+    }
+
+    return result;
+}
+
 const void* HDAccount::get_object_magic()
 {
     RETURN_MAGIC();
@@ -15,6 +15,9 @@
 #include "multy_core/src/hd_path.h"
 #include "multy_core/src/u_ptr.h"
 
+#include <string>
+#include <vector>
+
 // Declared a struct (and out of multy_core::internal namespace)
 // for consitency with a C-like interface.
 // Exported only to make testing easier.
@@ -59,6 +62,12 @@ public:
     virtual AccountPtr make_leaf_account(AddressType type, uint32_t index) const = 0;
     virtual ExtendedKeyPtr get_account_key() const = 0;
 
+    // Addresses of leaf accounts with indices [first_index, first_index + count),
+    // same as calling make_leaf_account(type, i)->get_address() for each index,
+    // which is what default implementation does.
+    virtual std::vector<std::string> derive_addresses(
+            AddressType type, uint32_t first_index, uint32_t count) const;
+
     static const void* get_object_magic();
 };
 
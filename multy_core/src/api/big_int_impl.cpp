@@ -6,11 +6,14 @@
 
 #include "multy_core/src/api/big_int_impl.h"
 
+#include "multy_core/src/codec.h"
 #include "multy_core/src/exception.h"
+#include "multy_core/src/exception_stream.h"
 #include "multy_core/src/utility.h"
 
 #include "multy_test/value_printers.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 
@@ -37,51 +40,322 @@ int validate_for_math(const double& value)
     return category;
 }
 
-template <typename T>
-void unsigned_import(T value, mpz_t gmp_value)
+typedef uint64_t Magnitude[2];
+
+const size_t INLINE_BITS = sizeof(Magnitude) * 8;
+
+int compare_magnitudes(const Magnitude& left, const Magnitude& right)
 {
-    mpz_import(gmp_value, 1, -1, sizeof(value), 0, 0, &value);
+    if (left[1] != right[1])
+    {
+        return left[1] < right[1] ? -1 : 1;
+    }
+    if (left[0] != right[0])
+    {
+        return left[0] < right[0] ? -1 : 1;
+    }
+    return 0;
 }
 
-template <typename T>
-void signed_import(T value, mpz_t gmp_value)
+bool add_magnitudes(const Magnitude& left, const Magnitude& right, Magnitude* result)
 {
-    if (value < 0)
+    const uint64_t low = left[0] + right[0];
+    const uint64_t carry = low < left[0] ? 1 : 0;
+    const uint64_t high = left[1] + right[1];
+    if (high < left[1] || high + carry < high)
+    {
+        return false;
+    }
+    (*result)[0] = low;
+    (*result)[1] = high + carry;
+    return true;
+}
+
+// left must be not less than right.
+void subtract_magnitudes(const Magnitude& left, const Magnitude& right, Magnitude* result)
+{
+    const uint64_t borrow = left[0] < right[0] ? 1 : 0;
+    (*result)[0] = left[0] - right[0];
+    (*result)[1] = left[1] - right[1] - borrow;
+}
+
+bool multiply_magnitudes(const Magnitude& left, const Magnitude& right, Magnitude* result)
+{
+    if (left[1] != 0 && right[1] != 0)
+    {
+        return false;
+    }
+
+    uint64_t low = 0;
+    uint64_t high = 0;
+    multiply_uint64(left[0], right[0], &low, &high);
+
+    // At most one of cross products is non-zero.
+    uint64_t cross_low = 0;
+    uint64_t cross_high = 0;
+    if (left[1] != 0)
     {
-        value = std::abs(value);
-        unsigned_import(value, gmp_value);
-        mpz_mul_si(gmp_value, gmp_value, -1);
+        multiply_uint64(left[1], right[0], &cross_low, &cross_high);
     }
     else
     {
-        unsigned_import(value, gmp_value);
+        multiply_uint64(left[0], right[1], &cross_low, &cross_high);
+    }
+
+    if (cross_high != 0 || high + cross_low < high)
+    {
+        return false;
+    }
+    (*result)[0] = low;
+    (*result)[1] = high + cross_low;
+    return true;
+}
+
+void import_magnitude(bool is_negative, const Magnitude& magnitude, mpz_t value)
+{
+    mpz_import(value, 2, -1, sizeof(magnitude[0]), 0, 0, magnitude);
+    if (is_negative)
+    {
+        mpz_neg(value, value);
+    }
+}
+
+// Values up to 256 bits are converted to and from strings without mpz_t.
+typedef uint64_t WideMagnitude[4];
+
+const uint64_t DECIMAL_CHUNK_DIGITS = 19; // 10^19 is the biggest power of 10 in uint64_t.
+const size_t MAX_WIDE_DECIMAL_DIGITS = 78; // 10^78 > 2^256.
+const size_t MAX_WIDE_HEX_DIGITS = sizeof(WideMagnitude) * 2;
+const uint32_t FORMAT_CHUNK_BASE = 1000000000;
+const size_t FORMAT_CHUNK_DIGITS = 9;
+
+bool is_zero_magnitude(const WideMagnitude& magnitude)
+{
+    return (magnitude[0] | magnitude[1] | magnitude[2] | magnitude[3]) == 0;
+}
+
+// magnitude = magnitude * multiplier + addend, returns false on overflow.
+bool multiply_add(uint64_t multiplier, uint64_t addend, WideMagnitude* magnitude)
+{
+    uint64_t carry = addend;
+    for (uint64_t& limb : *magnitude)
+    {
+        uint64_t low = 0;
+        uint64_t high = 0;
+        multiply_uint64(limb, multiplier, &low, &high);
+        limb = low + carry;
+        carry = high + (limb < low ? 1 : 0);
+    }
+    return carry == 0;
+}
+
+// Divides magnitude in place, returns remainder.
+uint32_t divide_small(uint32_t divisor, WideMagnitude* magnitude)
+{
+    // Divides by 32-bit halves, so no 128-bit division is required.
+    uint64_t remainder = 0;
+    for (size_t i = 4; i > 0; --i)
+    {
+        uint64_t& limb = (*magnitude)[i - 1];
+        const uint64_t high = (remainder << 32) | (limb >> 32);
+        remainder = high % divisor;
+        const uint64_t low = (remainder << 32) | (limb & 0xFFFFFFFF);
+        remainder = low % divisor;
+        limb = ((high / divisor) << 32) | (low / divisor);
+    }
+    return static_cast<uint32_t>(remainder);
+}
+
+// Returns false if there are non-digit characters or value doesn't fit.
+bool parse_decimal(const char* digits, size_t size, WideMagnitude* magnitude)
+{
+    if (size == 0 || size > MAX_WIDE_DECIMAL_DIGITS)
+    {
+        return false;
+    }
+
+    memset(*magnitude, 0, sizeof(*magnitude));
+    // First chunk is shorter, so all others are exactly DECIMAL_CHUNK_DIGITS.
+    size_t chunk_size = size % DECIMAL_CHUNK_DIGITS;
+    if (chunk_size == 0)
+    {
+        chunk_size = DECIMAL_CHUNK_DIGITS;
+    }
+
+    for (const char* chunk_end = digits + chunk_size;
+            chunk_end <= digits + size; chunk_end += DECIMAL_CHUNK_DIGITS)
+    {
+        uint64_t chunk = 0;
+        uint64_t multiplier = 1;
+        for (const char* p = chunk_end - chunk_size; p != chunk_end; ++p)
+        {
+            if (*p < '0' || *p > '9')
+            {
+                return false;
+            }
+            chunk = chunk * 10 + (*p - '0');
+            multiplier *= 10;
+        }
+        if (!multiply_add(multiplier, chunk, magnitude))
+        {
+            return false;
+        }
+        chunk_size = DECIMAL_CHUNK_DIGITS;
+    }
+
+    return true;
+}
+
+int get_hex_digit_value(char digit)
+{
+    if (digit >= '0' && digit <= '9')
+    {
+        return digit - '0';
+    }
+    if (digit >= 'a' && digit <= 'f')
+    {
+        return digit - 'a' + 10;
+    }
+    if (digit >= 'A' && digit <= 'F')
+    {
+        return digit - 'A' + 10;
+    }
+    return -1;
+}
+
+// Returns false if there are non-hex characters or value doesn't fit.
+bool parse_hex(const char* digits, size_t size, WideMagnitude* magnitude)
+{
+    while (size > 0 && *digits == '0')
+    {
+        ++digits;
+        --size;
+    }
+    if (size > MAX_WIDE_HEX_DIGITS)
+    {
+        return false;
+    }
+
+    memset(*magnitude, 0, sizeof(*magnitude));
+    for (size_t i = 0; i < size; ++i)
+    {
+        const int value = get_hex_digit_value(digits[size - 1 - i]);
+        if (value < 0)
+        {
+            return false;
+        }
+        (*magnitude)[i / 16] |= static_cast<uint64_t>(value) << ((i % 16) * 4);
+    }
+
+    return true;
+}
+
+// Writes digits backwards, ending just before end, returns pointer to the first one.
+char* format_decimal(WideMagnitude* magnitude, char* end)
+{
+    char* begin = end;
+    do
+    {
+        uint32_t chunk = divide_small(FORMAT_CHUNK_BASE, magnitude);
+        const bool is_last = is_zero_magnitude(*magnitude);
+        size_t written = 0;
+        do
+        {
+            *--begin = static_cast<char>('0' + chunk % 10);
+            chunk /= 10;
+            ++written;
+        } while (is_last ? chunk != 0 : written < FORMAT_CHUNK_DIGITS);
+    } while (!is_zero_magnitude(*magnitude));
+
+    return begin;
+}
+
+size_t get_magnitude_size_in_bytes(const Magnitude& magnitude)
+{
+    if (magnitude[1] != 0)
+    {
+        return sizeof(magnitude[0]) + get_bytes_len(magnitude[1]);
     }
+    return get_bytes_len(magnitude[0]);
 }
 
 } // namespace
 
+// Read-only mpz_t representation of the BigInt value,
+// temporary copy is made for inline values.
+class BigInt::MpzView
+{
+public:
+    explicit MpzView(const BigInt& value)
+        : m_temporary_value(),
+          m_value(value.m_value)
+    {
+        if (value.m_is_inline)
+        {
+            mpz_init(m_temporary_value);
+            import_magnitude(value.m_is_negative, value.m_magnitude,
+                    m_temporary_value);
+            m_value = m_temporary_value;
+        }
+    }
+
+    ~MpzView()
+    {
+        if (m_value == m_temporary_value)
+        {
+            mpz_clear(m_temporary_value);
+        }
+    }
+
+    mpz_srcptr get() const
+    {
+        return m_value;
+    }
+
+private:
+    MpzView(const MpzView&) = delete;
+    MpzView& operator=(const MpzView&) = delete;
+
+    mpz_t m_temporary_value;
+    mpz_srcptr m_value;
+};
+
+const size_t BigInt::UINT256_STRING_BUFFER_SIZE;
+
 BigInt::BigInt(const char* value)
+    : BigInt()
 {
-    THROW_IF_WALLY_ERROR2(
-            mpz_init_set_str(m_value, value, 10),
-            ERROR_BIG_INT_INVALID_STRING,
-            "Failed to initialize BigInt from string.");
+    set_value(value);
 }
 
 BigInt::BigInt(int32_t value)
+    : BigInt(static_cast<int64_t>(value))
 {
-    mpz_init_set_si(m_value, value);
 }
 
 BigInt::BigInt(const BigInt& other)
+    : m_is_inline(other.m_is_inline),
+      m_is_negative(other.m_is_negative),
+      m_magnitude{other.m_magnitude[0], other.m_magnitude[1]}
 {
-    mpz_init_set(m_value, other.m_value);
+    if (m_is_inline)
+    {
+        mpz_init(m_value);
+    }
+    else
+    {
+        mpz_init_set(m_value, other.m_value);
+    }
 }
 
 BigInt::BigInt(BigInt&& other)
+    : m_is_inline(other.m_is_inline),
+      m_is_negative(other.m_is_negative),
+      m_magnitude{other.m_magnitude[0], other.m_magnitude[1]}
 {
-    std::swap(m_value, other.m_value);
+    memcpy(m_value, other.m_value, sizeof(m_value));
     mpz_init(other.m_value);
+    other.set_inline(false, Magnitude{0, 0});
 }
 
 BigInt& BigInt::operator=(BigInt&& other)
@@ -91,28 +365,44 @@ BigInt& BigInt::operator=(BigInt&& other)
         return *this;
     }
 
-    memmove(m_value, other.m_value, sizeof(m_value));
+    mpz_clear(m_value);
+    memcpy(m_value, other.m_value, sizeof(m_value));
     mpz_init(other.m_value);
 
+    m_is_inline = other.m_is_inline;
+    m_is_negative = other.m_is_negative;
+    m_magnitude[0] = other.m_magnitude[0];
+    m_magnitude[1] = other.m_magnitude[1];
+    other.set_inline(false, Magnitude{0, 0});
+
     return *this;
 }
 
 BigInt::BigInt(int64_t value)
+    : m_is_inline(true),
+      m_is_negative(value < 0),
+      // Negation in unsigned domain to handle INT64_MIN properly.
+      m_magnitude{value < 0 ? 0 - static_cast<uint64_t>(value)
+                            : static_cast<uint64_t>(value), 0}
 {
     mpz_init(m_value);
-    signed_import(value, m_value);
 }
 
 BigInt::BigInt(uint64_t value)
+    : m_is_inline(true),
+      m_is_negative(false),
+      m_magnitude{value, 0}
 {
     mpz_init(m_value);
-    unsigned_import(value, m_value);
 }
 
 BigInt::BigInt(double value)
+    : BigInt()
 {
     validate_for_math(value);
-    mpz_init_set_d(m_value, value);
+    mpz_set_d(m_value, value);
+    m_is_inline = false;
+    normalize();
 }
 
 BigInt& BigInt::operator=(const BigInt& other)
@@ -122,8 +412,19 @@ BigInt& BigInt::operator=(const BigInt& other)
         return *this;
     }
 
-    mpz_clear(m_value);
-    mpz_init_set(m_value, other.m_value);
+    if (other.m_is_inline)
+    {
+        mpz_clear(m_value);
+        mpz_init(m_value);
+    }
+    else
+    {
+        mpz_set(m_value, other.m_value);
+    }
+    m_is_inline = other.m_is_inline;
+    m_is_negative = other.m_is_negative;
+    m_magnitude[0] = other.m_magnitude[0];
+    m_magnitude[1] = other.m_magnitude[1];
 
     return *this;
 }
@@ -133,13 +434,161 @@ BigInt::~BigInt()
     mpz_clear(m_value);
 }
 
+void BigInt::set_inline(bool is_negative, const InlineMagnitude& magnitude)
+{
+    m_magnitude[0] = magnitude[0];
+    m_magnitude[1] = magnitude[1];
+    m_is_inline = true;
+    // There is no negative zero.
+    m_is_negative = is_negative && !is_zero();
+}
+
+void BigInt::set_limbs(bool is_negative, const uint64_t* limbs, size_t limbs_count)
+{
+    while (limbs_count > 0 && limbs[limbs_count - 1] == 0)
+    {
+        --limbs_count;
+    }
+
+    if (limbs_count <= INLINE_LIMBS_COUNT)
+    {
+        Magnitude magnitude = {0, 0};
+        std::copy(limbs, limbs + limbs_count, magnitude);
+
+        mpz_clear(m_value);
+        mpz_init(m_value);
+        set_inline(is_negative, magnitude);
+        return;
+    }
+
+    mpz_import(m_value, limbs_count, -1, sizeof(limbs[0]), 0, 0, limbs);
+    if (is_negative)
+    {
+        mpz_neg(m_value, m_value);
+    }
+    m_is_inline = false;
+}
+
+void BigInt::promote_to_mpz()
+{
+    if (!m_is_inline)
+    {
+        return;
+    }
+    import_magnitude(m_is_negative, m_magnitude, m_value);
+    m_is_inline = false;
+}
+
+void BigInt::normalize()
+{
+    if (m_is_inline || mpz_sizeinbase(m_value, 2) > INLINE_BITS)
+    {
+        return;
+    }
+
+    Magnitude magnitude = {0, 0};
+    mpz_export(magnitude, nullptr, -1, sizeof(magnitude[0]), 0, 0, m_value);
+    const bool is_negative = mpz_sgn(m_value) < 0;
+
+    mpz_clear(m_value);
+    mpz_init(m_value);
+    set_inline(is_negative, magnitude);
+}
+
+bool BigInt::is_zero() const
+{
+    if (m_is_inline)
+    {
+        return m_magnitude[0] == 0 && m_magnitude[1] == 0;
+    }
+    return mpz_sgn(m_value) == 0;
+}
+
+bool BigInt::add_inline(bool other_is_negative, const InlineMagnitude& other)
+{
+    Magnitude result;
+    bool is_negative = m_is_negative;
+    if (m_is_negative == other_is_negative)
+    {
+        if (!add_magnitudes(m_magnitude, other, &result))
+        {
+            return false;
+        }
+    }
+    else if (compare_magnitudes(m_magnitude, other) >= 0)
+    {
+        subtract_magnitudes(m_magnitude, other, &result);
+    }
+    else
+    {
+        subtract_magnitudes(other, m_magnitude, &result);
+        is_negative = other_is_negative;
+    }
+    set_inline(is_negative, result);
+
+    return true;
+}
+
+bool BigInt::multiply_inline(const BigInt& other)
+{
+    Magnitude result;
+    if (!multiply_magnitudes(m_magnitude, other.m_magnitude, &result))
+    {
+        return false;
+    }
+    set_inline(m_is_negative != other.m_is_negative, result);
+
+    return true;
+}
+
 void BigInt::set_value(const char* value)
 {
-    *this = BigInt(value);
+    const bool is_negative = value[0] == '-';
+    const char* digits = value + (is_negative ? 1 : 0);
+
+    WideMagnitude magnitude;
+    if (parse_decimal(digits, strlen(digits), &magnitude))
+    {
+        set_limbs(is_negative, magnitude, 4);
+        return;
+    }
+
+    // Whitespaces, invalid characters and huge values are handled by mini-gmp.
+    BigInt result;
+    if (mpz_set_str(result.m_value, value, 10) != 0)
+    {
+        THROW_EXCEPTION2(ERROR_BIG_INT_INVALID_STRING,
+                "Failed to initialize BigInt from string.");
+    }
+    result.m_is_inline = false;
+    result.normalize();
+
+    *this = std::move(result);
+}
+
+void BigInt::set_value_as_hex(const char* value, size_t size)
+{
+    WideMagnitude magnitude;
+    if ((size & 1) == 0 && parse_hex(value, size, &magnitude))
+    {
+        set_limbs(false, magnitude, 4);
+        return;
+    }
+
+    // Reports errors for invalid input the same way as other hex values.
+    const BinaryDataPtr binary = decode(value, size, CODEC_HEX);
+    set_value_as_binary_data(EXPORT_BIG_ENDIAN, *binary);
 }
 
 std::string BigInt::get_value() const
 {
+    if (m_is_inline || mpz_sizeinbase(m_value, 2) <= sizeof(WideMagnitude) * 8)
+    {
+        char buffer[UINT256_STRING_BUFFER_SIZE];
+        const size_t length = get_value(buffer, sizeof(buffer));
+        return std::string(buffer, length);
+    }
+
     // +1 for null-terminator, +1 for sign.
     std::string result(mpz_sizeinbase(m_value, 10) + 2, '\0');
     mpz_get_str(const_cast<char*>(result.data()), 10, m_value);
@@ -148,23 +597,75 @@ std::string BigInt::get_value() const
     return result;
 }
 
+size_t BigInt::get_value(char* buffer, size_t buffer_size) const
+{
+    INVARIANT(buffer != nullptr);
+
+    if (!m_is_inline && mpz_sizeinbase(m_value, 2) > sizeof(WideMagnitude) * 8)
+    {
+        const std::string value = get_value();
+        if (value.size() >= buffer_size)
+        {
+            THROW_EXCEPTION2(ERROR_INVALID_ARGUMENT,
+                    "Buffer is too small for BigInt value.")
+                    << " Required size: " << value.size() + 1
+                    << " available size: " << buffer_size;
+        }
+        memcpy(buffer, value.c_str(), value.size() + 1);
+        return value.size();
+    }
+
+    WideMagnitude magnitude = {0, 0, 0, 0};
+    bool is_negative = m_is_negative;
+    if (m_is_inline)
+    {
+        magnitude[0] = m_magnitude[0];
+        magnitude[1] = m_magnitude[1];
+    }
+    else
+    {
+        mpz_export(magnitude, nullptr, -1, sizeof(magnitude[0]), 0, 0, m_value);
+        is_negative = mpz_sgn(m_value) < 0;
+    }
+
+    char digits[UINT256_STRING_BUFFER_SIZE];
+    char* const end = digits + sizeof(digits);
+    char* begin = format_decimal(&magnitude, end);
+    if (is_negative)
+    {
+        *--begin = '-';
+    }
+
+    const size_t length = end - begin;
+    if (length >= buffer_size)
+    {
+        THROW_EXCEPTION2(ERROR_INVALID_ARGUMENT,
+                "Buffer is too small for BigInt value.")
+                << " Required size: " << length + 1
+                << " available size: " << buffer_size;
+    }
+    memcpy(buffer, begin, length);
+    buffer[length] = '\0';
+
+    return length;
+}
+
 uint64_t BigInt::get_value_as_uint64() const
 {
-    if (mpz_sgn(m_value) < 0 || mpz_sizeinbase(m_value, 2) > sizeof(uint64_t) * 8)
+    if (!m_is_inline || m_is_negative || m_magnitude[1] != 0)
     {
         THROW_EXCEPTION2(ERROR_BIG_INT_TOO_BIG_FOR_UINT64,
                 "BigInt value is not representable as uint64_t.");
     }
-    uint64_t result = 0;
-    mpz_export(&result, 0, -1, sizeof(result), 0, 0, m_value);
 
-    return result;
+    return m_magnitude[0];
 }
 
 bool BigInt::is_representable_as_int64() const
 {
     // < due to sign bit.
-    return mpz_sizeinbase(m_value, 2) < sizeof(int64_t) * 8;
+    return m_is_inline && m_magnitude[1] == 0
+            && m_magnitude[0] < (static_cast<uint64_t>(1) << 63);
 }
 
 int64_t BigInt::get_value_as_int64() const
@@ -175,9 +676,8 @@ int64_t BigInt::get_value_as_int64() const
                 "BigInt value is too big for int64_t.");
     }
 
-    int64_t result = 0;
-    mpz_export(&result, 0, -1, sizeof(result), 0, 0, m_value);
-    if (mpz_sgn(m_value) < 0)
+    int64_t result = static_cast<int64_t>(m_magnitude[0]);
+    if (m_is_negative)
     {
         result *= -1;
     }
@@ -187,6 +687,11 @@ int64_t BigInt::get_value_as_int64() const
 
 size_t BigInt::get_exported_size_in_bytes() const
 {
+    if (m_is_inline)
+    {
+        return std::max<size_t>(get_magnitude_size_in_bytes(m_magnitude), 1);
+    }
+
     const size_t limbs_count = mpz_size(m_value);
     if (limbs_count == 0)
     {
@@ -202,58 +707,160 @@ size_t BigInt::get_exported_size_in_bytes() const
 
 BinaryDataPtr BigInt::export_as_binary_data(BigInt::ExportFormat format) const
 {
-    const size_t estimated_size = get_exported_size_in_bytes();
-
     BinaryDataPtr result;
-    throw_if_error(make_binary_data(estimated_size, reset_sp(result)));
+    throw_if_error(make_binary_data(get_exported_size_in_bytes(), reset_sp(result)));
+    export_as_binary_data(format, result.get());
+
+    return result;
+}
+
+void BigInt::export_as_binary_data(ExportFormat format, BinaryData* output) const
+{
+    INVARIANT(output != nullptr);
+
+    const size_t size = get_exported_size_in_bytes();
+    if (size > output->len)
+    {
+        THROW_EXCEPTION2(ERROR_INVALID_ARGUMENT,
+                "BigInt value doesn't fit into the output buffer.")
+                << " Required size: " << size
+                << " available size: " << output->len;
+    }
+
+    uint8_t* out = const_cast<uint8_t*>(output->data);
+    memset(out, 0, output->len);
+    if (m_is_inline)
+    {
+        // Magnitude only, same as mpz_export().
+        for (size_t i = 0; i < size; ++i)
+        {
+            const size_t position = (format == EXPORT_BIG_ENDIAN)
+                    ? output->len - 1 - i : i;
+            out[position] = static_cast<uint8_t>(m_magnitude[i / 8] >> ((i % 8) * 8));
+        }
+        return;
+    }
 
     const int word_order = (format == EXPORT_BIG_ENDIAN) ? 1 : -1;
     const int byte_order = word_order;
+    const size_t offset = (format == EXPORT_BIG_ENDIAN) ? output->len - size : 0;
     size_t result_size = 0;
-    mpz_export(const_cast<uint8_t*>(result->data), &result_size, word_order,
-            result->len, byte_order, 0, m_value);
-    INVARIANT(result_size <= estimated_size); // TODO, ideally, those should be equal.
-
-    return result;
+    mpz_export(out + offset, &result_size, word_order, size, byte_order, 0, m_value);
+    INVARIANT(result_size <= 1);
 }
 
 void BigInt::set_value_as_binary_data(ExportFormat format, const BinaryData& data)
 {
+    // Leading zeroes do not affect value, but may prevent storing it inline.
+    const uint8_t* begin = data.data;
+    const uint8_t* end = data.data + data.len;
+    if (format == EXPORT_BIG_ENDIAN)
+    {
+        while (begin != end && *begin == 0)
+        {
+            ++begin;
+        }
+    }
+    else
+    {
+        while (begin != end && *(end - 1) == 0)
+        {
+            --end;
+        }
+    }
+    const size_t size = end - begin;
+
+    if (size <= sizeof(m_magnitude))
+    {
+        Magnitude magnitude = {0, 0};
+        for (size_t i = 0; i < size; ++i)
+        {
+            const size_t position = (format == EXPORT_BIG_ENDIAN)
+                    ? size - 1 - i : i;
+            magnitude[i / 8] |= static_cast<uint64_t>(begin[position]) << ((i % 8) * 8);
+        }
+
+        mpz_clear(m_value);
+        mpz_init(m_value);
+        set_inline(false, magnitude);
+        return;
+    }
+
     const int word_order = (format == EXPORT_BIG_ENDIAN) ? 1 : -1;
     const int byte_order = word_order;
 
-    mpz_import(m_value, data.len, word_order, 1, byte_order, 0, data.data);
+    mpz_import(m_value, size, word_order, 1, byte_order, 0, begin);
+    m_is_inline = false;
+    normalize();
 }
 
 BigInt& BigInt::operator+=(const BigInt& other)
 {
-    mpz_add(m_value, m_value, other.m_value);
+    if (m_is_inline && other.m_is_inline
+            && add_inline(other.m_is_negative, other.m_magnitude))
+    {
+        return *this;
+    }
+
+    const MpzView other_value(other);
+    promote_to_mpz();
+    mpz_add(m_value, m_value, other_value.get());
+    normalize();
 
     return *this;
 }
 
 BigInt& BigInt::operator-=(const BigInt& other)
 {
-    mpz_sub(m_value, m_value, other.m_value);
+    if (m_is_inline && other.m_is_inline
+            && add_inline(!other.m_is_negative, other.m_magnitude))
+    {
+        return *this;
+    }
+
+    const MpzView other_value(other);
+    promote_to_mpz();
+    mpz_sub(m_value, m_value, other_value.get());
+    normalize();
 
     return *this;
 }
 
 BigInt& BigInt::operator*=(const BigInt& other)
 {
-    mpz_mul(m_value, m_value, other.m_value);
+    if (m_is_inline && other.m_is_inline && multiply_inline(other))
+    {
+        return *this;
+    }
+
+    const MpzView other_value(other);
+    promote_to_mpz();
+    mpz_mul(m_value, m_value, other_value.get());
+    normalize();
 
     return *this;
 }
 
 BigInt& BigInt::operator/=(const BigInt& other)
 {
-    if (other == 0)
+    if (other.is_zero())
     {
         THROW_EXCEPTION2(ERROR_BIG_INT_ZERO_DIVISION, "Division by zero.");
     }
 
-    mpz_tdiv_q(m_value, m_value, other.m_value);
+    if (m_is_inline && other.m_is_inline
+            && m_magnitude[1] == 0 && other.m_magnitude[1] == 0)
+    {
+        // Truncating division, just like mpz_tdiv_q().
+        const Magnitude result = {m_magnitude[0] / other.m_magnitude[0], 0};
+        set_inline(m_is_negative != other.m_is_negative, result);
+        return *this;
+    }
+
+    const MpzView other_value(other);
+    promote_to_mpz();
+    mpz_tdiv_q(m_value, m_value, other_value.get());
+    normalize();
 
     return *this;
 }
@@ -261,7 +868,9 @@ BigInt& BigInt::operator/=(const BigInt& other)
 BigInt& BigInt::operator+=(const double& value)
 {
     validate_for_math(value);
+    promote_to_mpz();
     mpz_set_d(m_value, mpz_get_d(m_value) + value);
+    normalize();
 
     return *this;
 }
@@ -269,7 +878,9 @@ BigInt& BigInt::operator+=(const double& value)
 BigInt& BigInt::operator-=(const double& value)
 {
     validate_for_math(value);
+    promote_to_mpz();
     mpz_set_d(m_value, mpz_get_d(m_value) - value);
+    normalize();
 
     return *this;
 }
@@ -277,7 +888,9 @@ BigInt& BigInt::operator-=(const double& value)
 BigInt& BigInt::operator*=(const double& value)
 {
     validate_for_math(value);
+    promote_to_mpz();
     mpz_set_d(m_value, mpz_get_d(m_value) * value);
+    normalize();
 
     return *this;
 }
@@ -290,7 +903,9 @@ BigInt& BigInt::operator/=(const double& value)
                 "Division by zero.");
     }
 
+    promote_to_mpz();
     mpz_set_d(m_value, mpz_get_d(m_value) / value);
+    normalize();
 
     return *this;
 }
@@ -298,14 +913,33 @@ BigInt& BigInt::operator/=(const double& value)
 BigInt BigInt::operator-() const
 {
     BigInt tmp(*this);
-    mpz_mul_si(tmp.m_value, tmp.m_value, -1);
+    if (tmp.m_is_inline)
+    {
+        tmp.set_inline(!tmp.m_is_negative, tmp.m_magnitude);
+    }
+    else
+    {
+        mpz_neg(tmp.m_value, tmp.m_value);
+    }
 
     return tmp;
 }
 
 int BigInt::compare(const BigInt& other) const
 {
-    return mpz_cmp(m_value, other.m_value);
+    if (m_is_inline && other.m_is_inline)
+    {
+        if (m_is_negative != other.m_is_negative)
+        {
+            return m_is_negative ? -1 : 1;
+        }
+        const int result = compare_magnitudes(m_magnitude, other.m_magnitude);
+        return m_is_negative ? -result : result;
+    }
+
+    const MpzView value(*this);
+    const MpzView other_value(other);
+    return mpz_cmp(value.get(), other_value.get());
 }
 
 int BigInt::compare(const int64_t& other) const
@@ -325,12 +959,13 @@ int BigInt::compare(const int64_t& other) const
 
 int BigInt::compare(const double& other) const
 {
-    return mpz_cmp_d(m_value, other);
+    const MpzView value(*this);
+    return mpz_cmp_d(value.get(), other);
 }
 
 bool BigInt::operator==(const BigInt& other) const
 {
-    return mpz_cmp(m_value, other.m_value) == 0;
+    return compare(other) == 0;
 }
 
 bool BigInt::operator!=(const BigInt& other) const
@@ -340,22 +975,22 @@ bool BigInt::operator!=(const BigInt& other) const
 
 bool BigInt::operator<(const BigInt& other) const
 {
-    return mpz_cmp(m_value, other.m_value) < 0;
+    return compare(other) < 0;
 }
 
 bool BigInt::operator>(const BigInt& other) const
 {
-    return mpz_cmp(m_value, other.m_value) > 0;
+    return compare(other) > 0;
 }
 
 bool BigInt::operator<=(const BigInt& other) const
 {
-    return mpz_cmp(m_value, other.m_value) <= 0;
+    return compare(other) <= 0;
 }
 
 bool BigInt::operator>=(const BigInt& other) const
 {
-    return mpz_cmp(m_value, other.m_value) >= 0;
+    return compare(other) >= 0;
 }
 
 const void* BigInt::get_object_magic()
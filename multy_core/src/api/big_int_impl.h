@@ -28,6 +28,10 @@
  * Division is explicitly not supported to simplify implementation.
  *
  * Supports full set of comparision operators.
+ *
+ * Values that fit into 128 bits (sign and magnitude) are stored inline and
+ * most of the math on those is done without heap allocations,
+ * larger values are transparently moved to mpz_t.
  */
 struct MULTY_CORE_API BigInt : public ::multy_core::internal::ObjectBase<BigInt>
 {
@@ -51,10 +55,25 @@ struct MULTY_CORE_API BigInt : public ::multy_core::internal::ObjectBase<BigInt>
 
     ~BigInt();
 
+    // Size of the buffer enough for any value up to 256 bits with sign and null-terminator.
+    static const size_t UINT256_STRING_BUFFER_SIZE = 80;
+
     void set_value(const char* value);
 
+    // Sets value from hex digits (without "0x" prefix), treated as unsigned.
+    void set_value_as_hex(const char* value, size_t size);
+
     std::string get_value() const;
 
+    /** Writes decimal representation of the value with null-terminator.
+     *
+     * @param buffer - output buffer, UINT256_STRING_BUFFER_SIZE is enough
+     *      for values up to 256 bits.
+     * @param buffer_size - size of the buffer, throws if it is not enough.
+     * @return length of the string, without null-terminator.
+     */
+    size_t get_value(char* buffer, size_t buffer_size) const;
+
     // Returns value as int64_t, throws exception if value is too big.
     int64_t get_value_as_int64() const;
 
@@ -71,6 +90,9 @@ struct MULTY_CORE_API BigInt : public ::multy_core::internal::ObjectBase<BigInt>
     typedef multy_core::internal::BinaryDataPtr BinaryDataPtr;
     enum ExportFormat {EXPORT_BIG_ENDIAN, EXPORT_LITTLE_ENDIAN};
     BinaryDataPtr export_as_binary_data(ExportFormat format) const;
+    // Writes magnitude to output padded with zeroes up to output->len,
+    // throws if it doesn't fit.
+    void export_as_binary_data(ExportFormat format, BinaryData* output) const;
     void set_value_as_binary_data(ExportFormat format, const BinaryData& data);
 
     BigInt& operator+=(const BigInt& other);
@@ -130,6 +152,29 @@ struct MULTY_CORE_API BigInt : public ::multy_core::internal::ObjectBase<BigInt>
     static const void* get_object_magic();
 
 private:
+    class MpzView;
+
+    enum { INLINE_LIMBS_COUNT = 2 };
+    typedef uint64_t InlineMagnitude[INLINE_LIMBS_COUNT];
+
+    void set_inline(bool is_negative, const InlineMagnitude& magnitude);
+    // Sets value from limbs, least significant first, stores inline if possible.
+    void set_limbs(bool is_negative, const uint64_t* limbs, size_t limbs_count);
+    // Moves inline value to m_value.
+    void promote_to_mpz();
+    // Moves value back inline if it fits there, freeing m_value.
+    void normalize();
+    bool is_zero() const;
+
+    // Inline math, returns false if result doesn't fit, leaving value intact.
+    bool add_inline(bool other_is_negative, const InlineMagnitude& other);
+    bool multiply_inline(const BigInt& other);
+
+    bool m_is_inline;
+    bool m_is_negative;
+    // Magnitude of the inline value, least significant limb first.
+    InlineMagnitude m_magnitude;
+    // Always initialized, but holds allocated value only if !m_is_inline.
     mpz_t m_value;
 };
 
@@ -6,6 +6,7 @@
 
 #include "multy_core/json_api.h"
 
+#include "multy_core/src/account_cache.h"
 #include "multy_core/src/api/json_api_impl.h"
 #include "multy_core/src/utility.h"
 
@@ -27,3 +28,57 @@ Error* make_transaction_from_json(const char* json_string, const char** out_tran
     return nullptr;
 }
 
+Error* make_transactions_from_json(const char* json_string,
+        size_t threads_count,
+        const char** out_transactions_json)
+{
+    ARG_CHECK(json_string != nullptr);
+    ARG_CHECK(out_transactions_json != nullptr);
+
+    try
+    {
+        *out_transactions_json = multy_core::internal::copy_string(
+                multy_core::internal::make_transactions_from_json(
+                        json_string, threads_count));
+    }
+    CATCH_EXCEPTION_RETURN_ERROR(ERROR_SCOPE_JSON_API_TRANSACTION);
+
+    OUT_CHECK(out_transactions_json);
+
+    return nullptr;
+}
+
+Error* json_api_set_account_cache_capacity(size_t capacity)
+{
+    try
+    {
+        multy_core::internal::get_json_api_account_cache().set_capacity(capacity);
+    }
+    CATCH_EXCEPTION_RETURN_ERROR(ERROR_SCOPE_JSON_API_TRANSACTION);
+
+    return nullptr;
+}
+
+Error* json_api_get_account_cache_size(size_t* out_size)
+{
+    ARG_CHECK(out_size != nullptr);
+
+    try
+    {
+        *out_size = multy_core::internal::get_json_api_account_cache().get_size();
+    }
+    CATCH_EXCEPTION_RETURN_ERROR(ERROR_SCOPE_JSON_API_TRANSACTION);
+
+    return nullptr;
+}
+
+Error* json_api_purge_account_cache()
+{
+    try
+    {
+        multy_core::internal::get_json_api_account_cache().purge();
+    }
+    CATCH_EXCEPTION_RETURN_ERROR(ERROR_SCOPE_JSON_API_TRANSACTION);
+
+    return nullptr;
+}
@@ -13,72 +13,50 @@
 #include "multy_core/src/api/transaction_impl.h"
 #include "multy_core/src/api/transaction_builder_impl.h"
 
+#include "multy_core/src/account_cache.h"
 #include "multy_core/src/codec.h"
 #include "multy_core/src/exception.h"
 #include "multy_core/src/exception_stream.h"
 #include "multy_core/src/json_helpers.h"
+#include "multy_core/src/json_stream.h"
 #include "multy_core/src/utility.h"
+#include "multy_core/src/u_ptr.h"
+#include "multy_core/src/worker_pool.h"
 
 #include <json/json.h>
 #include <string.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 namespace
 {
 using namespace multy_core::internal;
 
-void from_json(const Json::Value& value, const BlockchainType&, int32_t* int_value)
-{
-    INVARIANT(int_value != nullptr);
-
-    *int_value = value.asInt();
-}
-
-void from_json(const Json::Value& value, const BlockchainType&, std::string* string_value)
-{
-    INVARIANT(string_value != nullptr);
-
-    *string_value = value.asString();
-}
-
-void from_json(const Json::Value& value, const BlockchainType&, BigInt* big_int_value)
+void big_int_from_string(const char* value, BigInt* big_int_value)
 {
     INVARIANT(big_int_value != nullptr);
 
-    if (value.isInt64())
-    {
-        *big_int_value = BigInt(value.asInt64());
-    }
-    else if (value.isUInt64())
+    if (value && value[0] == '0' && value[1] == 'x')
     {
-        *big_int_value = BigInt(value.asUInt64());
-    }
-    else if (value.type() == Json::stringValue)
-    {
-        const char* v = value.asCString();
-        if (v && v[0] == '0' && v[1] == 'x')
-        {
-            v += 2;
-            const auto binary = decode(v, strlen(v), CODEC_HEX);
-            big_int_value->set_value_as_binary_data(BigInt::EXPORT_BIG_ENDIAN, *binary);
-        }
-        else
-        {
-            big_int_value->set_value(v);
-        }
+        value += 2;
+        big_int_value->set_value_as_hex(value, strlen(value));
     }
     else
     {
-        THROW_EXCEPTION2(ERROR_INVALID_ARGUMENT, "Invalid JSON value type for BigInt value.");
+        big_int_value->set_value(value);
     }
 }
 
-void from_json(const Json::Value& value, const BlockchainType&, BinaryDataPtr* binary_data)
+void binary_data_from_string(const char* encoded, BinaryDataPtr* binary_data)
 {
     INVARIANT(binary_data != nullptr);
 
     const CodecType codec = CODEC_HEX;
-    const char* encoded = value.asCString();
 
     struct
     {
@@ -105,19 +83,69 @@ void from_json(const Json::Value& value, const BlockchainType&, BinaryDataPtr* b
     decode(encoded, *codec_ptr).swap(*binary_data);
 }
 
-void from_json(const Json::Value& value, const BlockchainType& blockchain_type, PrivateKeyPtr* private_key)
+void private_key_from_string(const char* serialized_private_key,
+        const BlockchainType& blockchain_type, PrivateKeyPtr* private_key)
 {
     INVARIANT(private_key != nullptr);
 
-    const char* serialized_private_key = value.asCString();
     const auto account_type = ACCOUNT_TYPE_DEFAULT;
 
     const auto& blockchain_facade = get_blockchain(blockchain_type.blockchain);
-    const auto& account = blockchain_facade.make_account(
-                blockchain_type, account_type, serialized_private_key);
+    const auto& account = get_json_api_account_cache().get_account(
+            blockchain_facade, blockchain_type, account_type, serialized_private_key);
     account->get_private_key().swap(*private_key);
 }
 
+void from_json(const Json::Value& value, const BlockchainType&, int32_t* int_value)
+{
+    INVARIANT(int_value != nullptr);
+
+    *int_value = value.asInt();
+}
+
+void from_json(const Json::Value& value, const BlockchainType&, std::string* string_value)
+{
+    INVARIANT(string_value != nullptr);
+
+    *string_value = value.asString();
+}
+
+void from_json(const Json::Value& value, const BlockchainType&, BigInt* big_int_value)
+{
+    INVARIANT(big_int_value != nullptr);
+
+    if (value.isInt64())
+    {
+        *big_int_value = BigInt(value.asInt64());
+    }
+    else if (value.isUInt64())
+    {
+        *big_int_value = BigInt(value.asUInt64());
+    }
+    else if (value.type() == Json::stringValue)
+    {
+        big_int_from_string(value.asCString(), big_int_value);
+    }
+    else
+    {
+        THROW_EXCEPTION2(ERROR_INVALID_ARGUMENT, "Invalid JSON value type for BigInt value.");
+    }
+}
+
+void from_json(const Json::Value& value, const BlockchainType&, BinaryDataPtr* binary_data)
+{
+    INVARIANT(binary_data != nullptr);
+
+    binary_data_from_string(value.asCString(), binary_data);
+}
+
+void from_json(const Json::Value& value, const BlockchainType& blockchain_type, PrivateKeyPtr* private_key)
+{
+    INVARIANT(private_key != nullptr);
+
+    private_key_from_string(value.asCString(), blockchain_type, private_key);
+}
+
 template <typename T>
 const T& to_binder_argument(const T& argument)
 {
@@ -212,57 +240,71 @@ void set_properties(const Json::Value& values, const BlockchainType& blockchain_
     }
 }
 
-TransactionBuilderPtr make_transaction_builder_from_json(
+TransactionBuilderPtr make_transaction_builder(
         const BlockchainFacadeBase& facade,
         const Account& account,
-        const Json::Value& builder_json)
+        const Json::Value& type_json,
+        const char* action)
 {
-    const auto& type_json = builder_json["type"];
-    const auto& action = builder_json.get("action", std::string());
-    TransactionBuilderPtr builder;
-
     if (type_json.isString())
     {
-         builder = facade.make_transaction_builder_by_name(
+        return facade.make_transaction_builder_by_name(
                 account,
                 type_json.asCString(),
-                action.asCString());
-    }
-    else
-    {
-        builder = facade.make_transaction_builder(
-                account,
-                type_json.asUInt(),
-                action.asCString());
+                action);
     }
 
+    return facade.make_transaction_builder(
+            account,
+            type_json.asUInt(),
+            action);
+}
+
+TransactionBuilderPtr make_transaction_builder_from_json(
+        const BlockchainFacadeBase& facade,
+        const Account& account,
+        const Json::Value& builder_json)
+{
+    const auto& action = builder_json.get("action", std::string());
+    TransactionBuilderPtr builder = make_transaction_builder(
+            facade, account, builder_json["type"], action.asCString());
+
     // stuff builder with properties:
     set_properties(builder_json["payload"], account.get_blockchain_type(), &builder->get_properties());
 
     return builder;
 }
 
-} // namespace
-
-namespace multy_core
-{
-namespace internal
-{
-
-std::string make_transaction_from_json(const std::string& json_string)
+BlockchainType get_blockchain_type(const Json::Value& root)
 {
-    const Json::Value root = parse_json(json_string);
-
-    const auto blockchain_type = BlockchainType
+    return BlockchainType
     {
         from_string<Blockchain>(root["blockchain"].asCString()),
         static_cast<size_t>(root["net_type"].asUInt())
     };
+}
 
+std::string make_serialized_transaction_json(const std::string& serialized)
+{
+    JsonStreamWriter writer;
+    writer.reserve(serialized.size() + 32);
+    writer.begin_object()
+            .key("transaction").begin_object()
+                    .key("serialized").value(serialized)
+            .end_object()
+            .end_object();
+
+    return writer.get_string();
+}
+
+std::string serialize_transaction_from_json(const Json::Value& root)
+{
+    const auto blockchain_type = get_blockchain_type(root);
     const auto& facade = get_blockchain(blockchain_type);
 
     const auto& account_json = root["account"];
-    AccountPtr account = facade.make_account(blockchain_type,
+    const auto account = get_json_api_account_cache().get_account(facade,
+            blockchain_type,
             account_json["type"].asUInt(),
             account_json["private_key"].asCString());
 
@@ -278,7 +320,644 @@ std::string make_transaction_from_json(const std::string& json_string)
         set_properties(tx_json, blockchain_type, &transaction->get_transaction_properties());
     }
 
-    return R"json({"transaction":{"serialized":")json" + facade.encode_serialized_transaction(transaction.get()) + "\"}}";
+    return make_serialized_transaction_json(
+            facade.encode_serialized_transaction(transaction.get()));
+}
+
+/** Reads transaction JSON with JsonStreamReader, binding values directly to
+ * Properties without building a DOM.
+ *
+ * Sections are processed as soon as everything they depend on is known,
+ * otherwise (like "builder" coming before "account") their offset is saved
+ * and they are read once the root object is done.
+ * Handles only the common shape of input: process() returns false on malformed
+ * JSON or unexpected layout, so the caller can fall back to the jsoncpp-based
+ * path, which produces proper diagnostics. Errors of account, builder and
+ * transaction are propagated as is, since the fallback would only repeat them.
+ * Properties are set in the same order as jsoncpp-based path does: fee first,
+ * then sorted by name.
+ */
+class TransactionJsonStreamHandler
+{
+    typedef std::map<std::string, size_t> ValueOffsets;
+
+public:
+    explicit TransactionJsonStreamHandler(const std::string& json_string)
+        : m_json(json_string),
+          m_blockchain_type{BLOCKCHAIN_BITCOIN, 0},
+          m_has_blockchain(false),
+          m_has_net_type(false),
+          m_facade(nullptr),
+          m_account(),
+          m_transaction()
+    {
+    }
+
+    bool process(std::string* result)
+    {
+        INVARIANT(result != nullptr);
+
+        if (!read_root())
+        {
+            return false;
+        }
+        *result = make_serialized_transaction_json(
+                m_facade->encode_serialized_transaction(m_transaction.get()));
+
+        return true;
+    }
+
+private:
+    JsonStreamReader make_reader(size_t offset) const
+    {
+        return JsonStreamReader(m_json.data() + offset, m_json.size() - offset);
+    }
+
+    // Offset in m_json, for readers made by make_reader() too.
+    size_t get_token_offset(const JsonStreamReader& reader) const
+    {
+        return static_cast<size_t>(reader.get_token_data() - m_json.data());
+    }
+
+    bool read_root()
+    {
+        size_t account_offset = std::string::npos;
+        size_t builder_offset = std::string::npos;
+        size_t transaction_offset = std::string::npos;
+
+        JsonStreamReader reader(m_json.data(), m_json.size());
+        if (reader.next() != JsonStreamReader::TOKEN_BEGIN_OBJECT)
+        {
+            return false;
+        }
+
+        std::string key;
+        while (reader.next() == JsonStreamReader::TOKEN_KEY)
+        {
+            key = reader.get_value();
+            const auto token = reader.next();
+            uint64_t net_type = 0;
+
+            if (key == "blockchain")
+            {
+                if (token != JsonStreamReader::TOKEN_STRING)
+                {
+                    return false;
+                }
+                m_blockchain_type.blockchain = from_string<Blockchain>(
+                        reader.get_value().c_str());
+                m_has_blockchain = true;
+            }
+            else if (key == "net_type")
+            {
+                if (!reader.get_uint64(&net_type)
+                        || net_type > std::numeric_limits<Json::UInt>::max())
+                {
+                    return false;
+                }
+                m_blockchain_type.net_type = static_cast<size_t>(net_type);
+                m_has_net_type = true;
+            }
+            else if (key == "account" || key == "builder" || key == "transaction")
+            {
+                if (token != JsonStreamReader::TOKEN_BEGIN_OBJECT)
+                {
+                    return false;
+                }
+
+                if (key == "account" && m_has_blockchain && m_has_net_type)
+                {
+                    if (!read_account(&reader))
+                    {
+                        return false;
+                    }
+                }
+                else if (key == "builder" && m_account)
+                {
+                    if (!read_builder(&reader))
+                    {
+                        return false;
+                    }
+                }
+                else if (key == "transaction" && m_transaction)
+                {
+                    if (!read_transaction(&reader))
+                    {
+                        return false;
+                    }
+                }
+                else
+                {
+                    size_t& offset = key == "account" ? account_offset
+                            : (key == "builder" ? builder_offset : transaction_offset);
+                    offset = get_token_offset(reader);
+                    if (!reader.skip_value())
+                    {
+                        return false;
+                    }
+                }
+            }
+            else if (!reader.skip_value())
+            {
+                return false;
+            }
+        }
+
+        if (reader.get_token() != JsonStreamReader::TOKEN_END_OBJECT
+                || reader.next() != JsonStreamReader::TOKEN_END
+                || !m_has_blockchain || !m_has_net_type)
+        {
+            return false;
+        }
+
+        if (account_offset != std::string::npos)
+        {
+            JsonStreamReader account_reader = make_reader(account_offset);
+            account_reader.next();
+            if (!read_account(&account_reader))
+            {
+                return false;
+            }
+        }
+        if (builder_offset != std::string::npos && m_account)
+        {
+            JsonStreamReader builder_reader = make_reader(builder_offset);
+            builder_reader.next();
+            if (!read_builder(&builder_reader))
+            {
+                return false;
+            }
+        }
+        if (transaction_offset != std::string::npos && m_transaction)
+        {
+            JsonStreamReader transaction_reader = make_reader(transaction_offset);
+            transaction_reader.next();
+            if (!read_transaction(&transaction_reader))
+            {
+                return false;
+            }
+        }
+
+        return static_cast<bool>(m_transaction);
+    }
+
+    bool read_account(JsonStreamReader* reader)
+    {
+        uint64_t account_type = 0;
+        bool has_account_type = false;
+        std::string private_key;
+        bool has_private_key = false;
+
+        while (reader->next() == JsonStreamReader::TOKEN_KEY)
+        {
+            const bool is_type = reader->get_value() == "type";
+            const bool is_private_key = reader->get_value() == "private_key";
+            const auto token = reader->next();
+
+            if (is_type)
+            {
+                if (!reader->get_uint64(&account_type)
+                        || account_type > std::numeric_limits<Json::UInt>::max())
+                {
+                    return false;
+                }
+                has_account_type = true;
+            }
+            else if (is_private_key)
+            {
+                if (token != JsonStreamReader::TOKEN_STRING)
+                {
+                    return false;
+                }
+                private_key = reader->get_value();
+                has_private_key = true;
+            }
+            else if (!reader->skip_value())
+            {
+                return false;
+            }
+        }
+
+        if (reader->get_token() != JsonStreamReader::TOKEN_END_OBJECT
+                || !has_account_type || !has_private_key)
+        {
+            return false;
+        }
+
+        m_facade = &get_blockchain(m_blockchain_type);
+        m_account = get_json_api_account_cache().get_account(*m_facade,
+                m_blockchain_type,
+                static_cast<uint32_t>(account_type),
+                private_key.c_str());
+
+        return true;
+    }
+
+    bool read_builder(JsonStreamReader* reader)
+    {
+        Json::Value type_json;
+        bool has_type = false;
+        std::string action;
+        bool has_action = false;
+        size_t payload_offset = std::string::npos;
+        TransactionBuilderPtr builder;
+
+        while (reader->next() == JsonStreamReader::TOKEN_KEY)
+        {
+            const bool is_type = reader->get_value() == "type";
+            const bool is_action = reader->get_value() == "action";
+            const bool is_payload = reader->get_value() == "payload";
+            const auto token = reader->next();
+            uint64_t type = 0;
+
+            if (is_type)
+            {
+                if (token == JsonStreamReader::TOKEN_STRING)
+                {
+                    type_json = reader->get_value();
+                }
+                else if (reader->get_uint64(&type)
+                        && type <= std::numeric_limits<Json::UInt>::max())
+                {
+                    type_json = static_cast<Json::UInt>(type);
+                }
+                else
+                {
+                    return false;
+                }
+                has_type = true;
+            }
+            else if (is_action)
+            {
+                if (token != JsonStreamReader::TOKEN_STRING)
+                {
+                    return false;
+                }
+                action = reader->get_value();
+                has_action = true;
+            }
+            else if (is_payload)
+            {
+                if (token != JsonStreamReader::TOKEN_BEGIN_OBJECT)
+                {
+                    return false;
+                }
+
+                if (has_type && has_action)
+                {
+                    builder = make_transaction_builder(
+                            *m_facade, *m_account, type_json, action.c_str());
+                    if (!read_properties(reader, &builder->get_properties()))
+                    {
+                        return false;
+                    }
+                }
+                else
+                {
+                    payload_offset = get_token_offset(*reader);
+                    if (!reader->skip_value())
+                    {
+                        return false;
+                    }
+                }
+            }
+            else if (!reader->skip_value())
+            {
+                return false;
+            }
+        }
+
+        if (reader->get_token() != JsonStreamReader::TOKEN_END_OBJECT || !has_type)
+        {
+            return false;
+        }
+
+        if (!builder)
+        {
+            builder = make_transaction_builder(
+                    *m_facade, *m_account, type_json, action.c_str());
+        }
+        if (payload_offset != std::string::npos)
+        {
+            JsonStreamReader payload_reader = make_reader(payload_offset);
+            payload_reader.next();
+            if (!read_properties(&payload_reader, &builder->get_properties()))
+            {
+                return false;
+            }
+        }
+
+        m_transaction = builder->make_transaction();
+
+        return true;
+    }
+
+    bool read_transaction(JsonStreamReader* reader)
+    {
+        ValueOffsets value_offsets;
+        if (!read_value_offsets(reader, &value_offsets))
+        {
+            return false;
+        }
+
+        const auto fee = value_offsets.find("fee");
+        if (fee != value_offsets.end())
+        {
+            JsonStreamReader fee_reader = make_reader(fee->second);
+            if (fee_reader.next() != JsonStreamReader::TOKEN_BEGIN_OBJECT
+                    || !read_properties(&fee_reader, &m_transaction->get_fee()))
+            {
+                return false;
+            }
+            value_offsets.erase(fee);
+        }
+
+        return set_properties(value_offsets,
+                &m_transaction->get_transaction_properties());
+    }
+
+    bool read_properties(JsonStreamReader* reader, Properties* properties)
+    {
+        ValueOffsets value_offsets;
+        return read_value_offsets(reader, &value_offsets)
+                && set_properties(value_offsets, properties);
+    }
+
+    // Maps names of the object members to offsets of their values,
+    // last one wins for duplicate names, just like with jsoncpp.
+    bool read_value_offsets(JsonStreamReader* reader, ValueOffsets* value_offsets)
+    {
+        std::string name;
+        while (reader->next() == JsonStreamReader::TOKEN_KEY)
+        {
+            name = reader->get_value();
+            reader->next();
+            (*value_offsets)[name] = get_token_offset(*reader);
+            if (!reader->skip_value())
+            {
+                return false;
+            }
+        }
+
+        return reader->get_token() == JsonStreamReader::TOKEN_END_OBJECT;
+    }
+
+    bool set_properties(const ValueOffsets& value_offsets, Properties* properties)
+    {
+        for (const auto& value_offset : value_offsets)
+        {
+            JsonStreamReader value_reader = make_reader(value_offset.second);
+            value_reader.next();
+            if (!read_property(value_offset.first, &value_reader, properties))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Reader is expected to be at property value.
+    bool read_property(const std::string& name, JsonStreamReader* reader,
+            Properties* properties)
+    {
+        Properties::Binder& binder = properties->get_property(name);
+        const auto token = reader->get_token();
+        const std::string& value = reader->get_value();
+        int64_t int_value = 0;
+        uint64_t uint_value = 0;
+
+        switch (binder.get_value_type())
+        {
+            case Properties::Binder::VALUE_TYPE_INT32:
+                if (!reader->get_int64(&int_value)
+                        || int_value < std::numeric_limits<int32_t>::min()
+                        || int_value > std::numeric_limits<int32_t>::max())
+                {
+                    return false;
+                }
+                binder.set_value(static_cast<int32_t>(int_value));
+                break;
+            case Properties::Binder::VALUE_TYPE_BIG_INT:
+                if (token == JsonStreamReader::TOKEN_STRING)
+                {
+                    BigInt big_int_value;
+                    big_int_from_string(value.c_str(), &big_int_value);
+                    binder.set_value(big_int_value);
+                }
+                else if (reader->get_int64(&int_value))
+                {
+                    binder.set_value(BigInt(int_value));
+                }
+                else if (reader->get_uint64(&uint_value))
+                {
+                    binder.set_value(BigInt(uint_value));
+                }
+                else
+                {
+                    return false;
+                }
+                break;
+            case Properties::Binder::VALUE_TYPE_STRING:
+                if (token != JsonStreamReader::TOKEN_STRING)
+                {
+                    return false;
+                }
+                binder.set_value(value);
+                break;
+            case Properties::Binder::VALUE_TYPE_BINARY_DATA:
+            {
+                if (token != JsonStreamReader::TOKEN_STRING)
+                {
+                    return false;
+                }
+                BinaryDataPtr binary_data;
+                binary_data_from_string(value.c_str(), &binary_data);
+                binder.set_value(to_binder_argument(binary_data));
+                break;
+            }
+            case Properties::Binder::VALUE_TYPE_PRIVATE_KEY:
+            {
+                if (token != JsonStreamReader::TOKEN_STRING)
+                {
+                    return false;
+                }
+                PrivateKeyPtr private_key;
+                private_key_from_string(value.c_str(), m_blockchain_type, &private_key);
+                binder.set_value(to_binder_argument(private_key));
+                break;
+            }
+            default:
+                return false;
+        }
+
+        return binder.is_set();
+    }
+
+private:
+    const std::string& m_json;
+    BlockchainType m_blockchain_type;
+    bool m_has_blockchain;
+    bool m_has_net_type;
+    const BlockchainFacadeBase* m_facade;
+    AccountCache::AccountSharedPtr m_account;
+    TransactionPtr m_transaction;
+};
+
+struct BatchItem
+{
+    Json::Value request;
+    // Either serialized transaction JSON or error JSON, empty if not processed yet.
+    std::string result;
+};
+
+// To be used inside a catch(...) block.
+void set_error_result(BatchItem* item)
+{
+    ErrorPtr error(exception_to_error(ERROR_SCOPE_JSON_API_TRANSACTION,
+            MULTY_CODE_LOCATION));
+
+    JsonStreamWriter writer;
+    writer.begin_object()
+            .key("error").begin_object()
+                    .key("code").value(static_cast<int64_t>(error->code))
+                    .key("message").value(error->message ? error->message : "")
+            .end_object()
+            .end_object();
+
+    item->result = writer.get_string();
+}
+
+std::vector<BatchItem> split_batch_requests(const std::string& json_string)
+{
+    std::vector<BatchItem> result;
+
+    const char* WHITESPACE = " \t\r\n";
+    const size_t start = json_string.find_first_not_of(WHITESPACE);
+    if (start != std::string::npos && json_string[start] == '[')
+    {
+        const Json::Value root = parse_json(json_string);
+        result.resize(root.size());
+        for (Json::ArrayIndex i = 0; i < root.size(); ++i)
+        {
+            result[i].request = root[i];
+        }
+        return result;
+    }
+
+    // Newline-delimited JSON, one request per line.
+    size_t line_begin = 0;
+    while (line_begin < json_string.size())
+    {
+        size_t line_end = json_string.find('\n', line_begin);
+        if (line_end == std::string::npos)
+        {
+            line_end = json_string.size();
+        }
+        const std::string line = json_string.substr(line_begin, line_end - line_begin);
+        line_begin = line_end + 1;
+
+        if (line.find_first_not_of(WHITESPACE) == std::string::npos)
+        {
+            continue;
+        }
+
+        result.emplace_back();
+        try
+        {
+            result.back().request = parse_json(line);
+        }
+        catch (...)
+        {
+            set_error_result(&result.back());
+        }
+    }
+
+    return result;
+}
+
+} // namespace
+
+namespace multy_core
+{
+namespace internal
+{
+
+AccountCache& get_json_api_account_cache()
+{
+    static AccountCache cache;
+    return cache;
+}
+
+std::string make_transaction_from_json(const std::string& json_string)
+{
+    std::string result;
+    if (TransactionJsonStreamHandler(json_string).process(&result))
+    {
+        return result;
+    }
+
+    return serialize_transaction_from_json(parse_json(json_string));
+}
+
+std::string make_transactions_from_json(const std::string& json_string,
+        size_t threads_count)
+{
+    std::vector<BatchItem> items = split_batch_requests(json_string);
+
+    const auto process_item = [&items](size_t index)
+    {
+        BatchItem& item = items[index];
+        if (!item.result.empty())
+        {
+            return;
+        }
+        try
+        {
+            item.result = serialize_transaction_from_json(item.request);
+        }
+        catch (...)
+        {
+            set_error_result(&item);
+        }
+    };
+
+    if (threads_count == 0)
+    {
+        threads_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads_count = std::min(threads_count, items.size());
+
+    if (threads_count > 1)
+    {
+        // Calling thread also does the work, hence pool has one thread less.
+        WorkerPool pool(threads_count - 1);
+        pool.run_for_each(items.size(), process_item);
+    }
+    else
+    {
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            process_item(i);
+        }
+    }
+
+    size_t result_size = 2;
+    for (const auto& item : items)
+    {
+        result_size += item.result.size() + 1;
+    }
+
+    JsonStreamWriter writer;
+    writer.reserve(result_size);
+    writer.begin_array();
+    for (const auto& item : items)
+    {
+        writer.raw_value(item.result);
+    }
+    writer.end_array();
+
+    return writer.get_string();
 }
 
 } // namespace internal
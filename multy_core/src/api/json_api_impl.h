@@ -19,9 +19,21 @@ namespace multy_core
 {
 namespace internal
 {
+class AccountCache;
+
+/// Cache for accounts made from private keys in requests, disabled by default.
+AccountCache& get_json_api_account_cache();
 
 std::string make_transaction_from_json(const std::string&);
 
+/** Make transactions from JSON array or newline-delimited JSON of requests.
+ *
+ * Requests are processed on threads_count threads (0 - as many as there are cores),
+ * @return JSON array of per-request results or errors, in order of requests.
+ * @exception if input is malformed JSON array.
+ */
+std::string make_transactions_from_json(const std::string&, size_t threads_count);
+
 } // namespace internal
 } // namespace multy_core
 
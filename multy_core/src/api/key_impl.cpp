@@ -83,6 +83,8 @@ namespace internal
 
 ExtendedKeyPtr make_master_key(const BinaryData& seed)
 {
+    init_secp256k1_context();
+
     ExtendedKeyPtr key(new ExtendedKey);
     const int result = bip32_key_from_seed(
             seed.data, seed.len, BIP32_VER_MAIN_PRIVATE, 0, &key->key);
@@ -83,6 +83,70 @@ Error* properties_set_private_key_value(
     return nullptr;
 }
 
+Error* properties_set_values(
+        Properties* properties, const PropertyValue* values, size_t count)
+{
+    ARG_CHECK_OBJECT(properties);
+    ARG_CHECK(values != nullptr || count == 0);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const PropertyValue& property_value = values[i];
+        ARG_CHECK(property_value.name);
+        switch (property_value.type)
+        {
+            case PROPERTY_VALUE_TYPE_INT32:
+                break;
+            case PROPERTY_VALUE_TYPE_STRING:
+                ARG_CHECK(property_value.value.string_value);
+                break;
+            case PROPERTY_VALUE_TYPE_BIG_INT:
+                ARG_CHECK(property_value.value.big_int_value);
+                break;
+            case PROPERTY_VALUE_TYPE_BINARY_DATA:
+                ARG_CHECK(property_value.value.binary_data_value);
+                break;
+            case PROPERTY_VALUE_TYPE_PRIVATE_KEY:
+                ARG_CHECK(property_value.value.private_key_value);
+                break;
+            default:
+                return MAKE_ERROR(ERROR_API_INVALID_ARGUMENT,
+                        "Unknown property value type.");
+        }
+    }
+
+    try
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const PropertyValue& property_value = values[i];
+            const char* name = property_value.name;
+            switch (property_value.type)
+            {
+                case PROPERTY_VALUE_TYPE_INT32:
+                    properties->set_property_value(name, property_value.value.int32_value);
+                    break;
+                case PROPERTY_VALUE_TYPE_STRING:
+                    properties->set_property_value(name,
+                            std::string(property_value.value.string_value));
+                    break;
+                case PROPERTY_VALUE_TYPE_BIG_INT:
+                    properties->set_property_value(name, *property_value.value.big_int_value);
+                    break;
+                case PROPERTY_VALUE_TYPE_BINARY_DATA:
+                    properties->set_property_value(name, *property_value.value.binary_data_value);
+                    break;
+                case PROPERTY_VALUE_TYPE_PRIVATE_KEY:
+                    properties->set_property_value(name, *property_value.value.private_key_value);
+                    break;
+            }
+        }
+    }
+    CATCH_EXCEPTION_RETURN_ERROR(ERROR_SCOPE_GENERIC);
+
+    return nullptr;
+}
+
 Error* properties_reset_value(Properties* properties, const char* name)
 {
     ARG_CHECK_OBJECT(properties);
@@ -14,7 +14,9 @@
 #include "multy_core/src/exception_stream.h"
 #include "multy_core/src/utility.h"
 
+#include <algorithm>
 #include <exception>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -493,9 +495,9 @@ Properties::Binder::~Binder()
 Properties::Properties(ErrorScope error_scope, const std::string& name)
     : m_error_scope(error_scope),
       m_name(name),
-      m_properties(),
-      m_property_name_by_value(),
-      m_is_dirty(true)
+      m_binders(),
+      m_is_dirty(true),
+      m_generation(0)
 {
 }
 
@@ -508,10 +510,10 @@ void Properties::reset_property(const std::string& name)
 std::vector<const Binder*> Properties::get_all_properties() const
 {
     std::vector<const Binder*> result;
-    result.reserve(m_properties.size());
-    for (const auto& i : m_properties)
+    result.reserve(m_binders.size());
+    for (const auto& entry : m_binders)
     {
-        result.push_back(i.second.get());
+        result.push_back(entry.binder.get());
     }
     return result;
 }
@@ -524,9 +526,9 @@ std::string Properties::get_name() const
 bool Properties::validate(std::vector<std::string>* unset_properties_names) const
 {
     bool all_required_properties_set = true;
-    for (const auto& i : m_properties)
+    for (const auto& entry : m_binders)
     {
-        const Binder& property = *i.second;
+        const Binder& property = *entry.binder;
         if ((property.get_trait() == Property::REQUIRED) && !property.is_set())
         {
             all_required_properties_set = false;
@@ -570,6 +572,12 @@ bool Properties::is_dirty() const
 void Properties::set_dirty() const
 {
     m_is_dirty = true;
+    ++m_generation;
+}
+
+uint64_t Properties::get_generation() const
+{
+    return m_generation;
 }
 
 void Properties::bind_property(
@@ -617,6 +625,51 @@ void Properties::bind_property(
     do_bind_property(name, value, trait, std::move(predicate));
 }
 
+void Properties::bind_property(
+        const std::string& name,
+        int32_t* value,
+        Property::Trait trait,
+        Property::PredicateFunction<int32_t> predicate)
+{
+    do_bind_property(name, value, trait, predicate);
+}
+
+void Properties::bind_property(
+        const std::string& name,
+        std::string* value,
+        Property::Trait trait,
+        Property::PredicateFunction<std::string> predicate)
+{
+    do_bind_property(name, value, trait, predicate);
+}
+
+void Properties::bind_property(
+        const std::string& name,
+        BigInt* value,
+        Property::Trait trait,
+        Property::PredicateFunction<BigInt> predicate)
+{
+    do_bind_property(name, value, trait, predicate);
+}
+
+void Properties::bind_property(
+        const std::string& name,
+        BinaryDataPtr* value,
+        Property::Trait trait,
+        Property::PredicateFunction<BinaryData> predicate)
+{
+    do_bind_property(name, value, trait, predicate);
+}
+
+void Properties::bind_property(
+        const std::string& name,
+        PrivateKeyPtr* value,
+        Property::Trait trait,
+        Property::PredicateFunction<PrivateKey> predicate)
+{
+    do_bind_property(name, value, trait, predicate);
+}
+
 void Properties::bind_functional_property(
         const std::string& name,
         void* value,
@@ -696,25 +749,37 @@ void Properties::do_bind_functional_property(
             *this, name, value, std::move(writer), std::move(reader), trait));
 }
 
+Properties::BinderTable::const_iterator Properties::find_by_name(
+        const std::string& name) const
+{
+    const size_t name_hash = std::hash<std::string>()(name);
+    return std::find_if(m_binders.begin(), m_binders.end(),
+            [name_hash, &name](const BinderEntry& entry)
+            {
+                return entry.name_hash == name_hash && entry.name == name;
+            });
+}
+
+Properties::BinderTable::const_iterator Properties::find_by_value(
+        const void* value) const
+{
+    return std::find_if(m_binders.begin(), m_binders.end(),
+            [value](const BinderEntry& entry)
+            {
+                return entry.value == value;
+            });
+}
+
 bool Properties::unbind_property(const std::string& name)
 {
     INVARIANT(!name.empty());
 
-    const auto p = m_properties.find(name);
-    if (p == m_properties.end())
+    const auto p = find_by_name(name);
+    if (p == m_binders.end())
     {
         return false;
     }
-    const auto p2 = m_property_name_by_value.find(p->second->get_value());
-    m_properties.erase(p);
-    if (p2 == m_property_name_by_value.end())
-    {
-        // Internal inconsistncy, incident should be logged.
-    }
-    else
-    {
-        m_property_name_by_value.erase(p2);
-    }
+    m_binders.erase(p);
     return true;
 }
 
@@ -722,22 +787,12 @@ bool Properties::unbind_property_by_value(const void* value)
 {
     INVARIANT(value != nullptr);
 
-    const auto p2 = m_property_name_by_value.find(value);
-    if (p2 == m_property_name_by_value.end())
+    const auto p = find_by_value(value);
+    if (p == m_binders.end())
     {
         return false;
     }
-
-    auto p = m_properties.find(p2->second);
-    m_property_name_by_value.erase(p2);
-    if (p == m_properties.end())
-    {
-        // Internal inconsistncy, incident should be logged.
-    }
-    else
-    {
-        m_properties.erase(p);
-    }
+    m_binders.erase(p);
     return true;
 }
 
@@ -749,12 +804,12 @@ Binder& Properties::get_property(const std::string& name)
 
 const Binder& Properties::get_property(const std::string& name) const
 {
-    auto i = m_properties.find(name);
-    if (i == m_properties.end())
+    const auto p = find_by_name(name);
+    if (p == m_binders.end())
     {
         THROW_PROPERTY_EXCEPTION("Property with name \"" + name + "\" does not exists.");
     }
-    return *i->second;
+    return *p->binder;
 }
 
 Binder& Properties::get_property_by_value(const void* value)
@@ -765,41 +820,49 @@ Binder& Properties::get_property_by_value(const void* value)
 
 const Binder& Properties::get_property_by_value(const void* value) const
 {
-    auto p = m_property_name_by_value.find(value);
-    if (p == m_property_name_by_value.end())
+    const auto p = find_by_value(value);
+    if (p == m_binders.end())
     {
         THROW_PROPERTY_EXCEPTION("Can't find property bound to value.");
     }
 
-    return get_property(p->second);
+    return *p->binder;
 }
 
 // TODO: update function to take BinderPtr as parameter.
 Properties::BinderPtr& Properties::make_property(
         const std::string& name, const void* value)
 {
-    auto p = m_properties.insert(std::make_pair(name, BinderPtr()));
-    if (!p.second)
+    if (find_by_name(name) != m_binders.end())
     {
         THROW_PROPERTY_EXCEPTION("Property with name \"" + name + "\" already exists.");
     }
 
-    auto p2 = m_property_name_by_value.insert(std::make_pair(value, name));
-    if (!p2.second)
+    const auto p = find_by_value(value);
+    if (p != m_binders.end())
     {
-        m_properties.erase(p.first);
         THROW_PROPERTY_EXCEPTION("Value is already bound to property \""
-                + p2.first->second + "\".");
+                + p->name + "\".");
     }
-    return p.first->second;
+
+    // Keeping table sorted by name, just like it was a std::map.
+    const auto position = std::lower_bound(m_binders.begin(), m_binders.end(), name,
+            [](const BinderEntry& entry, const std::string& name)
+            {
+                return entry.name < name;
+            });
+    const auto entry = m_binders.insert(position, BinderEntry{
+            std::hash<std::string>()(name), name, value, BinderPtr()});
+
+    return entry->binder;
 }
 
 bool Properties::is_set(const void* value) const
 {
-    auto p = m_property_name_by_value.find(value);
-    if (p != m_property_name_by_value.end())
+    const auto p = find_by_value(value);
+    if (p != m_binders.end())
     {
-        return get_property(p->second).is_set();
+        return p->binder->is_set();
     }
     return false;
 }
@@ -15,9 +15,9 @@
 
 #include <cstdint>
 #include <functional>
-#include <map>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 struct BigInt;
@@ -73,6 +73,33 @@ public:
     template <typename U>
     using Predicate = std::function<void(typename PredicateArgTraits<U>::ArgumentType const&)>;
 
+    // Plain function predicate, called directly without std::function overhead.
+    template <typename U>
+    using PredicateFunction = void (*)(typename PredicateArgTraits<U>::ArgumentType const&);
+
+    /** Pick the cheapest predicate representation for given callable.
+     *
+     * Functions and non-capturing lambdas are kept as PredicateFunction<U>,
+     * only stateful callables (like capturing lambdas) are wrapped into Predicate<U>.
+     */
+    template <typename U, typename P>
+    static typename std::enable_if<
+            std::is_convertible<P, PredicateFunction<U>>::value,
+            PredicateFunction<U>>::type
+    make_predicate(P predicate)
+    {
+        return predicate;
+    }
+
+    template <typename U, typename P>
+    static typename std::enable_if<
+            !std::is_convertible<P, PredicateFunction<U>>::value,
+            Predicate<U>>::type
+    make_predicate(P predicate)
+    {
+        return Predicate<U>(std::move(predicate));
+    }
+
     bool is_set() const;
     std::string get_name() const;
 
@@ -154,6 +181,8 @@ public:
     typedef std::unique_ptr<Binder> BinderPtr;
     template <typename U>
     using Predicate = Property::Predicate<U>;
+    template <typename U>
+    using PredicateFunction = Property::PredicateFunction<U>;
 
     /** Set specific value to a bound property.
      *
@@ -208,6 +237,13 @@ public:
     /** Explicitly marks this as dirty, not public API.*/
     void set_dirty() const;
 
+    /** Number of times this was marked as dirty.
+     *
+     * Unlike is_dirty(), is not reset by validate(), so it can be used to
+     * detect any change of the properties since some previous moment.
+     */
+    uint64_t get_generation() const;
+
     /** Bind value to named property.
      *
      * Note that value must be alive during Properties lifetime and setting
@@ -259,6 +295,38 @@ public:
             Property::Trait trait = Property::REQUIRED,
             Predicate<PrivateKey> predicate = Predicate<PrivateKey>());
 
+    // Same as above, but predicate is stored and called as plain function.
+
+    void bind_property(
+            const std::string& name,
+            int32_t* value,
+            Property::Trait trait,
+            PredicateFunction<int32_t> predicate);
+
+    void bind_property(
+            const std::string& name,
+            std::string* value,
+            Property::Trait trait,
+            PredicateFunction<std::string> predicate);
+
+    void bind_property(
+            const std::string& name,
+            BigInt* value,
+            Property::Trait trait,
+            PredicateFunction<BigInt> predicate);
+
+    void bind_property(
+            const std::string& name,
+            multy_core::internal::BinaryDataPtr* value,
+            Property::Trait trait,
+            PredicateFunction<BinaryData> predicate);
+
+    void bind_property(
+            const std::string& name,
+            multy_core::internal::PrivateKeyPtr* value,
+            Property::Trait trait,
+            PredicateFunction<PrivateKey> predicate);
+
     // Properties with functions.
     template <typename U>
     using Writer = std::function<void(const U&)>;
@@ -350,12 +418,26 @@ private:
 
     BinderPtr& make_property(const std::string& name, const void* value);
 
+    struct BinderEntry
+    {
+        size_t name_hash;
+        std::string name;
+        const void* value;
+        BinderPtr binder;
+    };
+    typedef std::vector<BinderEntry> BinderTable;
+
+    BinderTable::const_iterator find_by_name(const std::string& name) const;
+    BinderTable::const_iterator find_by_value(const void* value) const;
+
 private:
     const ErrorScope m_error_scope;
     const std::string m_name;
-    std::map<std::string, BinderPtr> m_properties;
-    std::map<const void*, std::string> m_property_name_by_value;
+    // Sorted by name, typically there are just a few binders, so scanning
+    // contiguous precomputed hashes beats any tree or node-based hash map.
+    BinderTable m_binders;
     mutable bool m_is_dirty;
+    mutable uint64_t m_generation;
 };
 
 template <typename T>
@@ -429,23 +511,26 @@ private:
     typedef PropertyTBase<T> Base;
 
 public:
+    template <typename P = Property::PredicateFunction<T>>
     PropertyT(
             Properties& props,
             const std::string& name,
             Property::Trait trait = Property::REQUIRED,
-            Property::Predicate<T> predicate = Property::Predicate<T>())
+            P predicate = P())
         : PropertyT(T(), props, name, trait, std::move(predicate))
     {}
 
+    template <typename P = Property::PredicateFunction<T>>
     PropertyT(
             T initial_value,
             Properties& props,
             const std::string& name,
             Property::Trait trait = Property::REQUIRED,
-            Property::Predicate<T> predicate = Property::Predicate<T>())
+            P predicate = P())
         : Base(std::move(initial_value), props)
     {
-        props.bind_property(name, &(Base::m_value), trait, std::move(predicate));
+        props.bind_property(name, &(Base::m_value), trait,
+                Property::make_predicate<T>(std::move(predicate)));
         // TODO: set value through props.set_value();
     }
 
@@ -11,15 +11,11 @@
 
 #include "multy_core/src/exception.h"
 #include "multy_core/src/exception_stream.h"
+#include "multy_core/src/keccak.h"
 #include "multy_core/src/utility.h"
 
-extern "C" {
-#include "keccak-tiny/keccak-tiny.h"
-} // extern "C"
-
 #include <algorithm>
 #include <iterator>
-#include <unordered_map>
 
 namespace
 {
@@ -32,26 +28,22 @@ static const size_t SHA3_HASH_BYTE_SIZES[] = {
 
 void do_sha3(size_t hash_bit_size, const BinaryData& input, BinaryData* output)
 {
-    static const std::unordered_map<size_t, decltype(&sha3_224)> SHA3_FUNCTIONS =
-    {
-        {224, &sha3_224},
-        {256, &sha3_256},
-        {384, &sha3_384},
-        {512, &sha3_512},
-    };
-
-    const auto sha3_function = SHA3_FUNCTIONS.find(hash_bit_size);
-    if (sha3_function == SHA3_FUNCTIONS.end())
+    if (!contains(SHA3_HASH_BYTE_SIZES, hash_bit_size / 8)
+            || hash_bit_size % 8 != 0)
     {
         THROW_EXCEPTION2(ERROR_INVALID_ARGUMENT,
                 "Unsupported hash size for SHA3.")
                 << " Size:" << hash_bit_size << ".";
     }
+    if (output->len < hash_bit_size / 8)
+    {
+        THROW_EXCEPTION2(ERROR_INVALID_ARGUMENT,
+                "Output BinaryData has not enough space available.")
+                << " Need at least " << hash_bit_size / 8 << " bytes.";
+    }
 
-    THROW_IF_WALLY_ERROR(sha3_function->second(
-                    const_cast<uint8_t*>(output->data), output->len,
-                    input.data, input.len),
-            "Failed to SHA3 input data.");
+    keccak_hash(hash_bit_size, KeccakSponge::SHA3_DELIMITER,
+            input.data, input.len, const_cast<uint8_t*>(output->data));
 }
 
 template <size_t N>
@@ -127,10 +119,8 @@ void keccak_256(const BinaryData& input, BinaryData* output)
     const size_t HASH_SIZES[] = {256 / 8};
     const size_t hash_size = get_biggest_of_supported_sizes(output->len, HASH_SIZES);
 
-    THROW_IF_WALLY_ERROR(
-            ::keccak_256(const_cast<unsigned char*>(output->data), hash_size,
-                    input.data, input.len),
-            "Failed to hash input with keccack_256.");
+    keccak_hash(hash_size * 8, KeccakSponge::KECCAK_DELIMITER,
+            input.data, input.len, const_cast<unsigned char*>(output->data));
 
     output->len = hash_size;
 }
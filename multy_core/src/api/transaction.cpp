@@ -12,6 +12,9 @@
 #include "multy_core/src/blockchain_facade_base.h"
 #include "multy_core/src/utility.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace
 {
 using namespace multy_core::internal;
@@ -65,6 +68,35 @@ Error* transaction_add_source(Transaction* transaction, Properties** source)
     return nullptr;
 }
 
+Error* transaction_add_sources(
+        Transaction* transaction, size_t count, Properties** sources)
+{
+    ARG_CHECK_OBJECT(transaction);
+    ARG_CHECK(sources != nullptr || count == 0);
+
+    // Out entries are filled only on success, so none of them is left
+    // pointing to a source if adding fails midway.
+    std::fill(sources, sources + count, nullptr);
+    try
+    {
+        std::vector<Properties*> new_sources;
+        new_sources.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            new_sources.push_back(&transaction->add_source());
+        }
+        std::copy(new_sources.begin(), new_sources.end(), sources);
+    }
+    CATCH_EXCEPTION_RETURN_ERROR(ERROR_SCOPE_TRANSACTION);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        OUT_CHECK_OBJECT(sources[i]);
+    }
+
+    return nullptr;
+}
+
 Error* transaction_add_destination(
         Transaction* transaction, Properties** destination)
 {
@@ -222,6 +254,41 @@ Error* transaction_serialize(
     return nullptr;
 }
 
+Error* transaction_get_serialized_size(
+        Transaction* transaction,
+        size_t* out_size)
+{
+    ARG_CHECK_OBJECT(transaction);
+    ARG_CHECK(out_size);
+
+    try
+    {
+        *out_size = transaction->get_serialized_size();
+    }
+    CATCH_EXCEPTION_RETURN_ERROR(ERROR_SCOPE_TRANSACTION);
+
+    return nullptr;
+}
+
+Error* transaction_serialize_into(
+        Transaction* transaction,
+        unsigned char* buffer,
+        size_t capacity,
+        size_t* out_written)
+{
+    ARG_CHECK_OBJECT(transaction);
+    ARG_CHECK(buffer);
+    ARG_CHECK(out_written);
+
+    try
+    {
+        *out_written = transaction->serialize_into(buffer, capacity);
+    }
+    CATCH_EXCEPTION_RETURN_ERROR(ERROR_SCOPE_TRANSACTION);
+
+    return nullptr;
+}
+
 Error* transaction_serialize_encoded(
         Transaction* transaction,
         const char** out_serialized_transaction)
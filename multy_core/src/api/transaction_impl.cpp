@@ -6,8 +6,11 @@
 
 #include "multy_core/src/api/transaction_impl.h"
 
+#include "multy_core/binary_data.h"
 #include "multy_core/src/exception.h"
+#include "multy_core/src/exception_stream.h"
 
+#include <algorithm>
 #include <string>
 
 Transaction::Transaction()
@@ -18,6 +21,36 @@ Transaction::~Transaction()
 {
 }
 
+size_t Transaction::get_serialized_size()
+{
+    return serialize()->len;
+}
+
+size_t Transaction::serialize_into(uint8_t* buffer, size_t capacity)
+{
+    return copy_serialized(*serialize(), buffer, capacity);
+}
+
+size_t Transaction::copy_serialized(const BinaryData& serialized,
+        uint8_t* buffer, size_t capacity)
+{
+    check_buffer_capacity(serialized.len, capacity);
+    std::copy(serialized.data, serialized.data + serialized.len, buffer);
+
+    return serialized.len;
+}
+
+void Transaction::check_buffer_capacity(size_t serialized_size, size_t capacity)
+{
+    if (serialized_size > capacity)
+    {
+        THROW_EXCEPTION2(ERROR_TRANSACTION_BUFFER_TOO_SMALL,
+                "Not enough space in buffer to serialize transaction.")
+                << " Required: " << serialized_size << " bytes,"
+                << " capacity: " << capacity << " bytes.";
+    }
+}
+
 std::string  Transaction::encode_serialized()
 {
     THROW_EXCEPTION("Not implemented");
@@ -38,6 +38,22 @@ struct MULTY_CORE_API Transaction : public ::multy_core::internal::ObjectBase<Tr
      */
     virtual BinaryDataPtr serialize() = 0;
 
+    /** Exact size of the serialize() result, in bytes.
+     *
+     * Same as serialize(), may verify/update internal state and throw.
+     * Default implementation serializes transaction.
+     */
+    virtual size_t get_serialized_size();
+
+    /** Serialize transaction to binary form into a caller-provided buffer.
+     *
+     * Same as serialize(), may verify/update internal state and throw.
+     * Default implementation serializes transaction and copies result.
+     * @return number of bytes written.
+     * @exception ERROR_TRANSACTION_BUFFER_TOO_SMALL if capacity is not enough.
+     */
+    virtual size_t serialize_into(uint8_t* buffer, size_t capacity);
+
     virtual std::string encode_serialized();
 
     virtual BigInt get_total_fee() const = 0;
@@ -83,6 +99,21 @@ struct MULTY_CORE_API Transaction : public ::multy_core::internal::ObjectBase<Tr
     virtual void set_message(const BinaryData& value) = 0;
 
     static const void* get_object_magic();
+
+protected:
+    /** Copies already serialized transaction into a caller-provided buffer.
+     *
+     * @return number of bytes written.
+     * @exception ERROR_TRANSACTION_BUFFER_TOO_SMALL if capacity is not enough.
+     */
+    static size_t copy_serialized(const BinaryData& serialized,
+            uint8_t* buffer, size_t capacity);
+
+    /** Checks that transaction of serialized_size bytes fits into a buffer.
+     *
+     * @exception ERROR_TRANSACTION_BUFFER_TOO_SMALL if capacity is not enough.
+     */
+    static void check_buffer_capacity(size_t serialized_size, size_t capacity);
 };
 
 #endif // MULTY_CORE_SRC_API_TRANSACTION_IMPL_H
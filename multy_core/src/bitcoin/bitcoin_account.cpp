@@ -19,9 +19,11 @@
 #include "wally_core.h"
 #include "wally_crypto.h"
 
+#include <algorithm>
 #include <sstream>
 #include <string.h>
 #include <string>
+#include <vector>
 
 namespace
 {
@@ -72,52 +74,120 @@ uint32_t get_chain_index(BlockchainType blockchain_type)
     return blockchain_type.blockchain;
 }
 
-class BitcoinP2PKHAccount : public BitcoinAccount
+std::string make_p2pkh_address(BitcoinNetType net_type, const BinaryData& public_key_hash)
 {
-public:
-    using BitcoinAccount::BitcoinAccount;
-
-    std::string get_address() const override
-    {
-        // P2PKH address generated from public key.
-        // https://en.bitcoin.it/wiki/Technical_background_of_version_1_Bitcoin_addresses
+    // P2PKH address generated from public key.
+    // https://en.bitcoin.it/wiki/Technical_background_of_version_1_Bitcoin_addresses
+
+    unsigned char pub_hash[HASH160_BYTE_LEN + 1] = {'\0'};
+
+    // 1 - Take the corresponding public key generated with it (33 or 65
+    // bytes)
+    // 2 - Perform SHA-256 hashing on the public key
+    // 3 - Perform RIPEMD-160 hashing on the result of SHA-256
+    // Caller has those pre-computed.
+    INVARIANT(public_key_hash.len == HASH160_BYTE_LEN);
+    std::copy(public_key_hash.data, public_key_hash.data + public_key_hash.len,
+            pub_hash + 1);
+
+    // 4 - Add version byte in front of RIPEMD-160 hash
+    //      (0x00 for Main Network)
+    pub_hash[0] = get_address_prefix(net_type, BITCOIN_ADDRESS_P2PKH);
+
+    // 5 - Perform SHA-256 hash on the extended RIPEMD-160 result
+    // 6 - Perform SHA-256 hash on the result of the previous SHA-256 hash
+    // 8 - Add the 4 checksum bytes from stage 7 at the end of extended
+    //      RIPEMD-160 hash from stage 4.
+    // 9 - Convert the result from a byte string into a base58 string
+    //      using Base58Check encoding.
+    CharPtr base58_string_ptr;
+    THROW_IF_WALLY_ERROR(
+            wally_base58_from_bytes(
+                    pub_hash, sizeof(pub_hash), BASE58_FLAG_CHECKSUM,
+                    reset_sp(base58_string_ptr)),
+            "Converting to base58 failed.");
+    std::string result(base58_string_ptr.get());
 
-        unsigned char pub_hash[HASH160_BYTE_LEN + 1] = {'\0'};
+    return result;
+}
 
-        // 1 - Take the corresponding public key generated with it (33 or 65
-        // bytes)
-        PublicKeyPtr public_key(m_private_key->make_public_key());
-        BinaryData key_data = public_key->get_content();
+std::string make_p2sh_p2wpkh_address(BitcoinNetType net_type, const BinaryData& public_key_hash)
+{
+    unsigned char pub_hash[HASH160_BYTE_LEN + 1] = {'\0'};
 
+    // 1 - Take the corresponding public key generated with it (33 or 65
+    // bytes)
+    {
+        unsigned char segwit_script[HASH160_BYTE_LEN + 2] = {'\0'};
         // 2 - Perform SHA-256 hashing on the public key
         // 3 - Perform RIPEMD-160 hashing on the result of SHA-256
-        {
-            // Leave the first byte intact for prefix.
-            auto data = power_slice(as_binary_data(pub_hash), 1, -1);
-            do_hash_inplace<BITCOIN_HASH, 160>(key_data, &data);
-        }
+        // Caller has those pre-computed.
+        INVARIANT(public_key_hash.len == HASH160_BYTE_LEN);
+        // Leave the first two bytes intact for script opcode
+        std::copy(public_key_hash.data, public_key_hash.data + public_key_hash.len,
+                segwit_script + 2);
+        // 4 - Perform make script segWit for lock bitcoins
+        segwit_script[0] = OP_0; // Version byte witness
+        segwit_script[1] = HASH160_LEN; // Witness program is 20 bytes
+
+        // Leave the first byte intact for prefix.
+        BinaryData hash_data = power_slice(as_binary_data(pub_hash), 1, -1);
+        // 5 - Perform SHA-256 hashing on the segWit script
+        // 6 - Perform RIPEMD-160 hashing on the result of SHA-256
+        do_hash_inplace<BITCOIN_HASH, 160>(segwit_script, &hash_data);
+    }
+
+    // 7 - Add version byte in front of RIPEMD-160 hash
+    //      (0x05 for Main Network)
+    pub_hash[0] = get_address_prefix(net_type, BITCOIN_ADDRESS_P2SH);
+
+    // 8 - Perform SHA-256 hash on the extended RIPEMD-160 result
+    // 9 - Perform SHA-256 hash on the result of the previous SHA-256 hash
+    // 10 - Add the 4 checksum bytes from stage 7 at the end of extended
+    //      RIPEMD-160 hash from stage 4.
+    // 11 - Convert the result from a byte string into a base58 string
+    //      using Base58Check encoding.
+    CharPtr base58_string_ptr;
+    THROW_IF_WALLY_ERROR(
+            wally_base58_from_bytes(
+                    pub_hash, sizeof(pub_hash), BASE58_FLAG_CHECKSUM,
+                    reset_sp(base58_string_ptr)),
+            "Converting to base58 failed.");
+    std::string result(base58_string_ptr.get());
+
+    return result;
+}
+
+std::string make_address(
+        BitcoinNetType net_type,
+        BitcoinAccountType account_type,
+        const BinaryData& public_key_hash)
+{
+    if (account_type == BITCOIN_ACCOUNT_P2PKH)
+    {
+        return make_p2pkh_address(net_type, public_key_hash);
+    }
+    if (account_type == BITCOIN_ACCOUNT_SEGWIT)
+    {
+        return make_p2sh_p2wpkh_address(net_type, public_key_hash);
+    }
+
+    THROW_EXCEPTION2(ERROR_INVALID_ARGUMENT, "Unknown BitcoinAccountType.")
+            << " Value: " << account_type << ".";
+
+    return std::string();
+}
+
+class BitcoinP2PKHAccount : public BitcoinAccount
+{
+public:
+    using BitcoinAccount::BitcoinAccount;
 
-        // 4 - Add version byte in front of RIPEMD-160 hash
-        //      (0x00 for Main Network)
-        pub_hash[0] = get_address_prefix(
+    std::string get_address() const override
+    {
+        return make_p2pkh_address(
                 static_cast<BitcoinNetType>(m_blockchain_type.net_type),
-                BITCOIN_ADDRESS_P2PKH);
-
-        // 5 - Perform SHA-256 hash on the extended RIPEMD-160 result
-        // 6 - Perform SHA-256 hash on the result of the previous SHA-256 hash
-        // 8 - Add the 4 checksum bytes from stage 7 at the end of extended
-        //      RIPEMD-160 hash from stage 4.
-        // 9 - Convert the result from a byte string into a base58 string
-        //      using Base58Check encoding.
-        CharPtr base58_string_ptr;
-        THROW_IF_WALLY_ERROR(
-                wally_base58_from_bytes(
-                        pub_hash, sizeof(pub_hash), BASE58_FLAG_CHECKSUM,
-                        reset_sp(base58_string_ptr)),
-                "Converting to base58 failed.");
-        std::string result(base58_string_ptr.get());
-
-        return result;
+                m_private_key->get_public_key_hash());
     }
     BitcoinAccountType get_account_type() const override
     {
@@ -132,52 +202,9 @@ public:
 
     std::string get_address() const override
     {
-        unsigned char pub_hash[HASH160_BYTE_LEN + 1] = {'\0'};
-
-        // 1 - Take the corresponding public key generated with it (33 or 65
-        // bytes)
-        {
-            unsigned char segwit_script[HASH160_BYTE_LEN + 2] = {'\0'};
-            // Leave the first two bytes intact for script opcode
-            BinaryData hash_pub_key = power_slice(as_binary_data(segwit_script), 2, -2);
-
-            PublicKeyPtr public_key(m_private_key->make_public_key());
-            BinaryData key_data = public_key->get_content();
-            // 2 - Perform SHA-256 hashing on the public key
-            // 3 - Perform RIPEMD-160 hashing on the result of SHA-256
-            do_hash_inplace<BITCOIN_HASH, 160>(key_data, &hash_pub_key);
-            // 4 - Perform make script segWit for lock bitcoins
-            segwit_script[0] = OP_0; // Version byte witness
-            segwit_script[1] = HASH160_LEN; // Witness program is 20 bytes
-
-            // Leave the first byte intact for prefix.
-            BinaryData hash_data = power_slice(as_binary_data(pub_hash), 1, -1);
-            // 5 - Perform SHA-256 hashing on the segWit script
-            // 6 - Perform RIPEMD-160 hashing on the result of SHA-256
-            do_hash_inplace<BITCOIN_HASH, 160>(segwit_script, &hash_data);
-        }
-
-        // 7 - Add version byte in front of RIPEMD-160 hash
-        //      (0x05 for Main Network)
-        pub_hash[0] = get_address_prefix(
+        return make_p2sh_p2wpkh_address(
                 static_cast<BitcoinNetType>(m_blockchain_type.net_type),
-                BITCOIN_ADDRESS_P2SH);
-
-        // 8 - Perform SHA-256 hash on the extended RIPEMD-160 result
-        // 9 - Perform SHA-256 hash on the result of the previous SHA-256 hash
-        // 10 - Add the 4 checksum bytes from stage 7 at the end of extended
-        //      RIPEMD-160 hash from stage 4.
-        // 11 - Convert the result from a byte string into a base58 string
-        //      using Base58Check encoding.
-        CharPtr base58_string_ptr;
-        THROW_IF_WALLY_ERROR(
-                wally_base58_from_bytes(
-                        pub_hash, sizeof(pub_hash), BASE58_FLAG_CHECKSUM,
-                        reset_sp(base58_string_ptr)),
-                "Converting to base58 failed.");
-        std::string result(base58_string_ptr.get());
-
-        return result;
+                m_private_key->get_public_key_hash());
     }
     BitcoinAccountType get_account_type() const override
     {
@@ -251,6 +278,41 @@ BitcoinHDAccount::~BitcoinHDAccount()
 {
 }
 
+std::string BitcoinHDAccount::make_address_from_public_key(
+        const BinaryData& public_key) const
+{
+    return make_address(
+            static_cast<BitcoinNetType>(get_blockchain_type().net_type),
+            m_account_type,
+            as_binary_data(do_hash<BITCOIN_HASH, 160>(public_key)));
+}
+
+void BitcoinHDAccount::make_addresses_from_public_keys(
+        const BinaryData& public_keys, std::string* addresses) const
+{
+    INVARIANT(public_keys.len % EC_PUBLIC_KEY_LEN == 0);
+    INVARIANT(addresses != nullptr || public_keys.len == 0);
+
+    const size_t count = public_keys.len / EC_PUBLIC_KEY_LEN;
+    if (count == 0)
+    {
+        return;
+    }
+
+    // Hashing all keys at once is faster than one by one.
+    std::vector<uint8_t> hashes(count * HASH160_BYTE_LEN);
+    BinaryData hashes_data = as_binary_data(hashes);
+    hash_bitcoin_160_batch(public_keys, EC_PUBLIC_KEY_LEN, &hashes_data);
+
+    const BitcoinNetType net_type =
+            static_cast<BitcoinNetType>(get_blockchain_type().net_type);
+    for (size_t i = 0; i < count; ++i)
+    {
+        addresses[i] = make_address(net_type, m_account_type,
+                slice(hashes_data, i * HASH160_BYTE_LEN, HASH160_BYTE_LEN));
+    }
+}
+
 AccountPtr BitcoinHDAccount::make_account(
         const ExtendedKey& parent_key, AddressType type, uint32_t index) const
 {
@@ -0,0 +1,306 @@
+/* Copyright 2018 by Multy.io
+ * Licensed under Multy.io license.
+ *
+ * See LICENSE for details
+ */
+
+#include "multy_core/src/bitcoin/bitcoin_coin_selection.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+namespace
+{
+using namespace multy_core::internal;
+
+// Same limits as in Bitcoin Core wallet, see:
+// https://github.com/bitcoin/bitcoin/blob/master/src/wallet/coinselection.cpp
+const size_t BNB_TOTAL_TRIES = 100000;
+const size_t KNAPSACK_ITERATIONS = 1000;
+// Fixed seed to make knapsack solver results reproducible.
+const uint32_t KNAPSACK_SEED = 0x4d554c54;
+
+struct EffectiveCandidate
+{
+    size_t index;
+    // Amount of candidate minus fee to spend it.
+    int64_t value;
+};
+
+typedef std::vector<EffectiveCandidate> EffectiveCandidates;
+
+std::vector<size_t> to_indices(
+        const EffectiveCandidates& candidates,
+        const std::vector<bool>& selected)
+{
+    std::vector<size_t> result;
+    for (size_t i = 0; i < selected.size(); ++i)
+    {
+        if (selected[i])
+        {
+            result.push_back(candidates[i].index);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+// Depth-first search over inclusion/exclusion branches of candidates sorted
+// by value in descending order, looking for a subset with value in
+// [target, target + cost_of_change] with the smallest excess.
+std::vector<size_t> select_coins_bnb(
+        const EffectiveCandidates& candidates,
+        int64_t target,
+        int64_t cost_of_change)
+{
+    int64_t current_available = 0;
+    for (const auto& c : candidates)
+    {
+        current_available += c.value;
+    }
+    if (current_available < target)
+    {
+        return std::vector<size_t>();
+    }
+
+    int64_t current_value = 0;
+    std::vector<bool> current_selection;
+    current_selection.reserve(candidates.size());
+
+    std::vector<bool> best_selection;
+    int64_t best_waste = std::numeric_limits<int64_t>::max();
+
+    for (size_t tries = 0; tries < BNB_TOTAL_TRIES; ++tries)
+    {
+        bool backtrack = false;
+        if (current_value + current_available < target
+                || current_value > target + cost_of_change)
+        {
+            backtrack = true;
+        }
+        else if (current_value >= target)
+        {
+            const int64_t waste = current_value - target;
+            if (waste <= best_waste)
+            {
+                best_selection = current_selection;
+                best_selection.resize(candidates.size(), false);
+                best_waste = waste;
+                if (best_waste == 0)
+                {
+                    break;
+                }
+            }
+            backtrack = true;
+        }
+
+        if (backtrack)
+        {
+            // Walk back to the last included candidate and exclude it.
+            while (!current_selection.empty() && !current_selection.back())
+            {
+                current_selection.pop_back();
+                current_available += candidates[current_selection.size()].value;
+            }
+            if (current_selection.empty())
+            {
+                break;
+            }
+            current_selection.back() = false;
+            current_value -= candidates[current_selection.size() - 1].value;
+        }
+        else
+        {
+            const size_t i = current_selection.size();
+            current_available -= candidates[i].value;
+
+            // Including a candidate of same value as just excluded one
+            // gives a branch that was already explored.
+            if (i > 0 && !current_selection.back()
+                    && candidates[i].value == candidates[i - 1].value)
+            {
+                current_selection.push_back(false);
+            }
+            else
+            {
+                current_selection.push_back(true);
+                current_value += candidates[i].value;
+            }
+        }
+    }
+
+    if (best_selection.empty())
+    {
+        return std::vector<size_t>();
+    }
+    return to_indices(candidates, best_selection);
+}
+
+// Stochastic approximation of the subset with smallest value not less than
+// target, candidates are expected to be sorted by value in descending order.
+void approximate_best_subset(
+        const EffectiveCandidates& candidates,
+        int64_t total_lower,
+        int64_t target,
+        std::mt19937* random,
+        std::vector<bool>* best_selection,
+        int64_t* best_value)
+{
+    best_selection->assign(candidates.size(), true);
+    *best_value = total_lower;
+
+    std::vector<bool> included;
+    for (size_t rep = 0; rep < KNAPSACK_ITERATIONS && *best_value != target; ++rep)
+    {
+        included.assign(candidates.size(), false);
+        int64_t total = 0;
+        bool reached_target = false;
+        for (int pass = 0; pass < 2 && !reached_target; ++pass)
+        {
+            for (size_t i = 0; i < candidates.size(); ++i)
+            {
+                // First pass picks candidates randomly, second pass
+                // includes all not yet included ones.
+                if (pass == 0 ? ((*random)() & 1) != 0 : !included[i])
+                {
+                    total += candidates[i].value;
+                    included[i] = true;
+                    if (total >= target)
+                    {
+                        reached_target = true;
+                        if (total < *best_value)
+                        {
+                            *best_value = total;
+                            *best_selection = included;
+                        }
+                        total -= candidates[i].value;
+                        included[i] = false;
+                    }
+                }
+            }
+        }
+    }
+}
+
+std::vector<size_t> select_coins_knapsack(
+        EffectiveCandidates candidates,
+        int64_t target,
+        int64_t target_with_change)
+{
+    std::sort(candidates.begin(), candidates.end(),
+            [](const EffectiveCandidate& left, const EffectiveCandidate& right)
+            {
+                return left.value > right.value
+                        || (left.value == right.value && left.index < right.index);
+            });
+
+    const EffectiveCandidate* lowest_larger = nullptr;
+    EffectiveCandidates lower;
+    int64_t total_lower = 0;
+    for (const auto& c : candidates)
+    {
+        if (c.value == target)
+        {
+            return std::vector<size_t>(1, c.index);
+        }
+        else if (c.value < target_with_change)
+        {
+            lower.push_back(c);
+            total_lower += c.value;
+        }
+        else if (!lowest_larger || c.value < lowest_larger->value)
+        {
+            lowest_larger = &c;
+        }
+    }
+
+    if (total_lower == target)
+    {
+        return to_indices(lower, std::vector<bool>(lower.size(), true));
+    }
+
+    if (total_lower < target)
+    {
+        if (!lowest_larger)
+        {
+            return std::vector<size_t>();
+        }
+        return std::vector<size_t>(1, lowest_larger->index);
+    }
+
+    std::mt19937 random(KNAPSACK_SEED);
+    std::vector<bool> best_selection;
+    int64_t best_value = 0;
+    approximate_best_subset(lower, total_lower, target, &random,
+            &best_selection, &best_value);
+    if (best_value != target && total_lower >= target_with_change)
+    {
+        approximate_best_subset(lower, total_lower, target_with_change, &random,
+                &best_selection, &best_value);
+    }
+
+    if (lowest_larger
+            && ((best_value != target && best_value < target_with_change)
+                    || lowest_larger->value <= best_value))
+    {
+        return std::vector<size_t>(1, lowest_larger->index);
+    }
+
+    return to_indices(lower, best_selection);
+}
+
+} // namespace
+
+namespace multy_core
+{
+namespace internal
+{
+
+std::vector<size_t> select_coins(
+        const std::vector<CoinSelectionCandidate>& candidates,
+        const CoinSelectionParams& params)
+{
+    const int64_t fee_per_byte = static_cast<int64_t>(params.amount_per_byte);
+
+    EffectiveCandidates effective_candidates;
+    effective_candidates.reserve(candidates.size());
+    for (size_t i = 0; i < candidates.size(); ++i)
+    {
+        const int64_t value = static_cast<int64_t>(candidates[i].amount)
+                - fee_per_byte * static_cast<int64_t>(candidates[i].input_size);
+        // Skipping candidates that cost more to spend than they are worth.
+        if (value > 0)
+        {
+            effective_candidates.push_back(EffectiveCandidate{i, value});
+        }
+    }
+    std::stable_sort(effective_candidates.begin(), effective_candidates.end(),
+            [](const EffectiveCandidate& left, const EffectiveCandidate& right)
+            {
+                return left.value > right.value;
+            });
+
+    const int64_t target = static_cast<int64_t>(params.target)
+            + fee_per_byte * static_cast<int64_t>(params.base_size);
+
+    // Any excess below cost_of_change would not make it to the change output
+    // and is added to the fee.
+    int64_t cost_of_change = static_cast<int64_t>(params.min_change);
+    if (params.change_output_size != 0)
+    {
+        cost_of_change += fee_per_byte * static_cast<int64_t>(params.change_output_size);
+    }
+
+    std::vector<size_t> result = select_coins_bnb(
+            effective_candidates, target, cost_of_change);
+    if (result.empty())
+    {
+        result = select_coins_knapsack(
+                std::move(effective_candidates), target, target + cost_of_change);
+    }
+    return result;
+}
+
+} // namespace internal
+} // namespace multy_core
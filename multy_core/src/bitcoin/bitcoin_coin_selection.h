@@ -0,0 +1,59 @@
+/* Copyright 2018 by Multy.io
+ * Licensed under Multy.io license.
+ *
+ * See LICENSE for details
+ */
+
+#ifndef MULTY_CORE_BITCOIN_COIN_SELECTION_H
+#define MULTY_CORE_BITCOIN_COIN_SELECTION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace multy_core
+{
+namespace internal
+{
+
+struct CoinSelectionCandidate
+{
+    uint64_t amount;
+    // Size of serialized input spending this candidate, in bytes.
+    uint64_t input_size;
+};
+
+struct CoinSelectionParams
+{
+    // Total amount of all non-change outputs.
+    uint64_t target;
+    uint64_t amount_per_byte;
+    // Size of serialized transaction with no inputs and no change output.
+    uint64_t base_size;
+    // Size of serialized change output, 0 if there is no change destination.
+    uint64_t change_output_size;
+    // Change outputs smaller than that are not created.
+    uint64_t min_change;
+};
+
+/** Selects subset of candidates that covers target and fee.
+ *
+ * First tries branch-and-bound search for a subset that needs no change
+ * output, minimizing waste (amount that goes to the fee above required).
+ * If there is no such subset, falls back to the knapsack solver that
+ * looks for a subset that leaves a change output of at least min_change.
+ * Result is deterministic for the same input.
+ *
+ * @param candidates - UTXOs to choose from.
+ * @param params - target and size/fee model.
+ * @return indices of selected candidates in ascending order, empty if
+ *      candidates do not have enough funds.
+ */
+std::vector<size_t> select_coins(
+        const std::vector<CoinSelectionCandidate>& candidates,
+        const CoinSelectionParams& params);
+
+} // namespace internal
+} // namespace multy_core
+
+#endif // MULTY_CORE_BITCOIN_COIN_SELECTION_H
@@ -34,6 +34,25 @@ uint8_t get_private_key_prefix(BitcoinNetType net_type)
     return PRIVATE_KEY_EXPORT_PREFIXES[net_type];
 }
 
+BitcoinPublicKey::KeyData make_public_key_data(
+        const BitcoinPrivateKey::KeyData& private_key_data,
+        PublicKeyFormat public_key_format)
+{
+    ec_validate_private_key(as_binary_data(private_key_data));
+
+    const size_t public_key_size =
+            (public_key_format == EC_PUBLIC_KEY_COMPRESSED)
+                    ? EC_PUBLIC_KEY_LEN : EC_PUBLIC_KEY_UNCOMPRESSED_LEN;
+    BitcoinPublicKey::KeyData key_data(public_key_size, 0);
+    BinaryData public_key_data = as_binary_data(key_data);
+
+    ec_private_to_public_key(as_binary_data(private_key_data),
+            public_key_format,
+            &public_key_data);
+
+    return key_data;
+}
+
 } // namespace
 
 namespace multy_core
@@ -77,10 +96,11 @@ BitcoinPrivateKey::BitcoinPrivateKey(KeyData data,
         PublicKeyFormat public_key_format)
     : m_data(std::move(data)),
       m_net_type(net_type),
-      m_public_key_format(public_key_format)
+      m_public_key_format(public_key_format),
 //      m_account_type(account_type)
+      m_public_key_data(make_public_key_data(m_data, m_public_key_format)),
+      m_public_key_hash(do_hash<BITCOIN_HASH, 160>(m_public_key_data))
 {
-    ec_validate_private_key(as_binary_data(m_data));
 }
 
 BitcoinPrivateKey::BitcoinPrivateKey(const BinaryData& data,
@@ -89,14 +109,17 @@ BitcoinPrivateKey::BitcoinPrivateKey(const BinaryData& data,
         PublicKeyFormat public_key_format)
     : m_data(data.data, data.data + data.len),
       m_net_type(net_type),
-      m_public_key_format(public_key_format)
+      m_public_key_format(public_key_format),
 //      m_account_type(account_type)
+      m_public_key_data(make_public_key_data(m_data, m_public_key_format)),
+      m_public_key_hash(do_hash<BITCOIN_HASH, 160>(m_public_key_data))
 {
-    ec_validate_private_key(as_binary_data(m_data));
 }
 
 BitcoinPrivateKey::~BitcoinPrivateKey()
-{}
+{
+    wally_bzero(m_data.data(), m_data.size());
+}
 
 std::string BitcoinPrivateKey::to_string() const
 {
@@ -121,17 +144,7 @@ std::string BitcoinPrivateKey::to_string() const
 
 PublicKeyPtr BitcoinPrivateKey::make_public_key() const
 {
-    const size_t public_key_size =
-            (m_public_key_format == EC_PUBLIC_KEY_COMPRESSED)
-                    ? EC_PUBLIC_KEY_LEN : EC_PUBLIC_KEY_UNCOMPRESSED_LEN;
-    BitcoinPublicKey::KeyData key_data(public_key_size, 0);
-    BinaryData public_key_data = as_binary_data(key_data);
-
-    ec_private_to_public_key(as_binary_data(m_data),
-            m_public_key_format,
-            &public_key_data);
-
-    return PublicKeyPtr(new BitcoinPublicKey(key_data));
+    return PublicKeyPtr(new BitcoinPublicKey(m_public_key_data));
 }
 
 PrivateKeyPtr BitcoinPrivateKey::clone() const
@@ -142,15 +155,21 @@ PrivateKeyPtr BitcoinPrivateKey::clone() const
 BinaryDataPtr BitcoinPrivateKey::sign(const BinaryData& data) const
 {
     auto data_hash = do_hash<SHA2_DOUBLE, 256>(data);
+    BinaryDataPtr result = sign_hash(as_binary_data(data_hash));
+    wally_bzero(data_hash.data(), data_hash.size());
 
+    return result;
+}
+
+BinaryDataPtr BitcoinPrivateKey::sign_hash(const BinaryData& data_hash) const
+{
     std::array<uint8_t, EC_SIGNATURE_LEN> signature;
     THROW_IF_WALLY_ERROR(
             wally_ec_sig_from_bytes(
                     m_data.data(), m_data.size(),
-                    data_hash.data(), data_hash.size(),
+                    data_hash.data, data_hash.len,
                     EC_FLAG_ECDSA, signature.data(), signature.size()),
             "Failed to sign binary data with private key.");
-    wally_bzero(data_hash.data(), data_hash.size());
 
     std::array<uint8_t, EC_SIGNATURE_DER_MAX_LEN> der_signature;
     size_t written;
@@ -169,6 +188,11 @@ BitcoinNetType BitcoinPrivateKey::get_net_type() const
     return m_net_type;
 }
 
+const BinaryData BitcoinPrivateKey::get_public_key_hash() const
+{
+    return as_binary_data(m_public_key_hash);
+}
+
 BitcoinPrivateKeyPtr make_bitcoin_private_key_from_wif(
         const char* wif_string,
         BitcoinAccountType account_type)
@@ -222,5 +246,18 @@ BitcoinPrivateKeyPtr make_bitcoin_private_key_from_wif(
             (use_compressed_public_key ? EC_PUBLIC_KEY_COMPRESSED : EC_PUBLIC_KEY_UNCOMPRESSED)));
 }
 
+const BitcoinPrivateKey& as_bitcoin_private_key(const PrivateKey& private_key)
+{
+    const BitcoinPrivateKey* bitcoin_private_key
+            = dynamic_cast<const BitcoinPrivateKey*>(&private_key);
+    if (!bitcoin_private_key)
+    {
+        THROW_EXCEPTION2(ERROR_INVALID_ARGUMENT,
+                "Bitcoin transaction source requires Bitcoin private key.");
+    }
+
+    return *bitcoin_private_key;
+}
+
 } // namespace internal
 } // namespace multy_core
@@ -14,6 +14,7 @@
 
 struct BinaryData;
 
+#include <array>
 #include <vector>
 #include <cstdint>
 #include <string>
@@ -62,20 +63,34 @@ struct BitcoinPrivateKey : public PrivateKey
     PublicKeyPtr make_public_key() const override;
     PrivateKeyPtr clone() const override;
     BinaryDataPtr sign(const BinaryData& data) const override;
+    // Same as sign(), but with SHA256d hash of the data already computed.
+    BinaryDataPtr sign_hash(const BinaryData& data_hash) const;
 
     BitcoinNetType get_net_type() const;
+    // HASH160 (RIPEMD160(SHA256())) of the public key.
+    const BinaryData get_public_key_hash() const;
 
 private:
+    typedef std::array<uint8_t, 160/8> PublicKeyHash;
+
     // TODO: use a shared_pointer to KeyData here to keep a single copy of
     // the private key data in memory.
-    const KeyData m_data;    // private key data with no prefix
+    KeyData m_data;    // private key data with no prefix, wiped on destruction
     const BitcoinNetType m_net_type;
     const PublicKeyFormat m_public_key_format;
 //    const BitcoinAccountType m_account_type;
+
+    // Deriving public key is an EC multiplication, so it is done only once,
+    // private key data never changes after construction.
+    const BitcoinPublicKey::KeyData m_public_key_data;
+    const PublicKeyHash m_public_key_hash;
 };
 
 BitcoinPrivateKeyPtr make_bitcoin_private_key_from_wif(const char* wif_string, BitcoinAccountType account_type);
 
+// Throws ERROR_INVALID_ARGUMENT if private_key is not a Bitcoin one.
+const BitcoinPrivateKey& as_bitcoin_private_key(const PrivateKey& private_key);
+
 } // namespace internal
 } // namespace multy_core
 
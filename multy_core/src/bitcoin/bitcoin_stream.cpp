@@ -8,6 +8,8 @@
 
 #include "multy_core/binary_data.h"
 #include "multy_core/src/error_utility.h"
+#include "multy_core/src/exception.h"
+#include "multy_core/src/exception_stream.h"
 #include "multy_core/src/hash.h"
 #include "multy_core/src/api/big_int_impl.h"
 #include "multy_core/src/api/key_impl.h"
@@ -18,6 +20,7 @@
 
 #include "third-party/portable_endian.h"
 
+#include <algorithm>
 #include <vector>
 #include <string>
 
@@ -48,6 +51,50 @@ BinaryData BitcoinDataStream::get_content() const
     return BinaryData{m_data.data(), m_data.size()};
 }
 
+BitcoinBufferStream::BitcoinBufferStream(uint8_t* buffer, size_t capacity)
+    : m_buffer(buffer),
+      m_capacity(capacity),
+      m_size(0)
+{
+    INVARIANT(m_buffer != nullptr || m_capacity == 0);
+}
+
+BitcoinBufferStream& BitcoinBufferStream::write_data(const uint8_t* data, uint32_t len)
+{
+    INVARIANT(data != nullptr);
+
+    if (len > m_capacity - m_size)
+    {
+        THROW_EXCEPTION2(ERROR_TRANSACTION_BUFFER_TOO_SMALL,
+                "Not enough space in buffer to serialize transaction.")
+                << " Capacity: " << m_capacity << " bytes.";
+    }
+    std::copy(data, data + len, m_buffer + m_size);
+    m_size += len;
+
+    return *this;
+}
+
+size_t BitcoinBufferStream::get_bytes_written() const
+{
+    return m_size;
+}
+
+BitcoinHashStream::BitcoinHashStream(Hasher* hasher)
+    : m_hasher(hasher)
+{
+    INVARIANT(m_hasher != nullptr);
+}
+
+BitcoinHashStream& BitcoinHashStream::write_data(const uint8_t* data, uint32_t len)
+{
+    INVARIANT(data != nullptr);
+
+    m_hasher->update(BinaryData{data, len});
+
+    return *this;
+}
+
 BitcoinStream& BitcoinBytesCountStream::write_data(const uint8_t* /*data*/, uint32_t len)
 {
     bytes_count += len;
@@ -82,6 +129,32 @@ void write_compact_size(uint64_t size, BitcoinStream* stream)
     }
 }
 
+size_t get_compact_size_length(uint64_t size)
+{
+    if (size < 253)
+    {
+        return 1;
+    }
+    else if (size <= std::numeric_limits<uint16_t>::max())
+    {
+        return 1 + sizeof(uint16_t);
+    }
+    else if (size <= std::numeric_limits<uint32_t>::max())
+    {
+        return 1 + sizeof(uint32_t);
+    }
+    return 1 + sizeof(uint64_t);
+}
+
+size_t get_destination_serialized_size(const BitcoinTransactionDestinationBase& destination)
+{
+    INVARIANT(destination.sig_script != nullptr);
+
+    const size_t script_size = destination.sig_script->len;
+    return sizeof(uint64_t) // amount
+            + get_compact_size_length(script_size) + script_size;
+}
+
 template <typename T>
 BitcoinStream& write_as_data(const T& data, BitcoinStream& stream)
 {
@@ -21,6 +21,7 @@ namespace multy_core
 {
 namespace internal
 {
+class Hasher;
 class BitcoinTransactionSourceBase;
 class BitcoinTransactionDestinationBase;
 class BitcoinStream
@@ -41,6 +42,29 @@ private:
     std::vector<uint8_t> m_data;
 };
 
+// Writes to a caller-owned buffer of fixed capacity, throws if data doesn't fit.
+class BitcoinBufferStream : public BitcoinStream
+{
+public:
+    BitcoinBufferStream(uint8_t* buffer, size_t capacity);
+    BitcoinBufferStream& write_data(const uint8_t* data, uint32_t len) override;
+    size_t get_bytes_written() const;
+private:
+    uint8_t* const m_buffer;
+    const size_t m_capacity;
+    size_t m_size;
+};
+
+// Passes everything written to a hasher, so data can be hashed without buffering it.
+class BitcoinHashStream : public BitcoinStream
+{
+public:
+    explicit BitcoinHashStream(Hasher* hasher);
+    BitcoinHashStream& write_data(const uint8_t* data, uint32_t len) override;
+private:
+    Hasher* const m_hasher;
+};
+
 // Does no writing, only counting how many bytes would have been written.
 class BitcoinBytesCountStream : public BitcoinStream
 {
@@ -65,6 +89,10 @@ struct CompactSizeWrapper
 
 ReversedBinaryData reverse(const BinaryData& data);
 void write_compact_size(uint64_t size, BitcoinStream* stream);
+// Number of bytes written by write_compact_size() for given size.
+size_t get_compact_size_length(uint64_t size);
+// Number of bytes written by serializing destination to a stream.
+size_t get_destination_serialized_size(const BitcoinTransactionDestinationBase& destination);
 
 template <typename T>
 CompactSizeWrapper<T> as_compact_size(const T& value)
@@ -15,6 +15,8 @@
 #include "multy_core/src/exception_stream.h"
 #include "multy_core/src/api/properties_impl.h"
 #include "multy_core/src/bitcoin/bitcoin_account.h"
+#include "multy_core/src/bitcoin/bitcoin_coin_selection.h"
+#include "multy_core/src/bitcoin/bitcoin_key.h"
 #include "multy_core/src/exception.h"
 #include "multy_core/src/hash.h"
 #include "multy_core/src/u_ptr.h"
@@ -29,6 +31,8 @@
 #include "third-party/portable_endian.h"
 
 #include <algorithm>
+#include <array>
+#include <vector>
 #include <limits>
 #include <sstream>
 #include <string.h>
@@ -38,40 +42,14 @@ namespace
 {
 using namespace multy_core::internal;
 const size_t BITCOIN_MAX_MESSAGE_LENGTH = 75;
-const size_t BITCOIN_DUST_RELAY_FEE_PER_BYTE = 3;
-const size_t BITCOIN_AVERAGE_OUTPUT_AND_INPUT_SIZE_NON_SEGWIT = 182;
-const size_t BITCOIN_AVERAGE_OUTPUT_AND_INPUT_SIZE_SEGWIT = 98;
+// push(DER signature + sighash byte) + push(public key).
+const size_t BITCOIN_MAX_SCRIPT_SIGNATURE_SIZE
+        = 1 + EC_SIGNATURE_DER_MAX_LEN + 1 + 1 + EC_PUBLIC_KEY_UNCOMPRESSED_LEN;
 
 // BIP-125: Any value less than (BITCOIN_INPUT_SEQ_FINAL - 1) would do, see
 // https://github.com/bitcoin/bips/blob/master/bip-0125.mediawiki
 const uint32_t BITCOIN_INPUT_SEQ_REPLACEABLE = BITCOIN_INPUT_SEQ_FINAL - 2;
 
-bool is_dust_amount(const BigInt& amount, bool is_segwit)
-{
-    // NOTE: "Dust" is defined in terms of BITCOIN_DUST_RELAY_FEE_PER_BYTE,
-    // which has units satoshis-per-byte.
-    // If you'd pay more in fees than the value of the output
-    // to spend something, then we consider it dust.
-    // A typical spendable non-segwit txout is 34 bytes big, and will
-    // need a CTxIn of at least 148 bytes to spend:
-    // so dust is a spendable txout less than
-    // 182*BITCOIN_DUST_RELAY_FEE_PER_BYTE (in satoshis).
-    // 546 satoshis at the default rate of 3 sat/B.
-    // A typical spendable segwit txout is 31 bytes big, and will
-    // need a CTxIn of at least 67 bytes to spend:
-    // so dust is a spendable txout less than
-    // 98*BITCOIN_DUST_RELAY_FEE_PER_BYTE (in satoshis).
-    // 294 satoshis at the default rate of 3 sat/B.
-    // Look for more info: https://github.com/bitcoin/bitcoin/blob/e057589dc67f25da6779b60d0e247a3730adbc6d/src/policy/policy.cpp#L18
-
-    const uint64_t nsize = is_segwit ? BITCOIN_AVERAGE_OUTPUT_AND_INPUT_SIZE_SEGWIT: BITCOIN_AVERAGE_OUTPUT_AND_INPUT_SIZE_NON_SEGWIT;
-    if (amount < BigInt(nsize * BITCOIN_DUST_RELAY_FEE_PER_BYTE))
-    {
-        return true;
-    }
-    return false;
-}
-
 } // namespace
 
 namespace multy_core
@@ -106,6 +84,26 @@ void BitcoinTransactionSource::serializeToStream(BitcoinStream* stream) const
     *stream << *sequence;
 }
 
+size_t BitcoinTransactionSource::get_max_script_signature_size() const
+{
+    const PublicKeyPtr public_key = private_key->make_public_key();
+    return 1 + EC_SIGNATURE_DER_MAX_LEN + 1 // signature and hash-code type
+            + 1 + public_key->get_content().len;
+}
+
+void BitcoinTransactionSource::serialize_placeholder_to_stream(BitcoinStream* stream) const
+{
+    static const std::array<uint8_t, BITCOIN_MAX_SCRIPT_SIGNATURE_SIZE> placeholder = {};
+    const size_t script_signature_size = get_max_script_signature_size();
+    INVARIANT(script_signature_size <= placeholder.size());
+
+    *stream << reverse(**prev_transaction_hash);
+    *stream << prev_transaction_out_index;
+    *stream << as_compact_size(script_signature_size);
+    stream->write_data(placeholder.data(), script_signature_size);
+    *stream << *sequence;
+}
+
 BitcoinTransaction::BitcoinTransaction(BlockchainType blockchain_type)
     : BitcoinTransactionBase(blockchain_type),
       m_version(1),
@@ -113,24 +111,64 @@ BitcoinTransaction::BitcoinTransaction(BlockchainType blockchain_type)
       m_lock_time(0),
       m_is_replaceable(1, get_transaction_properties(),
                 "is_replaceable", Property::OPTIONAL),
-      m_message()
+      m_coin_selection(0, get_transaction_properties(),
+                "coin_selection", Property::OPTIONAL,
+                [this](int32_t /*new_value*/)
+                {
+                    if (!m_sources.empty() || !m_candidate_sources.empty())
+                    {
+                        THROW_EXCEPTION2(ERROR_INVALID_ARGUMENT,
+                                "coin_selection can't be changed after sources were added.");
+                    }
+                }),
+      m_candidate_sources(),
+      m_selected_candidates(),
+      m_message(),
+      m_serialized()
 {
     register_properties("", m_fee->get_properties());
 }
 
 BinaryDataPtr BitcoinTransaction::serialize()
+{
+    return make_clone(get_serialized());
+}
+
+size_t BitcoinTransaction::get_serialized_size()
+{
+    return get_serialized().len;
+}
+
+size_t BitcoinTransaction::serialize_into(uint8_t* buffer, size_t capacity)
+{
+    return copy_serialized(get_serialized(), buffer, capacity);
+}
+
+const BinaryData& BitcoinTransaction::get_serialized()
 {
     update();
     sign();
 
-    BitcoinDataStream data_stream;
+    if (!is_up_to_date(CACHED_STEP_SERIALIZE))
+    {
+        BitcoinBytesCountStream counter;
+        serialize_to_stream(&counter, WITH_POSITIVE_CHANGE_AMOUNT);
+
+        BinaryDataPtr result = new_binary_data(counter.get_bytes_count());
+        BitcoinBufferStream stream(const_cast<unsigned char*>(result->data), result->len);
+        serialize_to_stream(&stream, WITH_POSITIVE_CHANGE_AMOUNT);
 
-    serialize_to_stream(&data_stream, WITH_POSITIVE_CHANGE_AMOUNT);
-    return make_clone(data_stream.get_content());
+        m_serialized.swap(result);
+        set_up_to_date(CACHED_STEP_SERIALIZE);
+    }
+
+    return *m_serialized;
 }
 
 template <typename T>
-void BitcoinTransaction::serialize_to_stream(T* stream, DestinationsToUse destinations_to_use) const
+void BitcoinTransaction::serialize_to_stream(T* stream,
+        DestinationsToUse destinations_to_use,
+        SourcesToUse sources_to_use) const
 {
     // nVersion
     *stream << m_version;
@@ -138,7 +176,15 @@ void BitcoinTransaction::serialize_to_stream(T* stream, DestinationsToUse destin
     *stream << as_compact_size(m_sources.size());
     for (const auto& source : m_sources)
     {
-        *stream << *source;
+        if (sources_to_use == WITH_SCRIPT_SIGNATURE_PLACEHOLDERS)
+        {
+            static_cast<const BitcoinTransactionSource&>(*source)
+                    .serialize_placeholder_to_stream(stream);
+        }
+        else
+        {
+            *stream << *source;
+        }
     }
     // txouts
     const auto destinations = get_non_zero_destinations(destinations_to_use);
@@ -219,9 +265,9 @@ void BitcoinTransaction::verify() const
     size_t source_index = 0;
     for (const auto& s : m_sources)
     {
-        const auto& public_key = s->private_key->make_public_key();
-        const auto public_key_hash = do_hash<BITCOIN_HASH, 160>(public_key->get_content());
-        BinaryDataPtr sig_script = make_script_pub_key(as_binary_data(public_key_hash), BITCOIN_ADDRESS_P2PKH);
+        const BinaryData public_key_hash
+                = as_bitcoin_private_key(**s->private_key).get_public_key_hash();
+        BinaryDataPtr sig_script = make_script_pub_key(public_key_hash, BITCOIN_ADDRESS_P2PKH);
 
         if (*sig_script != **s->prev_transaction_out_script_pubkey)
         {
@@ -255,8 +301,89 @@ void BitcoinTransaction::verify() const
 }
 
 
+void BitcoinTransaction::reset_selected_sources()
+{
+    INVARIANT(m_sources.size() == m_selected_candidates.size());
+    for (size_t i = 0; i < m_sources.size(); ++i)
+    {
+        m_candidate_sources[m_selected_candidates[i]] = std::move(m_sources[i]);
+    }
+    m_sources.clear();
+    m_selected_candidates.clear();
+}
+
+void BitcoinTransaction::select_sources()
+{
+    reset_selected_sources();
+
+    BigInt target(0);
+    BitcoinTransactionDestinationBase* change_destination = nullptr;
+    for (const auto& d : m_destinations)
+    {
+        if (*d->is_change)
+        {
+            change_destination = d.get();
+            change_destination->amount.get_value() = BigInt{0};
+        }
+        else
+        {
+            target += *d->amount;
+        }
+    }
+
+    CoinSelectionParams params;
+    params.target = target.get_value_as_uint64();
+    params.amount_per_byte = m_fee->get_amount_per_byte().get_value_as_uint64();
+    params.min_change = get_dust_threshold(false);
+
+    // Using same size model as update(): size of TX with no sources and zero
+    // change, plus size of each source, computed separately.
+    params.base_size = get_transaction_serialized_size(WITH_POSITIVE_CHANGE_AMOUNT);
+    // Inputs count is going to take more space than for no inputs.
+    params.base_size += get_compact_size_length(m_candidate_sources.size())
+            - get_compact_size_length(0);
+    params.change_output_size = change_destination
+            ? get_destination_serialized_size(*change_destination) : 0;
+
+    std::vector<CoinSelectionCandidate> candidates;
+    candidates.reserve(m_candidate_sources.size());
+    for (const auto& source : m_candidate_sources)
+    {
+        BitcoinBytesCountStream source_stream;
+        static_cast<const BitcoinTransactionSource&>(*source)
+                .serialize_placeholder_to_stream(&source_stream);
+        candidates.push_back(CoinSelectionCandidate{
+                source->amount.get_value().get_value_as_uint64(),
+                source_stream.get_bytes_count()});
+    }
+
+    const std::vector<size_t> selected = select_coins(candidates, params);
+    if (selected.empty())
+    {
+        THROW_EXCEPTION2(ERROR_TRANSACTION_INSUFFICIENT_FUNDS,
+                "Not enough funds in candidate sources to pay for destinations and fee.")
+                << " Candidates count: " << m_candidate_sources.size() << ".";
+    }
+
+    for (const size_t index : selected)
+    {
+        m_sources.push_back(std::move(m_candidate_sources[index]));
+    }
+    m_selected_candidates = selected;
+}
+
 void BitcoinTransaction::update()
 {
+    if (is_up_to_date(CACHED_STEP_UPDATE))
+    {
+        return;
+    }
+
+    if (*m_coin_selection)
+    {
+        select_sources();
+    }
+
     verify();
 
     size_t change_destinations_count = 0;
@@ -288,14 +415,24 @@ void BitcoinTransaction::update()
                 << " Currenctly there are: " << change_destinations_count;
     }
 
-    // In order to compute transaction total cost we'll have to serialize tx.
+    // Size of the TX doesn't depend on change amount (it is always 8 bytes),
+    // so size with change output can be computed from size without it, and
+    // the change is whatever is left after paying fee for that size.
     if (change_destination)
     {
         change_destination->amount.get_value() = BigInt{0};
-        uint64_t tx_size = get_transaction_serialized_size(WITH_NONPOSITIVE_CHANGE_AMOUNT);
-        BigInt expected_fee = tx_size * *m_fee->amount_per_byte;
-        BigInt current_fee = calculate_diff();
-        const BigInt remainder = current_fee - expected_fee;
+    }
+    uint64_t tx_size = get_transaction_serialized_size(WITH_POSITIVE_CHANGE_AMOUNT);
+
+    if (change_destination)
+    {
+        const size_t outputs_count = get_non_zero_destinations(WITH_POSITIVE_CHANGE_AMOUNT).size();
+        const uint64_t tx_size_with_change = tx_size
+                + get_destination_serialized_size(*change_destination)
+                + get_compact_size_length(outputs_count + 1)
+                - get_compact_size_length(outputs_count);
+        const BigInt remainder = calculate_diff()
+                - tx_size_with_change * *m_fee->amount_per_byte;
 
         // NOTE: Not adding a change if output is an "dust". cost of spending money from that output exceeds its value.
         //
@@ -307,53 +444,43 @@ void BitcoinTransaction::update()
         //  * 98 bytes for SegWit TX
         //
         // Not adding change for leftovers less than said limits increases fee for this TX.
-
         if (!is_dust_amount(remainder, false))
         {
             // not setting value with set_value(), since that would fail for read-only property.
-            change_destination->amount.get_value() += remainder;
-
-            tx_size = get_transaction_serialized_size(WITH_POSITIVE_CHANGE_AMOUNT);
-            expected_fee = tx_size * *m_fee->amount_per_byte;
-            current_fee = calculate_diff();
-            while (expected_fee > current_fee)
-            {
-                // NOTE: get shortage fee from change_destination amount
-                //      diff_fee is always negative here.
-                const BigInt diff_fee = current_fee - expected_fee;
-                change_destination->amount.get_value() += diff_fee;
-                // Recalculate transaction fee after changes in transaction
-                tx_size = get_transaction_serialized_size(WITH_POSITIVE_CHANGE_AMOUNT);
-                expected_fee = tx_size * *m_fee->amount_per_byte;
-                current_fee = calculate_diff();
-            }
-
-            if (is_dust_amount(change_destination->amount.get_value(), false))
-            {
-                change_destination->amount.get_value() = BigInt{0};
-            }
+            change_destination->amount.get_value() = remainder;
+            tx_size = tx_size_with_change;
         }
     }
 
-    m_fee->validate_fee(calculate_diff(), get_transaction_serialized_size(WITH_POSITIVE_CHANGE_AMOUNT));
+    m_fee->validate_fee(calculate_diff(), tx_size);
 
     if (get_non_zero_destinations(WITH_POSITIVE_CHANGE_AMOUNT).size() == 0)
     {
         THROW_EXCEPTION2(ERROR_TRANSACTION_CHANGE_IS_TOO_SMALL_AND_NO_OTHER_DESTINATIONS,
                 "Transaction change is to small because of high fee.");
     }
+    set_up_to_date(CACHED_STEP_UPDATE);
 }
 
-uint64_t BitcoinTransaction::get_transaction_serialized_size(DestinationsToUse destinations_to_use)
+uint64_t BitcoinTransaction::get_transaction_serialized_size(DestinationsToUse destinations_to_use) const
 {
-    sign();
+    // Not signing here, since that is expensive: signing each input requires
+    // serializing whole TX, and size is queried many times during update().
+    // Instead assume worst-case signature size, so actual TX can only be
+    // smaller (by few bytes per input) and fee is never underestimated.
     BitcoinBytesCountStream counter_stream;
-    serialize_to_stream(&counter_stream, destinations_to_use);
+    serialize_to_stream(&counter_stream, destinations_to_use,
+            WITH_SCRIPT_SIGNATURE_PLACEHOLDERS);
     return counter_stream.get_bytes_count();
 }
 
 void BitcoinTransaction::sign()
 {
+    if (is_up_to_date(CACHED_STEP_SIGN))
+    {
+        return;
+    }
+
     // Sign inputs:
     // for every input:
     //      reset sig script with nullptr
@@ -371,6 +498,10 @@ void BitcoinTransaction::sign()
         source->script_signature.reset();
     }
 
+    // Signed data is the whole transaction, so it is hashed while being
+    // serialized, instead of buffering it for every input.
+    HasherPtr hasher = make_hasher(SHA2_DOUBLE, 256);
+
     // Sign all inputs one by one and save sig_scripts for later.
     std::unordered_map<BitcoinTransactionSourceBase*, BinaryDataPtr> sig_scripts;
     for (auto& source : m_sources)
@@ -380,20 +511,26 @@ void BitcoinTransaction::sign()
         BinaryDataPtr sig_script;
 
         {
-            BitcoinDataStream hash_stream;
+            const BitcoinPrivateKey& private_key
+                    = as_bitcoin_private_key(**source->private_key);
+
+            BitcoinHashStream hash_stream(hasher.get());
             serialize_to_stream(&hash_stream, WITH_POSITIVE_CHANGE_AMOUNT);
             hash_stream << uint32_t(1); // signature version
 
-            const PrivateKeyPtr& private_key = source->private_key.get_value();
+            hash<256> data_hash;
+            BinaryData data_hash_data = as_binary_data(data_hash);
+            hasher->finalize(&data_hash_data);
+
             BinaryDataPtr signature
-                    = private_key->sign(hash_stream.get_content());
+                    = private_key.sign_hash(data_hash_data);
 
             BitcoinDataStream sig_script_stream;
             sig_script_stream << as_compact_size(signature->len + 1);
             sig_script_stream << *signature;
             sig_script_stream << uint8_t(1); // hash-code type
 
-            const PublicKeyPtr& public_key = private_key->make_public_key();
+            const PublicKeyPtr& public_key = private_key.make_public_key();
             const BinaryData& public_key_data = public_key->get_content();
             sig_script_stream << as_compact_size(public_key_data.len);
             sig_script_stream << public_key_data;
@@ -415,11 +552,21 @@ void BitcoinTransaction::sign()
 
         source->script_signature.swap(p->second);
     }
+    set_up_to_date(CACHED_STEP_SIGN);
 }
 
 Properties& BitcoinTransaction::add_source()
 {
     BitcoinTransactionSourcePtr source(new BitcoinTransactionSource());
+    if (*m_coin_selection)
+    {
+        reset_selected_sources();
+        m_candidate_sources.emplace_back(std::move(source));
+        return register_properties(
+                make_id("#", m_candidate_sources.size() - 1),
+                m_candidate_sources.back()->get_properties());
+    }
+
     m_sources.emplace_back(std::move(source));
     return register_properties(
             make_id("#", m_sources.size() - 1),
@@ -456,6 +603,7 @@ void BitcoinTransaction::set_message(const BinaryData& value)
     sig_stream << as_compact_size(value.len);
     sig_stream.write_data(value.data, value.len);
     m_message->sig_script = make_clone(sig_stream.get_content());
+    set_dirty();
 }
 
 } // namespace internal
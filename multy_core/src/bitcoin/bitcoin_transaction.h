@@ -25,6 +25,12 @@ enum DestinationsToUse
     WITH_NONPOSITIVE_CHANGE_AMOUNT
 };
 
+enum SourcesToUse
+{
+    WITH_SCRIPT_SIGNATURES,
+    WITH_SCRIPT_SIGNATURE_PLACEHOLDERS
+};
+
 class BitcoinTransactionSource : public BitcoinTransactionSourceBase
 {
 public:
@@ -32,6 +38,14 @@ public:
     ~BitcoinTransactionSource();
 
     void serializeToStream(BitcoinStream*) const override;
+
+    // Size of the script_signature for this source, assuming worst-case
+    // (longest) DER-encoded signature, computed without actual signing.
+    size_t get_max_script_signature_size() const;
+
+    // Same as serializeToStream(), but with zero-filled placeholder of
+    // get_max_script_signature_size() bytes instead of script_signature.
+    void serialize_placeholder_to_stream(BitcoinStream*) const;
 };
 
 class BitcoinAccount;
@@ -51,17 +65,21 @@ public:
     BigInt get_total_spent() const override;
     BigInt estimate_total_fee(size_t sources_count, size_t destinations_count) const override;
     BinaryDataPtr serialize() override;
+    size_t get_serialized_size() override;
+    size_t serialize_into(uint8_t* buffer, size_t capacity) override;
     Properties& add_source() override;
     Properties& add_destination() override;
     void set_message(const BinaryData& value) override;
 
 private:
-    uint64_t get_transaction_serialized_size(DestinationsToUse destinations_to_use);
+    uint64_t get_transaction_serialized_size(DestinationsToUse destinations_to_use) const;
     void verify() const override;
     void sign();
+    const BinaryData& get_serialized();
 
     template <typename T>
-    void serialize_to_stream(T* stream, DestinationsToUse destinations_to_use) const;
+    void serialize_to_stream(T* stream, DestinationsToUse destinations_to_use,
+            SourcesToUse sources_to_use = WITH_SCRIPT_SIGNATURES) const;
     bool is_segwit() const;
 
     typedef std::vector<const BitcoinTransactionDestinationBase*> Destinations;
@@ -69,13 +87,27 @@ private:
 
     size_t estimate_transaction_size() const;
 
+    // Puts previously selected sources back to candidates.
+    void reset_selected_sources();
+    // Moves subset of candidates sufficient to pay for destinations and fee
+    // to m_sources.
+    void select_sources();
+
 private:
     int32_t m_version;
     int32_t m_is_segwit_transaction;
     uint32_t m_lock_time;
     PropertyT<int32_t> m_is_replaceable;
+    // If set, all sources added are candidates for coin selection,
+    // and update() picks only some of those.
+    PropertyT<int32_t> m_coin_selection;
+
+    std::vector<BitcoinTransactionSourceBasePtr> m_candidate_sources;
+    // Indices in m_candidate_sources of sources in m_sources.
+    std::vector<size_t> m_selected_candidates;
 
     BitcoinTransactionDestinationBasePtr m_message;
+    BinaryDataPtr m_serialized;
 };
 
 } // namespace internal
@@ -21,6 +21,10 @@ namespace
 {
 using namespace multy_core::internal;
 
+const size_t BITCOIN_DUST_RELAY_FEE_PER_BYTE = 3;
+const size_t BITCOIN_AVERAGE_OUTPUT_AND_INPUT_SIZE_NON_SEGWIT = 182;
+const size_t BITCOIN_AVERAGE_OUTPUT_AND_INPUT_SIZE_SEGWIT = 98;
+
 BinaryDataPtr make_script_pub_key_from_address(const BitcoinNetType expected_net_type, const std::string& address)
 {
     BitcoinNetType net_type;
@@ -78,6 +82,33 @@ BinaryDataPtr make_script_pub_key(const BinaryData& public_key_hash, BitcoinAddr
     return make_clone(sig_stream.get_content());
 }
 
+uint64_t get_dust_threshold(bool is_segwit)
+{
+    // NOTE: "Dust" is defined in terms of BITCOIN_DUST_RELAY_FEE_PER_BYTE,
+    // which has units satoshis-per-byte.
+    // If you'd pay more in fees than the value of the output
+    // to spend something, then we consider it dust.
+    // A typical spendable non-segwit txout is 34 bytes big, and will
+    // need a CTxIn of at least 148 bytes to spend:
+    // so dust is a spendable txout less than
+    // 182*BITCOIN_DUST_RELAY_FEE_PER_BYTE (in satoshis).
+    // 546 satoshis at the default rate of 3 sat/B.
+    // A typical spendable segwit txout is 31 bytes big, and will
+    // need a CTxIn of at least 67 bytes to spend:
+    // so dust is a spendable txout less than
+    // 98*BITCOIN_DUST_RELAY_FEE_PER_BYTE (in satoshis).
+    // 294 satoshis at the default rate of 3 sat/B.
+    // Look for more info: https://github.com/bitcoin/bitcoin/blob/e057589dc67f25da6779b60d0e247a3730adbc6d/src/policy/policy.cpp#L18
+
+    const uint64_t nsize = is_segwit ? BITCOIN_AVERAGE_OUTPUT_AND_INPUT_SIZE_SEGWIT: BITCOIN_AVERAGE_OUTPUT_AND_INPUT_SIZE_NON_SEGWIT;
+    return nsize * BITCOIN_DUST_RELAY_FEE_PER_BYTE;
+}
+
+bool is_dust_amount(const BigInt& amount, bool is_segwit)
+{
+    return amount < BigInt(get_dust_threshold(is_segwit));
+}
+
 BitcoinTransactionDestinationBase::BitcoinTransactionDestinationBase(BitcoinNetType net_type)
     : amount(m_properties,
              "amount",
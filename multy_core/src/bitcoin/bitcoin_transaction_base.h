@@ -21,6 +21,10 @@ class BitcoinStream;
 
 BinaryDataPtr make_script_pub_key(const BinaryData& public_key_hash, BitcoinAddressType address_type);
 
+// Outputs with amount less than that are not relayed by nodes.
+uint64_t get_dust_threshold(bool is_segwit);
+bool is_dust_amount(const BigInt& amount, bool is_segwit);
+
 class BitcoinTransactionDestinationBase;
 class BitcoinTransactionSourceBase;
 class BitcoinTransactionFeeBase;
@@ -7,6 +7,7 @@
 #include "multy_core/src/bitcoin/bitcoin_transaction_segwit.h"
 
 #include "multy_core/src/bitcoin/bitcoin_account.h"
+#include "multy_core/src/bitcoin/bitcoin_key.h"
 #include "multy_core/src/bitcoin/bitcoin_opcode.h"
 #include "multy_core/src/bitcoin/bitcoin_stream.h"
 #include "multy_core/src/bitcoin/bitcoin_transaction_base.h"
@@ -19,6 +20,7 @@
 
 #include "wally_crypto.h"
 
+#include <algorithm>
 #include <array>
 
 namespace {
@@ -28,6 +30,24 @@ const int32_t BITCOIN_LOCK_TIME = 0x00000000;
 const int32_t BITCOIN_SEGWIT_TRANSACTION_VERSION = 2;
 const uint8_t SIZE_SCRIPT_PUBKEY_SOURCE_P2SH_P2WPKH = 0x19;
 const uint32_t SIGHASH_ALL = 1;
+const size_t BITCOIN_WITNESS_SCALE_FACTOR = 4;
+
+// Sizes of P2SH-P2WPKH input and output, used for estimation only.
+const size_t BITCOIN_SEGWIT_INPUT_SIZE = 32 + 4 + 1 + 23 + 4;
+const size_t BITCOIN_SEGWIT_INPUT_WITNESS_SIZE
+        = 1 + (1 + EC_SIGNATURE_DER_MAX_LEN + 1) + (1 + EC_PUBLIC_KEY_LEN);
+const size_t BITCOIN_OUTPUT_SIZE = 8 + 1 + 25; // P2PKH is bigger than P2SH.
+// version, inputs count, outputs count, lock time.
+const size_t BITCOIN_TRANSACTION_OVERHEAD_SIZE = 4 + 1 + 1 + 4;
+// marker and flag.
+const size_t BITCOIN_SEGWIT_OVERHEAD_WITNESS_SIZE = 2;
+
+uint64_t get_virtual_size(uint64_t base_size, uint64_t witness_size)
+{
+    // weight = base_size * 3 + total_size, and total_size = base_size + witness_size.
+    const uint64_t weight = base_size * BITCOIN_WITNESS_SCALE_FACTOR + witness_size;
+    return (weight + BITCOIN_WITNESS_SCALE_FACTOR - 1) / BITCOIN_WITNESS_SCALE_FACTOR;
+}
 
 } // namespace
 
@@ -50,8 +70,8 @@ void BitcoinTransactionSegWitSource::sign(const hash<256>& hash_prevouts, const
 {
     // https://github.com/bitcoin/bips/blob/master/bip-0143.mediawiki
 
-    const auto segwit_script_P2WPKH = do_hash<BITCOIN_HASH, 160>(private_key.get_value()->make_public_key()->get_content());
-    BinaryData public_key_hash_data = as_binary_data(segwit_script_P2WPKH);
+    const BinaryData public_key_hash_data
+            = as_bitcoin_private_key(**private_key).get_public_key_hash();
 
     BinaryDataPtr signature;
     {
@@ -102,16 +122,26 @@ void BitcoinTransactionSegWitSource::serializeToStream(BitcoinStream* stream) co
     *stream << *sequence;
 }
 
+size_t BitcoinTransactionSegWitSource::get_max_script_witness_size() const
+{
+    const PublicKeyPtr public_key = private_key->make_public_key();
+    return 1 // elements count
+            + 1 + EC_SIGNATURE_DER_MAX_LEN + 1 // signature and hash-code type
+            + 1 + public_key->get_content().len;
+}
+
 BinaryDataPtr BitcoinTransactionSegWitSource::make_script_sig() const
 {
     BitcoinDataStream result;
 
-    const PublicKeyPtr& public_key = private_key.get_value()->make_public_key();
+    const BinaryData public_key_hash
+            = as_bitcoin_private_key(**private_key).get_public_key_hash();
     std::array<uint8_t, HASH160_LEN + 2> segwit_script_P2WPKH;
-    BinaryData public_key_hash_data = power_slice(as_binary_data(segwit_script_P2WPKH), 2, -2);
     segwit_script_P2WPKH[0] = OP_0; // Version byte witness
     segwit_script_P2WPKH[1] = HASH160_LEN; // Witness program is 20 bytes
-    do_hash_inplace<BITCOIN_HASH, 160>(public_key->get_content(), &public_key_hash_data);
+    INVARIANT(public_key_hash.len == HASH160_LEN);
+    std::copy(public_key_hash.data, public_key_hash.data + public_key_hash.len,
+            segwit_script_P2WPKH.begin() + 2);
 
     result << static_cast<uint8_t>(segwit_script_P2WPKH.size()); // size script to P2SH
     result << as_binary_data(segwit_script_P2WPKH);
@@ -123,7 +153,12 @@ BitcoinTransactionSegWit::BitcoinTransactionSegWit(BlockchainType blockchain_typ
     : BitcoinTransactionBase(blockchain_type),
       m_version(BITCOIN_SEGWIT_TRANSACTION_VERSION),
       lock_time(BITCOIN_LOCK_TIME,
-                    m_properties, "nlocktime", Property::OPTIONAL)
+                    m_properties, "nlocktime", Property::OPTIONAL),
+      m_signing_threads(1,
+                    m_properties, "signing_threads", Property::OPTIONAL,
+                    &verify_bigger_than<int32_t, 0>),
+      m_signing_pool(),
+      m_serialized()
 {
     register_properties("", m_fee->get_properties());
 }
@@ -154,50 +189,195 @@ void BitcoinTransactionSegWit::set_message(const BinaryData& /*value*/)
     THROW_EXCEPTION("Not implemented yet");
 }
 
-BigInt BitcoinTransactionSegWit::estimate_total_fee(size_t /*sources_count*/, size_t /*destinations_count*/) const
+BigInt BitcoinTransactionSegWit::estimate_total_fee(size_t sources_count, size_t destinations_count) const
 {
-    THROW_EXCEPTION("Not implemented yet");
+    const uint64_t base_size = BITCOIN_TRANSACTION_OVERHEAD_SIZE
+            + sources_count * BITCOIN_SEGWIT_INPUT_SIZE
+            + destinations_count * BITCOIN_OUTPUT_SIZE;
+    const uint64_t witness_size = BITCOIN_SEGWIT_OVERHEAD_WITNESS_SIZE
+            + sources_count * BITCOIN_SEGWIT_INPUT_WITNESS_SIZE;
+
+    return get_virtual_size(base_size, witness_size) * m_fee->get_amount_per_byte();
 }
 
 BigInt BitcoinTransactionSegWit::get_total_spent() const
 {
-    THROW_EXCEPTION("Not implemented yet");
+    BigInt total_spent(0);
+    for (const auto& d : m_destinations)
+    {
+        if (!*d->is_change)
+        {
+            total_spent += *d->amount;
+        }
+    }
+
+    return total_spent + get_total_fee();
 }
 
 void BitcoinTransactionSegWit::update()
 {
-    this->verify();
-    sign();
+    if (is_up_to_date(CACHED_STEP_UPDATE))
+    {
+        return;
+    }
+
+    size_t change_destinations_count = 0;
+    BitcoinTransactionDestinationBase* change_destination = nullptr;
+    for (const auto& d : m_destinations)
+    {
+        if (*d->is_change)
+        {
+            change_destination = d.get();
+            ++change_destinations_count;
+        }
+    }
+    if (change_destinations_count > 1)
+    {
+        THROW_EXCEPTION2(ERROR_TRANSACTION_TOO_MANY_CHANGE_DESTINATIONS,
+                "Transaction should have only one change address.")
+                << " Currenctly there are: " << change_destinations_count;
+    }
+
+    // Same as for non-SegWit TX: change amount doesn't affect TX size,
+    // so change is what is left after paying fee for TX with change output.
+    // Change output is not witness data, so it adds to virtual size 1:1.
+    // Change from previous update() should not be counted as spent by verify().
+    if (change_destination)
+    {
+        change_destination->amount.get_value() = BigInt{0};
+    }
+    verify();
 
+    uint64_t tx_vsize = get_transaction_vsize();
+
+    if (change_destination)
+    {
+        const size_t outputs_count = get_non_zero_destinations().size();
+        const uint64_t tx_vsize_with_change = tx_vsize
+                + get_destination_serialized_size(*change_destination)
+                + get_compact_size_length(outputs_count + 1)
+                - get_compact_size_length(outputs_count);
+        const BigInt remainder = calculate_diff()
+                - tx_vsize_with_change * m_fee->get_amount_per_byte();
+
+        // Not adding a change if it is a dust, see BitcoinTransaction::update().
+        // Outputs are P2PKH or P2SH, never native SegWit, hence non-SegWit dust.
+        if (!is_dust_amount(remainder, false))
+        {
+            // not setting value with set_value(), since that would fail for read-only property.
+            change_destination->amount.get_value() = remainder;
+            tx_vsize = tx_vsize_with_change;
+        }
+    }
+
+    m_fee->validate_fee(calculate_diff(), tx_vsize);
+
+    if (get_non_zero_destinations().size() == 0)
+    {
+        THROW_EXCEPTION2(ERROR_TRANSACTION_CHANGE_IS_TOO_SMALL_AND_NO_OTHER_DESTINATIONS,
+                "Transaction change is to small because of high fee.");
+    }
+    set_up_to_date(CACHED_STEP_UPDATE);
 }
 
 BinaryDataPtr BitcoinTransactionSegWit::serialize()
+{
+    return make_clone(get_serialized());
+}
+
+size_t BitcoinTransactionSegWit::get_serialized_size()
+{
+    return get_serialized().len;
+}
+
+size_t BitcoinTransactionSegWit::serialize_into(uint8_t* buffer, size_t capacity)
+{
+    return copy_serialized(get_serialized(), buffer, capacity);
+}
+
+const BinaryData& BitcoinTransactionSegWit::get_serialized()
 {
     update();
+    sign();
+
+    if (!is_up_to_date(CACHED_STEP_SERIALIZE))
+    {
+        BitcoinBytesCountStream counter;
+        serialize_to_stream(&counter, true);
+
+        BinaryDataPtr result = new_binary_data(counter.get_bytes_count());
+        BitcoinBufferStream stream(const_cast<unsigned char*>(result->data), result->len);
+        serialize_to_stream(&stream, true);
+
+        m_serialized.swap(result);
+        set_up_to_date(CACHED_STEP_SERIALIZE);
+    }
+
+    return *m_serialized;
+}
 
-    BitcoinDataStream data_stream;
-    data_stream << m_version;
-    data_stream << static_cast<uint8_t>(0x00); // marker
-    data_stream << static_cast<uint8_t>(0x01); // flag
-    data_stream << as_compact_size(m_sources.size());
+template <typename T>
+void BitcoinTransactionSegWit::serialize_to_stream(T* stream, bool with_witness) const
+{
+    *stream << m_version;
+    if (with_witness)
+    {
+        *stream << static_cast<uint8_t>(0x00); // marker
+        *stream << static_cast<uint8_t>(0x01); // flag
+    }
+    *stream << as_compact_size(m_sources.size());
     for (const auto& source : m_sources)
     {
-        data_stream << *source;
+        *stream << *source;
     }
-    data_stream << as_compact_size(m_destinations.size());
-    for (const auto& destination : m_destinations)
+
+    const auto destinations = get_non_zero_destinations();
+    *stream << as_compact_size(destinations.size());
+    for (const auto& destination : destinations)
     {
-        data_stream << *destination;
+        *stream << *destination;
     }
 
+    if (with_witness)
+    {
+        for (const auto& source : m_sources)
+        {
+            *stream << *(static_cast<const BitcoinTransactionSegWitSource*>(source.get())->script_witness);
+        }
+    }
+
+    *stream << *lock_time;
+}
+
+uint64_t BitcoinTransactionSegWit::get_transaction_vsize() const
+{
+    // Not signing here, witness data is counted with worst-case signature
+    // sizes, so actual TX can only be smaller and fee is never underestimated.
+    BitcoinBytesCountStream base_stream;
+    serialize_to_stream(&base_stream, false);
+
+    uint64_t witness_size = BITCOIN_SEGWIT_OVERHEAD_WITNESS_SIZE;
     for (const auto& source : m_sources)
     {
-        data_stream << *(static_cast<const BitcoinTransactionSegWitSource*>(source.get())->script_witness);
+        witness_size += static_cast<const BitcoinTransactionSegWitSource*>(
+                source.get())->get_max_script_witness_size();
     }
 
-    data_stream << *lock_time;
+    return get_virtual_size(base_stream.get_bytes_count(), witness_size);
+}
 
-    return make_clone(data_stream.get_content());
+BitcoinTransactionSegWit::Destinations BitcoinTransactionSegWit::get_non_zero_destinations() const
+{
+    Destinations result;
+    for (const auto& dest : m_destinations)
+    {
+        // Change output is omitted if there is nothing left for it.
+        if (!*dest->is_change || *dest->amount > BigInt(0))
+        {
+            result.push_back(dest.get());
+        }
+    }
+    return result;
 }
 
 BitcoinNetType BitcoinTransactionSegWit::get_net_type() const
@@ -207,40 +387,92 @@ BitcoinNetType BitcoinTransactionSegWit::get_net_type() const
 
 void BitcoinTransactionSegWit::sign()
 {
+    if (is_up_to_date(CACHED_STEP_SIGN))
+    {
+        return;
+    }
+
     for (auto& source : m_sources)
     {
         source->script_signature.reset();
     }
 
-    BitcoinDataStream prev_outs_stream;
+    // BIP143 intermediate hashes are computed without buffering serialized data.
+    HasherPtr hasher = make_hasher(SHA2_DOUBLE, 256);
+    BitcoinHashStream hash_stream(hasher.get());
+
+    hash<256> hash_prevouts;
     for (const auto& source : m_sources)
     {
-        prev_outs_stream << reverse(**(source->prev_transaction_hash));
-        prev_outs_stream << source->prev_transaction_out_index;
+        hash_stream << reverse(**(source->prev_transaction_hash));
+        hash_stream << source->prev_transaction_out_index;
     }
+    BinaryData hash_data = as_binary_data(hash_prevouts);
+    hasher->finalize(&hash_data);
 
-    BitcoinDataStream outs_stream;
-    for (const auto& destination : m_destinations)
+    hash<256> hash_sequence;
+    for (const auto& source : m_sources)
     {
-        outs_stream << *destination;
+        hash_stream << *source->sequence;
     }
+    hash_data = as_binary_data(hash_sequence);
+    hasher->finalize(&hash_data);
 
-    BitcoinDataStream sequences_stream;
-    for (const auto& source : m_sources)
+    hash<256> hash_outs;
+    for (const auto& destination : get_non_zero_destinations())
     {
-        sequences_stream << *source->sequence;
+        hash_stream << *destination;
     }
+    hash_data = as_binary_data(hash_outs);
+    hasher->finalize(&hash_data);
 
+    // Each input is signed independently of others (BIP143), and the
+    // resulting witness depends only on input data (RFC6979 nonces),
+    // so signing concurrently gives exactly the same output.
+    const auto sign_source = [&](size_t index)
+    {
+        static_cast<BitcoinTransactionSegWitSource*>(m_sources[index].get())
+                ->sign(hash_prevouts, hash_sequence, hash_outs, *lock_time);
+    };
 
-    hash<256> hash_prevouts = do_hash<SHA2_DOUBLE, 256>(prev_outs_stream.get_content());
-    hash<256> hash_sequence = do_hash<SHA2_DOUBLE, 256>(sequences_stream.get_content());
-    hash<256> hash_outs = do_hash<SHA2_DOUBLE, 256>(outs_stream.get_content());
+    WorkerPool* pool = get_signing_pool();
+    if (pool && m_sources.size() > 1)
+    {
+        pool->run_for_each(m_sources.size(), sign_source);
+    }
+    else
+    {
+        for (size_t i = 0; i < m_sources.size(); ++i)
+        {
+            sign_source(i);
+        }
+    }
+    set_up_to_date(CACHED_STEP_SIGN);
+}
 
-    for (auto& source : m_sources)
+WorkerPool* BitcoinTransactionSegWit::get_signing_pool()
+{
+    if (*m_signing_threads == 1)
     {
-        static_cast<BitcoinTransactionSegWitSource*>(
-                source.get())->sign(hash_prevouts, hash_sequence, hash_outs, *lock_time);
+        m_signing_pool.reset();
+        return nullptr;
     }
+
+    // Calling thread also signs, hence pool has one thread less.
+    const size_t threads_count = *m_signing_threads == 0
+            ? std::max(1u, std::thread::hardware_concurrency())
+            : static_cast<size_t>(*m_signing_threads);
+    if (threads_count == 1)
+    {
+        return nullptr;
+    }
+
+    if (!m_signing_pool
+            || m_signing_pool->get_threads_count() != threads_count - 1)
+    {
+        m_signing_pool.reset(new WorkerPool(threads_count - 1));
+    }
+    return m_signing_pool.get();
 }
 
 void BitcoinTransactionSegWit::verify() const
@@ -250,15 +482,16 @@ void BitcoinTransactionSegWit::verify() const
     size_t source_index = 0;
     for (const auto& s: m_sources)
     {
-        const auto& public_key = s->private_key->make_public_key();
+        const BinaryData hash_pub_key
+                = as_bitcoin_private_key(**s->private_key).get_public_key_hash();
         BinaryData public_key_hash_data;
         std::array<uint8_t, HASH160_LEN> public_key_hash;
         public_key_hash_data = as_binary_data(public_key_hash);
         unsigned char segwit_script[HASH160_LEN+2] = {'\0'};
 
-        BinaryData hash_pub_key = power_slice(as_binary_data(segwit_script), 2, -2);
-
-        do_hash_inplace<BITCOIN_HASH, 160>(public_key->get_content(), &hash_pub_key);
+        INVARIANT(hash_pub_key.len == HASH160_LEN);
+        std::copy(hash_pub_key.data, hash_pub_key.data + hash_pub_key.len,
+                segwit_script + 2);
         segwit_script[0] = 0x00;
         segwit_script[1] = HASH160_LEN;
         do_hash_inplace<BITCOIN_HASH, 160>(as_binary_data(segwit_script), &public_key_hash_data);
@@ -281,6 +514,18 @@ void BitcoinTransactionSegWit::verify() const
         }
         ++source_index;
     }
+
+    if (get_net_type() == BITCOIN_NET_TYPE_MAINNET)
+    {
+        for (const auto& d : m_destinations)
+        {
+            if (!*d->is_change && is_dust_amount(d->amount.get_value(), false))
+            {
+                THROW_EXCEPTION2(ERROR_TRANSACTION_TRANSFER_AMOUNT_TOO_SMALL,
+                        "Bitcoin dust output.");
+            }
+        }
+    }
 }
 
 } // namespace internal
@@ -12,6 +12,7 @@
 #include "multy_core/src/api/properties_impl.h"
 #include "multy_core/src/bitcoin/bitcoin_transaction_base.h"
 #include "multy_core/src/hash.h"
+#include "multy_core/src/worker_pool.h"
 
 #include <vector>
 
@@ -31,6 +32,10 @@ public:
 
     void serializeToStream(BitcoinStream*) const override;
 
+    // Size of the script_witness for this source, assuming worst-case
+    // (longest) DER-encoded signature, computed without actual signing.
+    size_t get_max_script_witness_size() const;
+
 private:
     BinaryDataPtr make_script_sig() const;
 
@@ -57,17 +62,35 @@ public:
 
     void update() override;
     BinaryDataPtr serialize() override;
+    size_t get_serialized_size() override;
+    size_t serialize_into(uint8_t* buffer, size_t capacity) override;
 
 private:
     void sign();
+    const BinaryData& get_serialized();
     void verify() const override;
 
+    template <typename T>
+    void serialize_to_stream(T* stream, bool with_witness) const;
+    // Virtual size of the transaction (BIP141), witness data is counted
+    // with worst-case signature sizes.
+    uint64_t get_transaction_vsize() const;
+
+    typedef std::vector<const BitcoinTransactionDestinationBase*> Destinations;
+    Destinations get_non_zero_destinations() const;
+
     BitcoinNetType get_net_type() const;
+    WorkerPool* get_signing_pool();
 
 private:
     int32_t m_version;
 
     PropertyT<int32_t> lock_time;
+    // Number of threads to sign inputs with:
+    // 1 (default) - sign on the calling thread, 0 - as many as there are cores.
+    PropertyT<int32_t> m_signing_threads;
+    WorkerPoolPtr m_signing_pool;
+    BinaryDataPtr m_serialized;
 };
 
 } // namespace internal
@@ -68,8 +68,7 @@ TransactionBuilderPtr BlockchainFacadeBase::make_transaction_builder_by_name(
 }
 
 BlockchainFacadeRegistry::BlockchainFacadeRegistry()
-    : m_instances(),
-      m_factory_functions()
+    : m_instances()
 {
     // Exiplictly registering blockchains, since when multy_core
     // is compiled as static library, registrar-based approach,
@@ -85,6 +84,8 @@ BlockchainFacadeRegistry::BlockchainFacadeRegistry()
 #if MULTY_WITH_EOS
     register_blockchain<EosFacade>(BLOCKCHAIN_EOS);
 #endif
+
+    init_secp256k1_context();
 }
 
 BlockchainFacadeRegistry::~BlockchainFacadeRegistry()
@@ -98,39 +99,45 @@ BlockchainFacadeRegistry& BlockchainFacadeRegistry::get_instance()
 }
 
 BlockchainFacadeBase& BlockchainFacadeRegistry::get_blockchain(
-        Blockchain blockchain_type)
+        Blockchain blockchain_type) const
 {
-    auto instance = m_instances.find(blockchain_type);
-    if (instance == m_instances.end())
+    const size_t index = get_blockchain_index(blockchain_type);
+    if (index >= m_instances.size() || !m_instances[index])
     {
-        const auto& factory = m_factory_functions.find(blockchain_type);
-        if (factory == m_factory_functions.end())
-        {
-            THROW_EXCEPTION2(ERROR_INVALID_ARGUMENT,
-                    "Not supported blockchain type.")
-                    << " Requested type: " << blockchain_type;
-        }
-
-        BlockchainBasePtr new_instance{factory->second()};
-        const auto inserted = m_instances.emplace(blockchain_type,
-                std::move(new_instance));
-
-        INVARIANT2(inserted.second == true, blockchain_type);
-
-        instance = inserted.first;
+        THROW_EXCEPTION2(ERROR_INVALID_ARGUMENT,
+                "Not supported blockchain type.")
+                << " Requested type: " << blockchain_type;
     }
 
-    return *instance->second;
+    return *m_instances[index];
 }
 
 void BlockchainFacadeRegistry::register_blockchain(
         Blockchain blockchain_type,
-        BlockchainFacadeRegistry::FactoryFunction factory_function)
+        BlockchainBasePtr facade)
+{
+    const size_t index = get_blockchain_index(blockchain_type);
+    INVARIANT2(index < m_instances.size(), blockchain_type);
+    INVARIANT2(!m_instances[index], blockchain_type);
+
+    m_instances[index] = std::move(facade);
+}
+
+size_t BlockchainFacadeRegistry::get_blockchain_index(Blockchain blockchain_type)
 {
-    const auto registration_result = m_factory_functions.emplace(blockchain_type,
-            std::move(factory_function));
+    switch (blockchain_type)
+    {
+        case BLOCKCHAIN_BITCOIN:
+            return 0;
+        case BLOCKCHAIN_ETHEREUM:
+            return 1;
+        case BLOCKCHAIN_GOLOS:
+            return 2;
+        case BLOCKCHAIN_EOS:
+            return 3;
+    }
 
-    INVARIANT2(registration_result.second == true, blockchain_type);
+    return BLOCKCHAINS_COUNT;
 }
 
 } // namespace internal
@@ -12,9 +12,8 @@
 
 #include "multy_core/src/u_ptr.h"
 
-#include <functional>
+#include <array>
 #include <memory>
-#include <unordered_map>
 
 namespace multy_core
 {
@@ -68,31 +67,40 @@ BlockchainFacadeBase& get_blockchain(const T& object)
     return get_blockchain(object.get_blockchain_type());
 }
 
+/** Owns single facade instance for every supported blockchain.
+ *
+ * All facades (and the secp256k1 context they rely on) are created at once,
+ * when the registry is first accessed, that is guarded by C++11 thread-safe
+ * static initialization. After that the registry is never modified, so
+ * get_blockchain() is a lock-free array lookup that is safe to call
+ * from any number of threads.
+ */
 class BlockchainFacadeRegistry
 {
 public:
     static BlockchainFacadeRegistry& get_instance();
 
-    BlockchainFacadeBase& get_blockchain(Blockchain blockchain_type);
+    BlockchainFacadeBase& get_blockchain(Blockchain blockchain_type) const;
 
-    typedef std::function<BlockchainFacadeBase*()> FactoryFunction;
-    void register_blockchain(Blockchain blockchain_type,
-            FactoryFunction factory_function);
+private:
+    BlockchainFacadeRegistry();
+    ~BlockchainFacadeRegistry();
 
     template <typename T>
     void register_blockchain(Blockchain blockchain_type)
     {
-        register_blockchain(blockchain_type, []() { return new T; });
+        register_blockchain(blockchain_type, BlockchainBasePtr(new T));
     }
+    void register_blockchain(Blockchain blockchain_type,
+            BlockchainBasePtr facade);
 
-private:
-    BlockchainFacadeRegistry();
-    ~BlockchainFacadeRegistry();
+    // Index in m_instances, BLOCKCHAINS_COUNT if blockchain is not known.
+    static size_t get_blockchain_index(Blockchain blockchain_type);
 
 private:
-    // using Blockchain as a key
-    std::unordered_map<size_t, BlockchainBasePtr> m_instances;
-    std::unordered_map<size_t, FactoryFunction> m_factory_functions;
+    enum { BLOCKCHAINS_COUNT = 4 };
+    // Null for blockchains that are not compiled in.
+    std::array<BlockchainBasePtr, BLOCKCHAINS_COUNT> m_instances;
 };
 
 } // namespace internal
@@ -0,0 +1,78 @@
+/* Copyright 2018 by Multy.io
+ * Licensed under Multy.io license.
+ *
+ * See LICENSE for details
+ */
+
+#include "multy_core/src/cpu_features.h"
+
+#include <cstdint>
+
+#if MULTY_CORE_X86_SIMD
+#    include <cpuid.h>
+#endif
+
+namespace
+{
+using namespace multy_core::internal;
+
+#if MULTY_CORE_X86_SIMD
+uint64_t read_xcr0()
+{
+    uint32_t eax = 0;
+    uint32_t edx = 0;
+    __asm__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+}
+#endif // MULTY_CORE_X86_SIMD
+
+CpuFeatures detect_cpu_features()
+{
+    CpuFeatures result = {false, false, false};
+
+#if MULTY_CORE_X86_SIMD
+    const uint32_t ECX_SSSE3 = 1u << 9;
+    const uint32_t ECX_SSE4_1 = 1u << 19;
+    const uint32_t ECX_OSXSAVE = 1u << 27;
+    const uint32_t ECX_AVX = 1u << 28;
+    const uint32_t EBX_AVX2 = 1u << 5;
+    const uint32_t EBX_SHA = 1u << 29;
+    // XMM and YMM registers state is saved by OS.
+    const uint64_t XCR0_AVX_STATE = 0x6;
+
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    {
+        return result;
+    }
+    const bool ssse3 = (ecx & ECX_SSSE3) != 0;
+    result.sse4_1 = (ecx & ECX_SSE4_1) != 0;
+    const bool avx = (ecx & ECX_OSXSAVE) != 0 && (ecx & ECX_AVX) != 0
+            && (read_xcr0() & XCR0_AVX_STATE) == XCR0_AVX_STATE;
+
+    if (__get_cpuid_max(0, nullptr) >= 7)
+    {
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        result.avx2 = avx && (ebx & EBX_AVX2) != 0;
+        result.sha = ssse3 && result.sse4_1 && (ebx & EBX_SHA) != 0;
+    }
+#endif // MULTY_CORE_X86_SIMD
+
+    return result;
+}
+
+} // namespace
+
+namespace multy_core
+{
+namespace internal
+{
+
+const CpuFeatures& get_cpu_features()
+{
+    static const CpuFeatures features = detect_cpu_features();
+    return features;
+}
+
+} // namespace internal
+} // namespace multy_core
@@ -0,0 +1,37 @@
+/* Copyright 2018 by Multy.io
+ * Licensed under Multy.io license.
+ *
+ * See LICENSE for details
+ */
+
+#ifndef MULTY_CORE_SRC_CPU_FEATURES_H
+#define MULTY_CORE_SRC_CPU_FEATURES_H
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+// SIMD kernels are built with per-function target attributes,
+// which are only available on GCC and Clang.
+#    define MULTY_CORE_X86_SIMD 1
+#else
+#    define MULTY_CORE_X86_SIMD 0
+#endif
+
+namespace multy_core
+{
+namespace internal
+{
+
+// Instruction set extensions usable by SIMD code paths.
+struct CpuFeatures
+{
+    bool sse4_1;
+    bool avx2;
+    bool sha;
+};
+
+// Detected once on first call, all false on non-x86 platforms.
+const CpuFeatures& get_cpu_features();
+
+} // namespace internal
+} // namespace multy_core
+
+#endif // MULTY_CORE_SRC_CPU_FEATURES_H
@@ -11,11 +11,13 @@
 #include "multy_core/src/eos/eos_transaction_action.h"
 #include "multy_core/src/eos/eos_name.h"
 #include "multy_core/src/eos/eos_transaction.h"
-#include "multy_core/src/eos/eos_transaction.h"
+#include "multy_core/src/exception.h"
+#include "multy_core/src/exception_stream.h"
 
 
 #include "third-party/portable_endian.h"
 
+#include <algorithm>
 #include <array>
 
 namespace multy_core
@@ -23,12 +25,67 @@ namespace multy_core
 namespace internal
 {
 
-EosBinaryStream::EosBinaryStream()
+EosBinaryStream::~EosBinaryStream()
 {}
 
-EosBinaryStream::~EosBinaryStream()
+EosDataStream::EosDataStream()
+    : m_stream()
+{}
+
+EosDataStream::~EosDataStream()
+{}
+
+void EosDataStream::write_data(const uint8_t* data, size_t len)
+{
+    m_stream.write_data(data, len);
+}
+
+BinaryData EosDataStream::get_content() const
+{
+    return m_stream.get_content();
+}
+
+EosBufferStream::EosBufferStream(uint8_t* buffer, size_t capacity)
+    : m_buffer(buffer),
+      m_capacity(capacity),
+      m_size(0)
+{
+    INVARIANT(m_buffer != nullptr || m_capacity == 0);
+}
+
+void EosBufferStream::write_data(const uint8_t* data, size_t len)
+{
+    INVARIANT(data != nullptr);
+
+    if (len > m_capacity - m_size)
+    {
+        THROW_EXCEPTION2(ERROR_TRANSACTION_BUFFER_TOO_SMALL,
+                "Not enough space in buffer to serialize transaction.")
+                << " Capacity: " << m_capacity << " bytes.";
+    }
+    std::copy(data, data + len, m_buffer + m_size);
+    m_size += len;
+}
+
+size_t EosBufferStream::get_bytes_written() const
+{
+    return m_size;
+}
+
+EosBytesCountStream::EosBytesCountStream()
+    : m_bytes_count(0)
 {}
 
+void EosBytesCountStream::write_data(const uint8_t* /*data*/, size_t len)
+{
+    m_bytes_count += len;
+}
+
+size_t EosBytesCountStream::get_bytes_count() const
+{
+    return m_bytes_count;
+}
+
 template <typename T>
 EosBinaryStream& write_as_data(const T& data, EosBinaryStream& stream)
 {
@@ -21,11 +21,53 @@ class EosName;
 class EosAuthorization;
 typedef std::array<uint8_t, 32> EosChainId;
 
-class EosBinaryStream : public BinaryStream
+class EosBinaryStream
 {
 public:
-    EosBinaryStream();
-    ~EosBinaryStream();
+    virtual ~EosBinaryStream();
+
+    virtual void write_data(const uint8_t* data, size_t len) = 0;
+};
+
+class EosDataStream : public EosBinaryStream
+{
+public:
+    EosDataStream();
+    ~EosDataStream();
+
+    void write_data(const uint8_t* data, size_t len) override;
+    BinaryData get_content() const;
+
+private:
+    BinaryStream m_stream;
+};
+
+// Writes to a caller-owned buffer of fixed capacity, throws if data doesn't fit.
+class EosBufferStream : public EosBinaryStream
+{
+public:
+    EosBufferStream(uint8_t* buffer, size_t capacity);
+
+    void write_data(const uint8_t* data, size_t len) override;
+    size_t get_bytes_written() const;
+
+private:
+    uint8_t* const m_buffer;
+    const size_t m_capacity;
+    size_t m_size;
+};
+
+// Does no writing, only counting how many bytes would have been written.
+class EosBytesCountStream : public EosBinaryStream
+{
+public:
+    EosBytesCountStream();
+
+    void write_data(const uint8_t* data, size_t len) override;
+    size_t get_bytes_count() const;
+
+private:
+    size_t m_bytes_count;
 };
 
 EosBinaryStream& operator<<(EosBinaryStream& stream, const EosTransactionAction& op);
@@ -19,6 +19,7 @@
 #include "multy_core/src/eos/eos_transaction_builder_updateauth.h"
 
 #include <cstring>
+#include <unordered_map>
 
 namespace
 {
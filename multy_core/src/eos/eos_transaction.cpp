@@ -133,6 +133,11 @@ void EosTransaction::verify()
 
 void EosTransaction::update()
 {
+    if (is_up_to_date(CACHED_STEP_UPDATE))
+    {
+        return;
+    }
+
     if (m_external_actions.empty())
     {
         if (!m_source)
@@ -156,33 +161,91 @@ void EosTransaction::update()
     }
 
     sign();
+    set_up_to_date(CACHED_STEP_UPDATE);
 }
 
 void EosTransaction::sign()
 {
-    EosBinaryStream stream;
+    if (is_up_to_date(CACHED_STEP_SIGN))
+    {
+        return;
+    }
 
-    serialize_to_stream(stream, SERIALIZE_FOR_SIGN);
+    const BinaryDataPtr data = make_serialized(SERIALIZE_FOR_SIGN);
 
-    BinaryDataPtr signature = m_account.get_private_key()->sign(stream.get_content());
+    BinaryDataPtr signature = m_account.get_private_key()->sign(*data);
     m_signature.swap(signature);
-
+    set_up_to_date(CACHED_STEP_SIGN);
 }
 
 BinaryDataPtr EosTransaction::serialize()
+{
+    return make_clone(get_serialized());
+}
+
+const BinaryData& EosTransaction::get_serialized()
+{
+    update();
+
+    if (!is_up_to_date(CACHED_STEP_SERIALIZE))
+    {
+        m_serialized = make_serialized(SERIALIZE);
+        set_up_to_date(CACHED_STEP_SERIALIZE);
+    }
+
+    return *m_serialized;
+}
+
+size_t EosTransaction::get_serialized_size()
+{
+    update();
+
+    if (is_up_to_date(CACHED_STEP_SERIALIZE))
+    {
+        return m_serialized->len;
+    }
+
+    EosBytesCountStream counter;
+    serialize_to_stream(counter, SERIALIZE);
+
+    return counter.get_bytes_count();
+}
+
+size_t EosTransaction::serialize_into(uint8_t* buffer, size_t capacity)
 {
     update();
 
-    EosBinaryStream data_stream;
-    serialize_to_stream(data_stream, SERIALIZE);
+    if (is_up_to_date(CACHED_STEP_SERIALIZE))
+    {
+        return copy_serialized(*m_serialized, buffer, capacity);
+    }
+
+    EosBytesCountStream counter;
+    serialize_to_stream(counter, SERIALIZE);
+    check_buffer_capacity(counter.get_bytes_count(), capacity);
 
+    EosBufferStream stream(buffer, counter.get_bytes_count());
+    serialize_to_stream(stream, SERIALIZE);
 
-    return make_clone(data_stream.get_content());
+    return stream.get_bytes_written();
+}
+
+BinaryDataPtr EosTransaction::make_serialized(SerializationMode mode) const
+{
+    EosBytesCountStream counter;
+    serialize_to_stream(counter, mode);
+
+    BinaryDataPtr result = new_binary_data(counter.get_bytes_count());
+    EosBufferStream stream(const_cast<uint8_t*>(result->data), result->len);
+    serialize_to_stream(stream, mode);
+    INVARIANT(stream.get_bytes_written() == result->len);
+
+    return result;
 }
 
 std::string EosTransaction::encode_serialized()
 {
-    update();
+    const BinaryData& serialized = get_serialized();
 
     CharPtr out_str;
     THROW_IF_WALLY_ERROR(
@@ -193,13 +256,10 @@ std::string EosTransaction::encode_serialized()
     std::string sig_base58 = "SIG_K1_";
     sig_base58 += out_str.get();
 
-    EosBinaryStream data_stream;
-    serialize_to_stream(data_stream, SERIALIZE);
-
     std::string result = "{\"signatures\":[\"";
     result += sig_base58;
     result += "\"],\"packed_trx\":\"";
-    result += to_hex_string(data_stream.get_content());
+    result += to_hex_string(serialized);
     result += "\",\"compression\":\"none\",\"packed_context_free_data\":\"\"}";
 
     return result;
@@ -207,44 +267,41 @@ std::string EosTransaction::encode_serialized()
 
 void EosTransaction::serialize_to_stream(EosBinaryStream& stream, SerializationMode mode) const
 {
-    EosBinaryStream list;
     if (mode == SERIALIZE_FOR_SIGN)
     {
         if (m_account.get_blockchain_type().net_type == EOS_NET_TYPE_MAINNET)
         {
-            list << EOS_MAINNET_CHAIN_ID;
+            stream << EOS_MAINNET_CHAIN_ID;
         }
         else
         {
-             list << EOS_TESTNET_CHAIN_ID;
+             stream << EOS_TESTNET_CHAIN_ID;
         }
     }
 
-    list << static_cast<uint32_t>(m_expiration); // time as uint32_t
-    list << static_cast<uint16_t>(static_cast<uint32_t>(*m_ref_block_num));
+    stream << static_cast<uint32_t>(m_expiration); // time as uint32_t
+    stream << static_cast<uint16_t>(static_cast<uint32_t>(*m_ref_block_num));
     uint32_t ref_block_prefix;
     ref_block_prefix = static_cast<uint32_t>(m_ref_block_prefix.get_value().get_value_as_uint64());
-    list << ref_block_prefix;
-    list << static_cast<uint8_t>(0x00); // max_net_usage_words, we set zero byte
-    list << static_cast<uint8_t>(0x00); // max_cpu_usage_ms, we set zero byte
-    list << static_cast<uint8_t>(0x00); // delay_seconds, we set zero byte
-    list << static_cast<uint8_t>(0x00); // size array context_free_actions and context_free_actions
+    stream << ref_block_prefix;
+    stream << static_cast<uint8_t>(0x00); // max_net_usage_words, we set zero byte
+    stream << static_cast<uint8_t>(0x00); // max_cpu_usage_ms, we set zero byte
+    stream << static_cast<uint8_t>(0x00); // delay_seconds, we set zero byte
+    stream << static_cast<uint8_t>(0x00); // size array context_free_actions and context_free_actions
 
     const auto& actions = m_external_actions.empty() ? m_actions : m_external_actions;
-    list << static_cast<uint8_t>(actions.size());
+    stream << static_cast<uint8_t>(actions.size());
     for (const auto& action : actions)
     {
-        list << *action;
+        stream << *action;
     }
 
-    list << static_cast<uint8_t>(0x00);
+    stream << static_cast<uint8_t>(0x00);
 
     if (mode == SERIALIZE_FOR_SIGN)
     {
-        list << EOS_ZERO_SHA256; // SHA256 context_free_data
+        stream << EOS_ZERO_SHA256; // SHA256 context_free_data
     }
-
-    stream << list.get_content();
 }
 
 BigInt EosTransaction::get_total_fee() const
@@ -281,7 +338,7 @@ Properties& EosTransaction::add_source()
     m_source = EosTransactionSourcePtr(new EosTransactionSource(
             get_blockchain_type()));
 
-    return m_source->get_properties();
+    return track_properties(m_source->get_properties());
 }
 
 Properties& EosTransaction::add_destination()
@@ -295,7 +352,7 @@ Properties& EosTransaction::add_destination()
     m_destination = EosTransactionDestinationPtr(
             new EosTransactionDestination(get_blockchain_type()));
 
-    return m_destination->get_properties();
+    return track_properties(m_destination->get_properties());
 }
 
 Properties& EosTransaction::get_fee()
@@ -315,6 +372,7 @@ void EosTransaction::set_message(const BinaryData& payload)
     }
 
     m_message = make_clone(payload);
+    set_dirty();
 }
 
 void EosTransaction::set_action(EosTransactionActionPtr action)
@@ -322,6 +380,7 @@ void EosTransaction::set_action(EosTransactionActionPtr action)
     INVARIANT(action != nullptr);
 
     m_external_actions.emplace_back(std::move(action));
+    set_dirty();
 }
 
 } // namespace internal
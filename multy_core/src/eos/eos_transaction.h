@@ -43,6 +43,8 @@ public:
     void sign();
     void update() override;
     BinaryDataPtr serialize() override;
+    size_t get_serialized_size() override;
+    size_t serialize_into(uint8_t* buffer, size_t capacity) override;
     std::string encode_serialized() override;
     BigInt get_total_fee() const override;
     BigInt get_total_spent() const override;
@@ -64,6 +66,9 @@ private:
     void verify();
     void set_expiration(const std::string&);
     void serialize_to_stream(EosBinaryStream& stream, SerializationMode mode) const;
+    const BinaryData& get_serialized();
+    // Counts bytes first, then serializes into an exactly-sized buffer.
+    BinaryDataPtr make_serialized(SerializationMode mode) const;
 
 private:
     const Account& m_account;
@@ -82,6 +87,7 @@ private:
 
     std::time_t m_expiration;
     BinaryDataPtr m_signature;
+    BinaryDataPtr m_serialized;
 };
 
 } // namespace internal
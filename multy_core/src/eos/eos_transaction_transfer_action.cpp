@@ -52,7 +52,7 @@ void EosTransactionTransferAction::write_to_stream(EosBinaryStream* stream) cons
 
 BinaryDataPtr EosTransactionTransferAction::make_data() const
 {
-    EosBinaryStream data;
+    EosDataStream data;
     data << m_from;
     data << m_to;
     data << m_amount.get_value_as_uint64();
@@ -32,6 +32,7 @@ extern "C" {
 
 #include <string.h>
 #include <string>
+#include <vector>
 
 namespace
 {
@@ -75,21 +76,42 @@ private:
 
 typedef UPtr<EthereumPublicKey> EthereumPublicKeyPtr;
 
+EthereumPublicKey::KeyData make_public_key_data(const std::vector<uint8_t>& private_key_data)
+{
+    EthereumPublicKey::KeyData key_data(EC_PUBLIC_KEY_UNCOMPRESSED_LEN, 0);
+    BinaryData public_key_data = as_binary_data(key_data);
+
+    ec_private_to_public_key(as_binary_data(private_key_data),
+            EC_PUBLIC_KEY_UNCOMPRESSED,
+            &public_key_data);
+
+    if (key_data[0] != 0x04)
+    {
+        THROW_EXCEPTION2(ERROR_KEY_CORRUPT,
+                "Invalid uncompressed public key prefix.");
+    }
+    key_data.erase(key_data.begin());
+    return key_data;
+}
+
+EthereumAddress make_address(const BinaryData& key_data)
+{
+    const auto& address_hash = do_hash<KECCAK, 256>(key_data);
+
+    // Copy right 20 bytes (256/8 - 12 = 20)
+    return EthereumAddress(slice(address_hash, 12, address_hash.size() - 12));
+}
+
 struct EthereumPrivateKey : public PrivateKey
 {
     enum {KEY_SIZE = 32};
     typedef std::vector<uint8_t> KeyData;
 
     explicit EthereumPrivateKey(KeyData data)
-        : m_data(std::move(data))
+        : m_data(validate_private_key_data(std::move(data))),
+          m_public_key_data(make_public_key_data(m_data)),
+          m_address(make_address(as_binary_data(m_public_key_data)))
     {
-        if (m_data.size() != KEY_SIZE)
-        {
-            THROW_EXCEPTION2(ERROR_INVALID_ARGUMENT, "Invalid Ethereum private key size.")
-                    << " Expected: " << KEY_SIZE
-                    << " got: " << m_data.size();
-        }
-        ec_validate_private_key(as_binary_data(m_data));
     }
 
     explicit EthereumPrivateKey(BinaryData data)
@@ -97,6 +119,11 @@ struct EthereumPrivateKey : public PrivateKey
     {
     }
 
+    ~EthereumPrivateKey()
+    {
+        wally_bzero(m_data.data(), m_data.size());
+    }
+
     std::string to_string() const override
     {
         UPtr<char> out_str;
@@ -109,20 +136,7 @@ struct EthereumPrivateKey : public PrivateKey
 
     PublicKeyPtr make_public_key() const override
     {
-        EthereumPublicKey::KeyData key_data(EC_PUBLIC_KEY_UNCOMPRESSED_LEN, 0);
-        BinaryData public_key_data = as_binary_data(key_data);
-
-        ec_private_to_public_key(as_binary_data(m_data),
-                EC_PUBLIC_KEY_UNCOMPRESSED,
-                &public_key_data);
-
-        if (key_data[0] != 0x04)
-        {
-            THROW_EXCEPTION2(ERROR_KEY_CORRUPT,
-                    "Invalid uncompressed public key prefix.");
-        }
-        key_data.erase(key_data.begin());
-        return PublicKeyPtr(new EthereumPublicKey(std::move(key_data)));
+        return PublicKeyPtr(new EthereumPublicKey(m_public_key_data));
     }
 
     PrivateKeyPtr clone() const override
@@ -160,18 +174,33 @@ struct EthereumPrivateKey : public PrivateKey
         return m_data;
     }
 
+    const EthereumAddress& get_address() const
+    {
+        return m_address;
+    }
+
 private:
-    const KeyData m_data;
-};
+    static KeyData validate_private_key_data(KeyData data)
+    {
+        if (data.size() != KEY_SIZE)
+        {
+            THROW_EXCEPTION2(ERROR_INVALID_ARGUMENT, "Invalid Ethereum private key size.")
+                    << " Expected: " << KEY_SIZE
+                    << " got: " << data.size();
+        }
+        ec_validate_private_key(as_binary_data(data));
 
-EthereumAddress make_address(const EthereumPublicKey& key)
-{
-    const BinaryData key_data = key.get_content();
-    const auto& address_hash = do_hash<KECCAK, 256>(key_data);
+        return data;
+    }
 
-    // Copy right 20 bytes (256/8 - 12 = 20)
-    return EthereumAddress(slice(address_hash, 12, address_hash.size() - 12));
-}
+private:
+    KeyData m_data;
+    // Public key and address are derived only once, since that involves
+    // EC multiplication and Keccak hashing; private key data never changes
+    // after construction.
+    const EthereumPublicKey::KeyData m_public_key_data;
+    const EthereumAddress m_address;
+};
 
 typedef UPtr<EthereumPrivateKey> EthereumPrivateKeyPtr;
 typedef UPtr<EthereumPublicKey> EthereumPublicKeyPtr;
@@ -218,11 +247,7 @@ public:
 
     EthereumAddress get_ethereum_address() const override
     {
-        EthereumPublicKeyPtr public_key(
-                reinterpret_cast<EthereumPublicKey*>(
-                        m_private_key->make_public_key().release()));
-
-        return make_address(*public_key);
+        return m_private_key->get_address();
     }
 
 private:
@@ -286,6 +311,65 @@ AccountPtr EthereumHDAccount::make_account(
     return result;
 }
 
+std::string EthereumHDAccount::make_address_from_public_key(
+        const BinaryData& public_key) const
+{
+    std::array<uint8_t, EC_PUBLIC_KEY_UNCOMPRESSED_LEN> uncompressed_key;
+    THROW_IF_WALLY_ERROR2(
+            wally_ec_public_key_decompress(
+                    public_key.data, public_key.len,
+                    uncompressed_key.data(), uncompressed_key.size()),
+            ERROR_KEY_CORRUPT,
+            "Failed to decompress public key.");
+
+    // Skip the 0x04 prefix of uncompressed key.
+    return EthereumAddress::to_string(
+            make_address(power_slice(as_binary_data(uncompressed_key), 1, -1)));
+}
+
+void EthereumHDAccount::make_addresses_from_public_keys(
+        const BinaryData& public_keys, std::string* addresses) const
+{
+    // Uncompressed keys without the 0x04 prefix.
+    const size_t KEY_SIZE = EC_PUBLIC_KEY_UNCOMPRESSED_LEN - 1;
+    const size_t HASH_SIZE = 256 / 8;
+
+    INVARIANT(public_keys.len % EC_PUBLIC_KEY_LEN == 0);
+    INVARIANT(addresses != nullptr || public_keys.len == 0);
+
+    const size_t count = public_keys.len / EC_PUBLIC_KEY_LEN;
+    if (count == 0)
+    {
+        return;
+    }
+
+    std::vector<uint8_t> keys(count * KEY_SIZE);
+    std::array<uint8_t, EC_PUBLIC_KEY_UNCOMPRESSED_LEN> uncompressed_key;
+    for (size_t i = 0; i < count; ++i)
+    {
+        THROW_IF_WALLY_ERROR2(
+                wally_ec_public_key_decompress(
+                        public_keys.data + i * EC_PUBLIC_KEY_LEN, EC_PUBLIC_KEY_LEN,
+                        uncompressed_key.data(), uncompressed_key.size()),
+                ERROR_KEY_CORRUPT,
+                "Failed to decompress public key.");
+        std::copy(uncompressed_key.begin() + 1, uncompressed_key.end(),
+                keys.begin() + i * KEY_SIZE);
+    }
+
+    // Hashing all keys at once is faster than one by one.
+    std::vector<uint8_t> hashes(count * HASH_SIZE);
+    BinaryData hashes_data = as_binary_data(hashes);
+    hash_keccak_256_batch(as_binary_data(keys), KEY_SIZE, &hashes_data);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        // Right 20 bytes of the hash.
+        addresses[i] = EthereumAddress::to_string(EthereumAddress(
+                slice(hashes_data, i * HASH_SIZE + 12, HASH_SIZE - 12)));
+    }
+}
+
 EthereumAccountPtr make_ethereum_account(BlockchainType blockchain_type,
         const char* serialized_private_key)
 {
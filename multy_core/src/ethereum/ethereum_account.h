@@ -25,6 +25,10 @@ public:
 protected:
     AccountPtr make_account(
             const ExtendedKey& parent_key, AddressType type, uint32_t index) const override;
+    std::string make_address_from_public_key(
+            const BinaryData& public_key) const override;
+    void make_addresses_from_public_keys(
+            const BinaryData& public_keys, std::string* addresses) const override;
 };
 
 class EthereumAddress;
@@ -10,6 +10,7 @@
 
 #include "multy_core/src/exception_stream.h"
 #include "multy_core/src/hash.h"
+#include "multy_core/src/uint256.h"
 #include "multy_core/src/utility.h"
 #include "multy_core/binary_data.h"
 
@@ -95,13 +96,14 @@ EthereumPayloadAsUint256Stream& operator<<(EthereumPayloadAsUint256Stream& strea
 
 EthereumPayloadAsUint256Stream& operator<<(EthereumPayloadAsUint256Stream& stream, const BigInt& value)
 {
-    const BinaryDataPtr data = value.export_as_binary_data(BigInt::EXPORT_BIG_ENDIAN);
-    if (data->len > ETHEREUM_SIZE_VARIABLE_FUNCTION_CONTRACT)
-    {
-        THROW_EXCEPTION2(ERROR_BIG_INT_TOO_BIG_FOR_UINT256,
-                "BigInt value is too big for Ethereum smart contract method call.");
-    }
-    stream << *data;
+    return stream << Uint256(value);
+}
+
+EthereumPayloadAsUint256Stream& operator<<(EthereumPayloadAsUint256Stream& stream, const Uint256& value)
+{
+    std::array<uint8_t, ETHEREUM_SIZE_VARIABLE_FUNCTION_CONTRACT> word;
+    value.write_big_endian(word.data(), word.size());
+    stream.write_data(word.data(), word.size());
 
     return stream;
 }
@@ -17,6 +17,7 @@ namespace multy_core
 namespace internal
 {
 class EthereumAddress;
+class Uint256;
 
 const size_t ETH_METHOD_HASH_SIZE = 4;
 typedef std::array<uint8_t, ETH_METHOD_HASH_SIZE> EthereumContractMethodHash;
@@ -48,6 +49,7 @@ protected:
 EthereumPayloadDataStream& operator<<(EthereumPayloadDataStream& stream, const EthereumContractMethodHash& value);
 EthereumPayloadDataStream& operator<<(EthereumPayloadDataStream& stream, const EthereumPayloadAsUint256Stream& value);
 EthereumPayloadAsUint256Stream& operator<<(EthereumPayloadAsUint256Stream& stream, const BigInt& value);
+EthereumPayloadAsUint256Stream& operator<<(EthereumPayloadAsUint256Stream& stream, const Uint256& value);
 EthereumPayloadAsUint256Stream& operator<<(EthereumPayloadAsUint256Stream& stream, const BinaryData& value);
 EthereumPayloadAsUint256Stream& operator<<(EthereumPayloadAsUint256Stream& stream, const EthereumAddress& value);
 
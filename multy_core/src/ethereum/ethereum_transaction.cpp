@@ -10,8 +10,11 @@
 #include "multy_core/src/exception_stream.h"
 #include "multy_core/src/api/key_impl.h"
 #include "multy_core/src/binary_data_utility.h"
+#include "multy_core/src/uint256.h"
 #include "multy_core/src/utility.h"
 
+#include <cstring>
+
 namespace
 {
 using namespace multy_core::internal;
@@ -43,7 +46,7 @@ IntWrapper<uint8_t> as_uint8(const T& value)
     return IntWrapper<uint8_t>(value, 1);
 }
 
-IntWrapper<uint8_t> as_uint8(const BigInt& value)
+IntWrapper<uint8_t> as_uint8(const Uint256& value)
 {
     return IntWrapper<uint8_t>(value.get_value_as_uint64(), 1);
 }
@@ -61,44 +64,72 @@ namespace multy_core
 namespace internal
 {
 
-size_t get_bytes_len(const BigInt& value)
+size_t get_bytes_len(const Uint256& value)
 {
-    return value.get_exported_size_in_bytes();
+    return value.get_bytes_len();
 }
 
 struct EthereumDataStream
 {
-    EthereumDataStream()
-        : m_data()
+    virtual ~EthereumDataStream()
+    {}
+
+    virtual void write_data(const void* data, size_t size) = 0;
+};
+
+// Writes to a caller-owned buffer of fixed capacity, throws if data doesn't fit.
+struct EthereumBufferStream : public EthereumDataStream
+{
+    EthereumBufferStream(uint8_t* buffer, size_t capacity)
+        : m_buffer(buffer),
+          m_capacity(capacity),
+          m_size(0)
     {
-        m_data.reserve(256);
+        INVARIANT(m_buffer != nullptr);
     }
 
-    void write_data(const void* data, size_t size)
+    void write_data(const void* data, size_t size) override
     {
-        const uint8_t* d = reinterpret_cast<const uint8_t*>(data);
-        m_data.insert(m_data.end(), d, d + size);
+        if (size > m_capacity - m_size)
+        {
+            THROW_EXCEPTION2(ERROR_TRANSACTION_BUFFER_TOO_SMALL,
+                    "Not enough space in buffer to serialize transaction.")
+                    << " Capacity: " << m_capacity << " bytes.";
+        }
+        memcpy(m_buffer + m_size, data, size);
+        m_size += size;
     }
 
-    BinaryData get_content()
+    size_t get_bytes_written() const
     {
-        return BinaryData{m_data.data(), m_data.size()};
+        return m_size;
     }
 
-protected:
-    std::vector<std::uint8_t> m_data;
+private:
+    uint8_t* const m_buffer;
+    const size_t m_capacity;
+    size_t m_size;
 };
 
-struct EthereumDataStreamList : public EthereumDataStream
+// Does no writing, only counting how many bytes would have been written.
+struct EthereumBytesCountStream : public EthereumDataStream
 {
-    size_t length() const
+    EthereumBytesCountStream()
+        : m_bytes_count(0)
+    {}
+
+    void write_data(const void* /*data*/, size_t size) override
     {
-        return m_data.size();
+        m_bytes_count += size;
     }
-    const std::uint8_t* data() const
+
+    size_t get_bytes_count() const
     {
-        return m_data.data();
+        return m_bytes_count;
     }
+
+private:
+    size_t m_bytes_count;
 };
 
 template <typename T>
@@ -143,21 +174,12 @@ EthereumDataStream& operator<<(EthereumDataStream& stream, const IntWrapper<uint
 //    return stream;
 //}
 
-EthereumDataStream& operator<<(EthereumDataStream& stream, const IntWrapper<BigInt>& wrapper)
+EthereumDataStream& operator<<(EthereumDataStream& stream, const IntWrapper<Uint256>& wrapper)
 {
-    const BinaryDataPtr data = wrapper.value.export_as_binary_data(BigInt::EXPORT_BIG_ENDIAN);
-    if (wrapper.size > data->len)
-    {
-        THROW_EXCEPTION("Can't serialize BigInt as fixed-size blob.")
-                << " Required size: " << wrapper.size
-                << " available size: " << data->len;
-    }
+    std::array<uint8_t, Uint256::SIZE_IN_BYTES> buffer;
+    wrapper.value.write_big_endian(buffer.data(), wrapper.size);
 
-    const size_t offset = data->len - wrapper.size;
-    const size_t size = data->len - offset;
-    const BinaryData to_write = slice(*data, offset, size);
-
-    stream.write_data(to_write.data, to_write.len);
+    stream.write_data(buffer.data(), wrapper.size);
     return stream;
 }
 
@@ -169,19 +191,14 @@ std::string to_string(const T& t)
     return sstr.str();
 }
 
-std::string to_string(const BigInt& amount)
-{
-    return amount.get_value();
-}
-
 template <typename T>
 void write_int(const T& value, EthereumDataStream* stream)
 {
-    if (value == 0)
+    if (value == T(0))
     {
         *stream << as_uint8(RLP_DATA_IMM_LEN_START);
     }
-    else if (value < RLP_DATA_IMM_LEN_START)
+    else if (value < T(RLP_DATA_IMM_LEN_START))
     {
         *stream << as_uint8(value);
     }
@@ -200,15 +217,15 @@ void write_int(const T& value, EthereumDataStream* stream)
                 THROW_EXCEPTION("Number is too big for RLP") << to_string(value);
             }
             *stream << as_uint8(RLP_DATA_IND_LEN_ZERO + len_of_len);
-            *stream << as_int(BigInt(static_cast<uint64_t>(len)), len_of_len);
+            *stream << as_int(Uint256(static_cast<uint64_t>(len)), len_of_len);
         }
-        *stream << as_int(BigInt(value), len);
+        *stream << as_int(Uint256(value), len);
     }
 }
 
 EthereumDataStream& operator<<(EthereumDataStream& stream, const BigInt& data)
 {
-    write_int(data, &stream);
+    write_int(Uint256(data), &stream);
     return stream;
 }
 
@@ -250,21 +267,19 @@ EthereumDataStream& operator<<(EthereumDataStream& stream, const BinaryData& bin
             }
 
             stream << as_uint8(RLP_DATA_IND_LEN_ZERO + length_size);
-            stream << as_int(BigInt(static_cast<uint64_t>(len)), length_size);
+            stream << as_int(Uint256(static_cast<uint64_t>(len)), length_size);
         }
         stream.write_data(data, len);
     }
     return stream;
 }
 
-EthereumDataStream& operator<<(EthereumDataStream& stream, const EthereumDataStreamList& list)
+// Writes RLP list prefix, list items of total length len must follow.
+void write_list_prefix(size_t len, EthereumDataStream* stream)
 {
-    const size_t len = list.length();
-    const unsigned char* data = list.data();
-
     if (len < RLP_LIST_IMM_LEN_COUNT)
     {
-        stream << as_uint8(len + RLP_LIST_IMM_LEN_START);
+        *stream << as_uint8(len + RLP_LIST_IMM_LEN_START);
     }
     else
     {
@@ -275,12 +290,9 @@ EthereumDataStream& operator<<(EthereumDataStream& stream, const EthereumDataStr
                     << " Length: " << len;
         }
 
-        stream << as_uint8(RLP_LIST_IND_LEN_ZERO + length_size);
-        stream << as_int(BigInt(static_cast<uint64_t>(len)), length_size);
+        *stream << as_uint8(RLP_LIST_IND_LEN_ZERO + length_size);
+        *stream << as_int(Uint256(static_cast<uint64_t>(len)), length_size);
     }
-
-    stream.write_data(data, len);
-    return stream;
 }
 
 struct EthereumTransactionSignature
@@ -333,8 +345,10 @@ EthereumTransaction::EthereumTransaction(const Account& account)
       m_fee(new EthereumTransactionFee),
       m_source(),
       m_destination(),
-      m_signature()
+      m_signature(),
+      m_serialized()
 {
+    track_properties(m_fee->get_properties());
 }
 
 EthereumTransaction::~EthereumTransaction()
@@ -346,27 +360,96 @@ BinaryDataPtr EthereumTransaction::serialize()
     update();
     sign();
 
-    EthereumDataStream data_stream;
-    serialize_to_stream(data_stream, SERIALIZE_WITH_SIGNATURE);
+    if (!is_up_to_date(CACHED_STEP_SERIALIZE))
+    {
+        m_serialized = serialize_rlp(SERIALIZE_WITH_SIGNATURE);
+        set_up_to_date(CACHED_STEP_SERIALIZE);
+    }
+
+    return make_clone(*m_serialized);
+}
+
+size_t EthereumTransaction::get_serialized_size()
+{
+    update();
+    sign();
+
+    if (is_up_to_date(CACHED_STEP_SERIALIZE))
+    {
+        return m_serialized->len;
+    }
+
+    size_t items_size = 0;
+    return get_rlp_size(SERIALIZE_WITH_SIGNATURE, &items_size);
+}
+
+size_t EthereumTransaction::serialize_into(uint8_t* buffer, size_t capacity)
+{
+    update();
+    sign();
+
+    if (is_up_to_date(CACHED_STEP_SERIALIZE))
+    {
+        return copy_serialized(*m_serialized, buffer, capacity);
+    }
+
+    size_t items_size = 0;
+    const size_t size = get_rlp_size(SERIALIZE_WITH_SIGNATURE, &items_size);
+    check_buffer_capacity(size, capacity);
+    write_rlp(SERIALIZE_WITH_SIGNATURE, items_size, buffer, size);
+
+    return size;
+}
+
+BinaryDataPtr EthereumTransaction::serialize_rlp(SerializationMode mode) const
+{
+    size_t items_size = 0;
+    BinaryDataPtr result = new_binary_data(get_rlp_size(mode, &items_size));
+    write_rlp(mode, items_size, const_cast<uint8_t*>(result->data), result->len);
+
+    return result;
+}
+
+size_t EthereumTransaction::get_rlp_size(SerializationMode mode, size_t* items_size) const
+{
+    INVARIANT(items_size != nullptr);
+
+    // RLP list prefix depends on the length of the items, so those are
+    // counted first and then written once into an exactly-sized buffer.
+    EthereumBytesCountStream items_counter;
+    serialize_list_items(&items_counter, mode);
+    *items_size = items_counter.get_bytes_count();
+
+    EthereumBytesCountStream prefix_counter;
+    write_list_prefix(*items_size, &prefix_counter);
+
+    return prefix_counter.get_bytes_count() + *items_size;
+}
 
-    return make_clone(data_stream.get_content());
+void EthereumTransaction::write_rlp(SerializationMode mode, size_t items_size,
+        uint8_t* buffer, size_t size) const
+{
+    EthereumBufferStream stream(buffer, size);
+    write_list_prefix(items_size, &stream);
+    serialize_list_items(&stream, mode);
+    INVARIANT(stream.get_bytes_written() == size);
 }
 
-void EthereumTransaction::serialize_to_stream(EthereumDataStream& stream, SerializationMode mode) const
+void EthereumTransaction::serialize_list_items(EthereumDataStream* stream,
+        SerializationMode mode) const
 {
-    EthereumDataStreamList list;
-    list << m_nonce;
-    list << m_fee->gas_price;
-    list << m_fee->gas_limit;
-    list << m_destination->address;
-    list << m_destination->amount;
+    *stream << m_nonce;
+    *stream << m_fee->gas_price;
+    *stream << m_fee->gas_limit;
+    *stream << m_destination->address;
+    *stream << m_destination->amount;
     if(*m_payload && ((*m_payload)->data != nullptr))
     {
-        list << m_payload;
+        *stream << m_payload;
     }
     else
     {
-        list << BinaryData{nullptr, 0};
+        *stream << BinaryData{nullptr, 0};
     }
 
     if (mode == SERIALIZE_WITH_SIGNATURE)
@@ -374,13 +457,12 @@ void EthereumTransaction::serialize_to_stream(EthereumDataStream& stream, Serial
         INVARIANT(m_signature != nullptr);
 
         const uint32_t offset = m_chain_id*2 + 35;
-        m_signature->write_to_stream(offset, &list);
+        m_signature->write_to_stream(offset, stream);
     }
     else if (mode == SERIALIZE_WITH_CHAIN_ID)
     {
-        list << static_cast<uint32_t>(m_chain_id) << 0u << 0u;
+        *stream << static_cast<uint32_t>(m_chain_id) << 0u << 0u;
     }
-    stream << list;
 }
 
 BigInt EthereumTransaction::get_total_spent() const
@@ -419,28 +501,39 @@ void EthereumTransaction::verify()
 
 void EthereumTransaction::update()
 {
+    if (is_up_to_date(CACHED_STEP_UPDATE))
+    {
+        return;
+    }
+
     verify();
 
-    BigInt diff = m_source->amount.get_value() - m_destination->amount.get_value();
-    m_fee->total_fee = *m_fee->gas_limit * *m_fee->gas_price;
+    const Uint256 total_fee = Uint256(*m_fee->gas_limit) * Uint256(*m_fee->gas_price);
+    m_fee->total_fee = total_fee.to_big_int();
 
-    diff -= m_fee->total_fee;
-    if (diff < 0)
+    const Uint256 available(*m_source->amount);
+    const Uint256 amount(*m_destination->amount);
+    if (available < amount || available - amount < total_fee)
     {
         THROW_EXCEPTION2(ERROR_TRANSACTION_INSUFFICIENT_FUNDS,
                 "Transaction is trying to spend more than available.");
     }
+    set_up_to_date(CACHED_STEP_UPDATE);
 }
 
 void EthereumTransaction::sign()
 {
-    EthereumDataStream data_stream;
-    serialize_to_stream(data_stream,
+    if (is_up_to_date(CACHED_STEP_SIGN))
+    {
+        return;
+    }
+
+    const BinaryDataPtr data = serialize_rlp(
             m_chain_id > 0 ? SERIALIZE_WITH_CHAIN_ID : SERIALIZE);
 
     m_signature.reset(new EthereumTransactionSignature);
-    m_signature->set_signature(m_account.get_private_key()->sign(
-            data_stream.get_content()));
+    m_signature->set_signature(m_account.get_private_key()->sign(*data));
+    set_up_to_date(CACHED_STEP_SIGN);
 }
 
 BigInt EthereumTransaction::estimate_total_fee(size_t, size_t) const
@@ -37,6 +37,8 @@ public:
     virtual ~EthereumTransaction();
 
     BinaryDataPtr serialize() override;
+    size_t get_serialized_size() override;
+    size_t serialize_into(uint8_t* buffer, size_t capacity) override;
     BigInt get_total_spent() const override;
     BigInt get_total_fee() const override;
 
@@ -57,7 +59,14 @@ private:
         SERIALIZE_WITH_SIGNATURE,
         SERIALIZE_WITH_CHAIN_ID,
     };
-    void serialize_to_stream(EthereumDataStream& stream, SerializationMode mode) const;
+    // Encodes transaction as RLP list in a single exactly-sized buffer.
+    BinaryDataPtr serialize_rlp(SerializationMode mode) const;
+    // Size of the whole RLP list, and of its items alone.
+    size_t get_rlp_size(SerializationMode mode, size_t* items_size) const;
+    // Writes RLP list of exactly size bytes, as counted by get_rlp_size().
+    void write_rlp(SerializationMode mode, size_t items_size,
+            uint8_t* buffer, size_t size) const;
+    void serialize_list_items(EthereumDataStream* stream, SerializationMode mode) const;
 
 private:
     const Account& m_account;
@@ -70,6 +79,7 @@ private:
     EthereumTransactionSourcePtr m_source;
     EthereumTransactionDestinationPtr m_destination;
     EthereumTransactionSignaturePtr m_signature;
+    BinaryDataPtr m_serialized;
 //    BinaryDataPtr m_payload;
 };
 
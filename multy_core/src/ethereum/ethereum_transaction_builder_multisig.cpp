@@ -20,6 +20,7 @@
 #include "multy_core/src/exception.h"
 #include "multy_core/src/exception_stream.h"
 #include "multy_core/src/property_predicates.h"
+#include "multy_core/src/uint256.h"
 #include "multy_core/src/utility.h"
 #include "multy_core/transaction.h"
 
@@ -123,9 +124,9 @@ public:
         EthereumPayloadAsUint256Stream variables;
         const static EthereumContractMethodHash method({0xf8, 0xf7, 0x38, 0x08});
         result << method;
-        variables << BigInt{ETHEREUM_SIZE_VARIABLE_FUNCTION_CONTRACT * 2}; // That is offset to the array of owners
+        variables << Uint256(ETHEREUM_SIZE_VARIABLE_FUNCTION_CONTRACT * 2); // That is offset to the array of owners
         variables << BigInt{*m_confirmations};
-        variables << BigInt(static_cast<uint64_t>(m_owners.get_value().size()));
+        variables << Uint256(static_cast<uint64_t>(m_owners.get_value().size()));
         for (size_t i = 0; i < m_owners.get_value().size(); i++)
         {
             variables << m_owners.get_value()[i];
@@ -241,8 +242,8 @@ public:
         result << method;
         variables << *m_dest_address;
         variables << *m_amount;
-        variables << BigInt{ETHEREUM_SIZE_VARIABLE_FUNCTION_CONTRACT * 3}; // That is offset to the bytes array
-        variables << BigInt{0}; // zero data
+        variables << Uint256(ETHEREUM_SIZE_VARIABLE_FUNCTION_CONTRACT * 3); // That is offset to the bytes array
+        variables << Uint256(); // zero data
         result << variables;
 
         return make_clone(result.get_content());
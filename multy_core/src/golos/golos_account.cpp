@@ -127,24 +127,23 @@ class GolosPrivateKey : public PrivateKey
 public:
     typedef std::vector<uint8_t> KeyData;
     explicit GolosPrivateKey(const KeyData& data)
-        : m_data(data)
+        : m_data(data),
+          m_public_key_data(make_public_key_data(m_data))
     {}
 
     explicit GolosPrivateKey(const BinaryData& data)
-        : m_data(data.data, data.data + data.len)
+        : m_data(data.data, data.data + data.len),
+          m_public_key_data(make_public_key_data(m_data))
     {}
 
-    PublicKeyPtr make_public_key() const override
+    ~GolosPrivateKey()
     {
-        const size_t public_key_size = EC_PUBLIC_KEY_LEN;
-        GolosPublicKey::KeyData key_data(public_key_size, 0);
-        BinaryData public_key_data = as_binary_data(key_data);
-
-        ec_private_to_public_key(as_binary_data(m_data),
-                EC_PUBLIC_KEY_COMPRESSED,
-                &public_key_data);
+        wally_bzero(m_data.data(), m_data.size());
+    }
 
-        return PublicKeyPtr(new GolosPublicKey(std::move(key_data)));
+    PublicKeyPtr make_public_key() const override
+    {
+        return PublicKeyPtr(new GolosPublicKey(m_public_key_data));
     }
 
     PrivateKeyPtr clone() const override
@@ -198,8 +197,23 @@ public:
         return std::string(out_str.get());
     }
 
+private:
+    static GolosPublicKey::KeyData make_public_key_data(const KeyData& private_key_data)
+    {
+        GolosPublicKey::KeyData key_data(EC_PUBLIC_KEY_LEN, 0);
+        BinaryData public_key_data = as_binary_data(key_data);
+
+        ec_private_to_public_key(as_binary_data(private_key_data),
+                EC_PUBLIC_KEY_COMPRESSED,
+                &public_key_data);
+
+        return key_data;
+    }
+
 private:
     KeyData m_data;
+    // Derived once, since that is an EC multiplication.
+    GolosPublicKey::KeyData m_public_key_data;
 };
 
 GolosHDAccount::GolosHDAccount(
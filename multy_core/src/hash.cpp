@@ -6,25 +6,57 @@
 
 #include "multy_core/src/hash.h"
 
-#include "multy_core/src/api/sha3_impl.h"
 #include "multy_core/src/exception.h"
 #include "multy_core/src/exception_stream.h"
+#include "multy_core/src/keccak.h"
+#include "multy_core/src/sha256_batch.h"
 #include "multy_core/src/utility.h"
 
 extern "C" {
 #include "ccan/ccan/crypto/ripemd160/ripemd160.h"
+#include "ccan/ccan/crypto/sha256/sha256.h"
+#include "ccan/ccan/crypto/sha512/sha512.h"
+#include "libwally-core/src/internal.h"
 } // extern "C"
 
 #include "wally_crypto.h"
 
 #include <array>
 #include <initializer_list>
+#include <vector>
 #include <string.h>
 
 namespace
 {
 using namespace multy_core::internal;
 
+unsigned char* get_output_data(BinaryData* output, size_t hash_byte_size)
+{
+    INVARIANT(output != nullptr);
+    INVARIANT(output->data != nullptr);
+    INVARIANT(output->len >= hash_byte_size);
+
+    return const_cast<unsigned char*>(output->data);
+}
+
+size_t get_batch_size(const BinaryData& inputs, size_t message_size)
+{
+    INVARIANT(message_size != 0);
+    INVARIANT(inputs.data != nullptr || inputs.len == 0);
+    INVARIANT(inputs.len % message_size == 0);
+
+    return inputs.len / message_size;
+}
+
+void do_keccak_hash(size_t hash_bit_size, uint8_t delimiter,
+        const BinaryData& input, BinaryData* output)
+{
+    INVARIANT(input.data != nullptr);
+
+    keccak_hash(hash_bit_size, delimiter, input.data, input.len,
+            get_output_data(output, hash_bit_size / 8));
+}
+
 class HasherBase : public Hasher
 {
 public:
@@ -48,7 +80,26 @@ public:
         do_hash(input, output);
     }
 
+    void update(const BinaryData& input) override final
+    {
+        INVARIANT(input.data != nullptr || input.len == 0);
+
+        do_update(input);
+    }
+
+    void finalize(BinaryData* output) override final
+    {
+        INVARIANT(output);
+        INVARIANT(output->len * 8 >= m_hash_bit_size);
+
+        do_finalize(output);
+        reset();
+    }
+
     virtual void do_hash(const BinaryData& input, BinaryData* output) const = 0;
+    virtual void do_update(const BinaryData& input) = 0;
+    virtual void do_finalize(BinaryData* output) = 0;
+    virtual void reset() = 0;
 
     ~HasherBase() {}
 
@@ -57,67 +108,145 @@ public:
 
 class Sha2Hasher : public HasherBase
 {
-    typedef int (*HashFunction)(const unsigned char *, size_t, unsigned char *, size_t);
-
 public:
     Sha2Hasher(size_t hash_bit_size)
-        : HasherBase("SHA2", hash_bit_size, {256, 512})
-    {}
+        : HasherBase("SHA2", hash_bit_size, {256, 512}),
+          m_sha256_ctx(),
+          m_sha512_ctx()
+    {
+        reset();
+    }
 
-    void do_hash(const BinaryData& input, BinaryData* output) const override
+    ~Sha2Hasher()
     {
+        wally_clear_2(&m_sha256_ctx, sizeof(m_sha256_ctx),
+                &m_sha512_ctx, sizeof(m_sha512_ctx));
+    }
 
+    void do_hash(const BinaryData& input, BinaryData* output) const override
+    {
+        if (m_hash_bit_size == 256)
+        {
+            hash_sha2_256(input, output);
+        }
+        else
+        {
+            hash_sha2_512(input, output);
+        }
+    }
 
-        const HashFunction hash_function = get_hash_function(m_hash_bit_size);
-        INVARIANT(hash_function != nullptr);
+    void do_update(const BinaryData& input) override
+    {
+        if (m_hash_bit_size == 256)
+        {
+            sha256_update(&m_sha256_ctx, input.data, input.len);
+        }
+        else
+        {
+            sha512_update(&m_sha512_ctx, input.data, input.len);
+        }
+    }
 
-        THROW_IF_WALLY_ERROR(
-                hash_function(input.data, input.len,
-                        const_cast<unsigned char*>(output->data), output->len),
-                "Failed to sha2-256 the input.");
+    void do_finalize(BinaryData* output) override
+    {
+        unsigned char* out = const_cast<unsigned char*>(output->data);
+        if (m_hash_bit_size == 256)
+        {
+            struct sha256 sha;
+            sha256_done(&m_sha256_ctx, &sha);
+            memcpy(out, &sha, sizeof(sha));
+            wally_clear(&sha, sizeof(sha));
+        }
+        else
+        {
+            struct sha512 sha;
+            sha512_done(&m_sha512_ctx, &sha);
+            memcpy(out, &sha, sizeof(sha));
+            wally_clear(&sha, sizeof(sha));
+        }
     }
 
-    static HashFunction get_hash_function(size_t size)
+    void reset() override
     {
-        switch (size)
+        if (m_hash_bit_size == 256)
         {
-            case 256:
-                return &wally_sha256;
-            case 512:
-                return &wally_sha512;
-            default:
-                THROW_EXCEPTION("Can't do a sha-2 with requested hash size, "
-                        "only 256 and 512 are supported.")
-                        << " Requested hash size in bytes: " << size;
+            sha256_init(&m_sha256_ctx);
+        }
+        else
+        {
+            sha512_init(&m_sha512_ctx);
         }
     }
+
+private:
+    struct sha256_ctx m_sha256_ctx;
+    struct sha512_ctx m_sha512_ctx;
 };
 
-class KeccakHasher : public HasherBase
+class KeccakSpongeHasher : public HasherBase
 {
 public:
-    KeccakHasher(size_t hash_bit_size)
-        : HasherBase("Keccak", hash_bit_size, {256})
+    KeccakSpongeHasher(const char* name, size_t hash_bit_size,
+            std::initializer_list<size_t> const& supported_sizes,
+            uint8_t delimiter)
+        : HasherBase(name, hash_bit_size, supported_sizes),
+          m_sponge(hash_bit_size, delimiter)
     {}
 
-    using HasherBase::HasherBase;
+    void do_update(const BinaryData& input) override
+    {
+        m_sponge.absorb(input.data, input.len);
+    }
+
+    void do_finalize(BinaryData* output) override
+    {
+        m_sponge.squeeze(const_cast<unsigned char*>(output->data), m_hash_bit_size / 8);
+    }
+
+    void reset() override
+    {
+        m_sponge.reset();
+    }
+
+private:
+    KeccakSponge m_sponge;
+};
+
+class KeccakHasher : public KeccakSpongeHasher
+{
+public:
+    KeccakHasher(size_t hash_bit_size)
+        : KeccakSpongeHasher("Keccak", hash_bit_size, {256},
+                KeccakSponge::KECCAK_DELIMITER)
+    {}
 
     void do_hash(const BinaryData& input, BinaryData* output) const override
     {
-        keccak_256(input, output);
+        hash_keccak_256(input, output);
     }
 };
 
-class Sha3Hasher : public HasherBase
+class Sha3Hasher : public KeccakSpongeHasher
 {
 public:
     Sha3Hasher(size_t hash_bit_size)
-        : HasherBase("SHA3", hash_bit_size, {224, 256, 384, 512})
+        : KeccakSpongeHasher("SHA3", hash_bit_size, {224, 256, 384, 512},
+                KeccakSponge::SHA3_DELIMITER)
     {}
 
     void do_hash(const BinaryData& input, BinaryData* output) const override
     {
-        sha3(m_hash_bit_size, input, output);
+        switch (m_hash_bit_size)
+        {
+            case 224:
+                return hash_sha3_224(input, output);
+            case 256:
+                return hash_sha3_256(input, output);
+            case 384:
+                return hash_sha3_384(input, output);
+            default:
+                return hash_sha3_512(input, output);
+        }
     }
 };
 
@@ -125,38 +254,94 @@ class RipemdHasher : public HasherBase
 {
 public:
     explicit RipemdHasher(size_t hash_bit_size)
-        : HasherBase("RIPEMD", hash_bit_size, {160})
-    {}
+        : HasherBase("RIPEMD", hash_bit_size, {160}),
+          m_ctx()
+    {
+        reset();
+    }
+
+    ~RipemdHasher()
+    {
+        wally_clear(&m_ctx, sizeof(m_ctx));
+    }
 
     void do_hash(const BinaryData& input, BinaryData* output) const override
+    {
+        hash_ripemd_160(input, output);
+    }
+
+    void do_update(const BinaryData& input) override
+    {
+        ripemd160_update(&m_ctx, input.data, input.len);
+    }
+
+    void do_finalize(BinaryData* output) override
     {
         struct ripemd160 ripemd;
-        ripemd160(&ripemd, input.data, input.len);
+        ripemd160_done(&m_ctx, &ripemd);
         memcpy(const_cast<unsigned char*>(output->data), &ripemd, sizeof(ripemd));
     }
+
+    void reset() override
+    {
+        ripemd160_init(&m_ctx);
+    }
+
+private:
+    struct ripemd160_ctx m_ctx;
 };
 
+// RIPEMD-160(SHA2-256(data)), only the SHA2 part is progressive,
+// since RIPEMD input is known only on finalization.
 class BitcoinHasher : public HasherBase
 {
 public:
     explicit BitcoinHasher(size_t hash_bit_size)
-        : HasherBase("BitcoinHash", hash_bit_size, {160})
-    {}
+        : HasherBase("BitcoinHash", hash_bit_size, {160}),
+          m_ctx()
+    {
+        reset();
+    }
+
+    ~BitcoinHasher()
+    {
+        wally_clear(&m_ctx, sizeof(m_ctx));
+    }
 
     void do_hash(const BinaryData& input, BinaryData* output) const override
     {
-        THROW_IF_WALLY_ERROR(
-                wally_hash160(
-                        input.data, input.len,
-                        const_cast<unsigned char*>(output->data), output->len),
-                "Failed to do BitcoinHash160.");
+        hash_bitcoin_160(input, output);
+    }
+
+    void do_update(const BinaryData& input) override
+    {
+        sha256_update(&m_ctx, input.data, input.len);
+    }
+
+    void do_finalize(BinaryData* output) override
+    {
+        struct sha256 sha;
+        sha256_done(&m_ctx, &sha);
+
+        struct ripemd160 ripemd;
+        ripemd160(&ripemd, &sha, sizeof(sha));
+        memcpy(const_cast<unsigned char*>(output->data), &ripemd, sizeof(ripemd));
+        wally_clear(&sha, sizeof(sha));
     }
+
+    void reset() override
+    {
+        sha256_init(&m_ctx);
+    }
+
+private:
+    struct sha256_ctx m_ctx;
 };
 
 template <typename HasherT>
 class DoubleHasher : public Hasher
 {
-    const HasherT m_hasher;
+    HasherT m_hasher;
 
 public:
     explicit DoubleHasher(size_t hash_bit_size)
@@ -177,6 +362,25 @@ public:
         m_hasher.hash(input, &tmp_buffer_binary_data);
         m_hasher.hash(tmp_buffer_binary_data, output);
     }
+
+    void update(const BinaryData& input) override
+    {
+        m_hasher.update(input);
+    }
+
+    void finalize(BinaryData* output) override
+    {
+        INVARIANT(output);
+
+        multy_core::internal::hash<1024> tmp_buffer;
+        BinaryData tmp_buffer_binary_data = as_binary_data(tmp_buffer);
+        INVARIANT(tmp_buffer_binary_data.len >= output->len);
+
+        tmp_buffer_binary_data.len = output->len;
+
+        m_hasher.finalize(&tmp_buffer_binary_data);
+        m_hasher.hash(tmp_buffer_binary_data, output);
+    }
 };
 
 template <typename HasherT>
@@ -195,6 +399,125 @@ namespace internal
 Hasher::~Hasher()
 {}
 
+void hash_sha2_256(const BinaryData& input, BinaryData* output)
+{
+    THROW_IF_WALLY_ERROR(
+            wally_sha256(input.data, input.len,
+                    get_output_data(output, SHA256_LEN), SHA256_LEN),
+            "Failed to sha2-256 the input.");
+}
+
+void hash_sha2_512(const BinaryData& input, BinaryData* output)
+{
+    THROW_IF_WALLY_ERROR(
+            wally_sha512(input.data, input.len,
+                    get_output_data(output, SHA512_LEN), SHA512_LEN),
+            "Failed to sha2-512 the input.");
+}
+
+void hash_sha2_double_256(const BinaryData& input, BinaryData* output)
+{
+    THROW_IF_WALLY_ERROR(
+            wally_sha256d(input.data, input.len,
+                    get_output_data(output, SHA256_LEN), SHA256_LEN),
+            "Failed to double sha2-256 the input.");
+}
+
+void hash_sha2_double_512(const BinaryData& input, BinaryData* output)
+{
+    unsigned char* out = get_output_data(output, SHA512_LEN);
+
+    // Writing first hash into tmp buffer to avoid modifying output
+    // if exception is thrown in the middle.
+    multy_core::internal::hash<512> tmp;
+    THROW_IF_WALLY_ERROR(
+            wally_sha512(input.data, input.len, tmp.data(), tmp.size()),
+            "Failed to sha2-512 the input.");
+    THROW_IF_WALLY_ERROR(
+            wally_sha512(tmp.data(), tmp.size(), out, SHA512_LEN),
+            "Failed to sha2-512 the input.");
+}
+
+void hash_sha3_224(const BinaryData& input, BinaryData* output)
+{
+    do_keccak_hash(224, KeccakSponge::SHA3_DELIMITER, input, output);
+}
+
+void hash_sha3_256(const BinaryData& input, BinaryData* output)
+{
+    do_keccak_hash(256, KeccakSponge::SHA3_DELIMITER, input, output);
+}
+
+void hash_sha3_384(const BinaryData& input, BinaryData* output)
+{
+    do_keccak_hash(384, KeccakSponge::SHA3_DELIMITER, input, output);
+}
+
+void hash_sha3_512(const BinaryData& input, BinaryData* output)
+{
+    do_keccak_hash(512, KeccakSponge::SHA3_DELIMITER, input, output);
+}
+
+void hash_keccak_256(const BinaryData& input, BinaryData* output)
+{
+    do_keccak_hash(256, KeccakSponge::KECCAK_DELIMITER, input, output);
+}
+
+void hash_ripemd_160(const BinaryData& input, BinaryData* output)
+{
+    unsigned char* out = get_output_data(output, sizeof(struct ripemd160));
+
+    struct ripemd160 ripemd;
+    ripemd160(&ripemd, input.data, input.len);
+    memcpy(out, &ripemd, sizeof(ripemd));
+}
+
+void hash_bitcoin_160(const BinaryData& input, BinaryData* output)
+{
+    THROW_IF_WALLY_ERROR(
+            wally_hash160(input.data, input.len,
+                    get_output_data(output, HASH160_LEN), HASH160_LEN),
+            "Failed to do BitcoinHash160.");
+}
+
+void hash_sha2_256_batch(
+        const BinaryData& inputs, size_t message_size, BinaryData* output)
+{
+    const size_t count = get_batch_size(inputs, message_size);
+    unsigned char* out = get_output_data(output, count * SHA256_LEN);
+
+    sha256_batch(get_sha256_batch_implementation(),
+            inputs.data, message_size, count, out);
+}
+
+void hash_bitcoin_160_batch(
+        const BinaryData& inputs, size_t message_size, BinaryData* output)
+{
+    const size_t count = get_batch_size(inputs, message_size);
+    unsigned char* out = get_output_data(output, count * HASH160_LEN);
+
+    std::vector<unsigned char> sha256_hashes(count * SHA256_LEN);
+    sha256_batch(get_sha256_batch_implementation(),
+            inputs.data, message_size, count, sha256_hashes.data());
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        struct ripemd160 ripemd;
+        ripemd160(&ripemd, sha256_hashes.data() + i * SHA256_LEN, SHA256_LEN);
+        memcpy(out + i * HASH160_LEN, &ripemd, HASH160_LEN);
+    }
+}
+
+void hash_keccak_256_batch(
+        const BinaryData& inputs, size_t message_size, BinaryData* output)
+{
+    const size_t count = get_batch_size(inputs, message_size);
+    unsigned char* out = get_output_data(output, count * 256 / 8);
+
+    keccak_hash_batch(256, KeccakSponge::KECCAK_DELIMITER,
+            inputs.data, message_size, count, out);
+}
+
 HasherPtr make_hasher(HasherType hasher_type, size_t hash_size)
 {
     switch(hasher_type)
@@ -39,16 +39,90 @@ enum HasherType
 class Hasher;
 typedef std::unique_ptr<Hasher> HasherPtr;
 
-// TODO: implemenet progressive hashing, when not all data available at once.
 class Hasher
 {
 public:
     virtual ~Hasher();
+
+    // Hashes whole input at once, doesn't affect progressive hashing state.
     virtual void hash(const BinaryData& input, BinaryData* output) const = 0;
+
+    // Progressive hashing, when not all data available at once:
+    // call update() any number of times, then finalize() to get hash of
+    // all the data passed so far. Hasher is reset by finalize() and can be reused.
+    virtual void update(const BinaryData& input) = 0;
+    virtual void finalize(BinaryData* output) = 0;
 };
 
+// Runtime-selected hasher, for progressive hashing or when hash type is not
+// known at compile time. Prefer do_hash() for one-shot hashing.
 MULTY_CORE_API HasherPtr make_hasher(HasherType hasher_type, size_t hash_bit_size);
 
+// One-shot hash functions, output->len must be at least the size of the hash,
+// only that many bytes are written to the output.
+MULTY_CORE_API void hash_sha2_256(const BinaryData& input, BinaryData* output);
+MULTY_CORE_API void hash_sha2_512(const BinaryData& input, BinaryData* output);
+MULTY_CORE_API void hash_sha2_double_256(const BinaryData& input, BinaryData* output);
+MULTY_CORE_API void hash_sha2_double_512(const BinaryData& input, BinaryData* output);
+MULTY_CORE_API void hash_sha3_224(const BinaryData& input, BinaryData* output);
+MULTY_CORE_API void hash_sha3_256(const BinaryData& input, BinaryData* output);
+MULTY_CORE_API void hash_sha3_384(const BinaryData& input, BinaryData* output);
+MULTY_CORE_API void hash_sha3_512(const BinaryData& input, BinaryData* output);
+MULTY_CORE_API void hash_keccak_256(const BinaryData& input, BinaryData* output);
+MULTY_CORE_API void hash_ripemd_160(const BinaryData& input, BinaryData* output);
+MULTY_CORE_API void hash_bitcoin_160(const BinaryData& input, BinaryData* output);
+
+// Batch hashing of independent messages of the same size, laid back to back
+// in inputs, inputs.len must be a multiple of message_size.
+// Hashes are written to output back to back in the same order,
+// output->len must be at least hash size times the number of messages.
+// Uses SIMD or SHA extensions where CPU supports those.
+MULTY_CORE_API void hash_sha2_256_batch(
+        const BinaryData& inputs, size_t message_size, BinaryData* output);
+MULTY_CORE_API void hash_bitcoin_160_batch(
+        const BinaryData& inputs, size_t message_size, BinaryData* output);
+MULTY_CORE_API void hash_keccak_256_batch(
+        const BinaryData& inputs, size_t message_size, BinaryData* output);
+
+template <HasherType HasherT, size_t hash_bit_size>
+struct UnsupportedHash
+{
+    static const bool value = false;
+};
+
+// Maps hasher type and hash size to a hash function at compile time.
+template <HasherType HasherT, size_t hash_bit_size>
+struct HashFunction
+{
+    static_assert(UnsupportedHash<HasherT, hash_bit_size>::value,
+            "Unsupported combination of hasher type and hash size.");
+    static void hash(const BinaryData& input, BinaryData* output);
+};
+
+#define MULTY_CORE_HASH_FUNCTION(HASHER_TYPE, HASH_SIZE, FUNCTION) \
+    template <> \
+    struct HashFunction<HASHER_TYPE, HASH_SIZE> \
+    { \
+        static void hash(const BinaryData& input, BinaryData* output) \
+        { \
+            FUNCTION(input, output); \
+        } \
+    }
+
+MULTY_CORE_HASH_FUNCTION(SHA2, 256, hash_sha2_256);
+MULTY_CORE_HASH_FUNCTION(SHA2, 512, hash_sha2_512);
+MULTY_CORE_HASH_FUNCTION(SHA2_DOUBLE, 256, hash_sha2_double_256);
+MULTY_CORE_HASH_FUNCTION(SHA2_DOUBLE, 512, hash_sha2_double_512);
+MULTY_CORE_HASH_FUNCTION(SHA3, 224, hash_sha3_224);
+MULTY_CORE_HASH_FUNCTION(SHA3, 256, hash_sha3_256);
+MULTY_CORE_HASH_FUNCTION(SHA3, 384, hash_sha3_384);
+MULTY_CORE_HASH_FUNCTION(SHA3, 512, hash_sha3_512);
+MULTY_CORE_HASH_FUNCTION(KECCAK, 256, hash_keccak_256);
+MULTY_CORE_HASH_FUNCTION(RIPEMD, 160, hash_ripemd_160);
+MULTY_CORE_HASH_FUNCTION(BITCOIN_HASH, 160, hash_bitcoin_160);
+
+#undef MULTY_CORE_HASH_FUNCTION
+
 // Hash given data with sepecific hasher and hash size.
 template <HasherType HasherT, size_t hash_bit_size, typename T>
 inline hash<hash_bit_size> do_hash(const T& input)
@@ -56,7 +130,7 @@ inline hash<hash_bit_size> do_hash(const T& input)
     hash<hash_bit_size> result;
     BinaryData result_data = as_binary_data(result);
 
-    make_hasher(HasherT, hash_bit_size)->hash(as_binary_data(input), &result_data);
+    HashFunction<HasherT, hash_bit_size>::hash(as_binary_data(input), &result_data);
 
     return result;
 }
@@ -69,7 +143,7 @@ inline void do_hash_inplace(const T& input, U* destination)
     INVARIANT(destination != nullptr);
 
     BinaryData dest = as_binary_data(*destination);
-    make_hasher(HasherT, hash_bit_size)->hash(as_binary_data(input), &dest);
+    HashFunction<HasherT, hash_bit_size>::hash(as_binary_data(input), &dest);
 }
 
 } // namespace internal
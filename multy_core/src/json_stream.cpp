@@ -0,0 +1,666 @@
+/* Copyright 2018 by Multy.io
+ * Licensed under Multy.io license.
+ *
+ * See LICENSE for details
+ */
+
+#include "multy_core/src/json_stream.h"
+
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+
+bool is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+int hex_digit_value(char c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f')
+    {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F')
+    {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+void append_utf8(uint32_t code_point, std::string* output)
+{
+    if (code_point < 0x80)
+    {
+        output->push_back(static_cast<char>(code_point));
+    }
+    else if (code_point < 0x800)
+    {
+        output->push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+        output->push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+    else if (code_point < 0x10000)
+    {
+        output->push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+        output->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        output->push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+    else
+    {
+        output->push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+        output->push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+        output->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        output->push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+}
+
+// Parses magnitude of an integer number, false on overflow or non-digits.
+bool parse_magnitude(const char* begin, const char* end, uint64_t* result)
+{
+    if (begin == end)
+    {
+        return false;
+    }
+
+    uint64_t value = 0;
+    for (const char* p = begin; p != end; ++p)
+    {
+        if (!is_digit(*p))
+        {
+            return false;
+        }
+        const uint64_t digit = static_cast<uint64_t>(*p - '0');
+        if (value > (std::numeric_limits<uint64_t>::max() - digit) / 10)
+        {
+            return false;
+        }
+        value = value * 10 + digit;
+    }
+    *result = value;
+
+    return true;
+}
+
+} // namespace
+
+namespace multy_core
+{
+namespace internal
+{
+
+JsonStreamReader::JsonStreamReader(const char* data, size_t size)
+    : m_begin(data),
+      m_end(data + size),
+      m_position(data),
+      m_token_begin(data),
+      m_token(TOKEN_INVALID),
+      m_expectation(EXPECT_VALUE),
+      m_containers(),
+      m_value()
+{
+}
+
+JsonStreamReader::TokenType JsonStreamReader::next()
+{
+    if (m_expectation == EXPECT_NOTHING)
+    {
+        return m_token;
+    }
+
+    skip_whitespace();
+    m_token_begin = m_position;
+
+    if (m_expectation == EXPECT_EOF)
+    {
+        m_token = m_position == m_end ? TOKEN_END : set_invalid();
+        return m_token;
+    }
+    if (m_position == m_end)
+    {
+        return set_invalid();
+    }
+
+    const char c = *m_position;
+    switch (m_expectation)
+    {
+        case EXPECT_SEPARATOR:
+            if (c == ',')
+            {
+                ++m_position;
+                m_expectation = m_containers.back() == '{' ? EXPECT_KEY : EXPECT_VALUE;
+                return next();
+            }
+            return end_container(c);
+
+        case EXPECT_KEY_OR_END:
+            if (c == '}')
+            {
+                return end_container(c);
+            }
+            // fall through
+        case EXPECT_KEY:
+            if (c != '"' || !read_string())
+            {
+                return set_invalid();
+            }
+            skip_whitespace();
+            if (m_position == m_end || *m_position != ':')
+            {
+                return set_invalid();
+            }
+            ++m_position;
+            m_expectation = EXPECT_VALUE;
+            m_token = TOKEN_KEY;
+            return m_token;
+
+        case EXPECT_VALUE_OR_END:
+            if (c == ']')
+            {
+                return end_container(c);
+            }
+            // fall through
+        case EXPECT_VALUE:
+            return read_value();
+
+        case EXPECT_EOF:
+        case EXPECT_NOTHING:
+            break;
+    }
+
+    return set_invalid();
+}
+
+JsonStreamReader::TokenType JsonStreamReader::get_token() const
+{
+    return m_token;
+}
+
+const std::string& JsonStreamReader::get_value() const
+{
+    return m_value;
+}
+
+size_t JsonStreamReader::get_token_offset() const
+{
+    return static_cast<size_t>(m_token_begin - m_begin);
+}
+
+const char* JsonStreamReader::get_token_data() const
+{
+    return m_token_begin;
+}
+
+bool JsonStreamReader::skip_value()
+{
+    if (m_token != TOKEN_BEGIN_OBJECT && m_token != TOKEN_BEGIN_ARRAY)
+    {
+        return m_token != TOKEN_INVALID;
+    }
+
+    const size_t depth = m_containers.size();
+    while (m_containers.size() >= depth)
+    {
+        if (next() == TOKEN_INVALID)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool JsonStreamReader::get_int64(int64_t* value) const
+{
+    if (m_token != TOKEN_NUMBER)
+    {
+        return false;
+    }
+
+    const bool is_negative = !m_value.empty() && m_value[0] == '-';
+    uint64_t magnitude = 0;
+    if (!parse_magnitude(m_value.data() + (is_negative ? 1 : 0),
+            m_value.data() + m_value.size(), &magnitude))
+    {
+        return false;
+    }
+
+    const uint64_t max_magnitude = is_negative
+            ? static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + 1
+            : static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+    if (magnitude > max_magnitude)
+    {
+        return false;
+    }
+
+    *value = is_negative
+            ? static_cast<int64_t>(0 - magnitude)
+            : static_cast<int64_t>(magnitude);
+    return true;
+}
+
+bool JsonStreamReader::get_uint64(uint64_t* value) const
+{
+    return m_token == TOKEN_NUMBER && parse_magnitude(
+            m_value.data(), m_value.data() + m_value.size(), value);
+}
+
+JsonStreamReader::TokenType JsonStreamReader::set_invalid()
+{
+    m_token = TOKEN_INVALID;
+    m_expectation = EXPECT_NOTHING;
+
+    return m_token;
+}
+
+JsonStreamReader::TokenType JsonStreamReader::end_value(TokenType token)
+{
+    m_expectation = m_containers.empty() ? EXPECT_EOF : EXPECT_SEPARATOR;
+    m_token = token;
+    return m_token;
+}
+
+JsonStreamReader::TokenType JsonStreamReader::end_container(char c)
+{
+    if (m_containers.empty())
+    {
+        return set_invalid();
+    }
+
+    const char container = m_containers.back();
+    if ((c == '}' && container == '{') || (c == ']' && container == '['))
+    {
+        ++m_position;
+        m_containers.pop_back();
+        return end_value(c == '}' ? TOKEN_END_OBJECT : TOKEN_END_ARRAY);
+    }
+    return set_invalid();
+}
+
+JsonStreamReader::TokenType JsonStreamReader::read_value()
+{
+    const char c = *m_position;
+    switch (c)
+    {
+        case '{':
+        case '[':
+            ++m_position;
+            m_containers.push_back(c);
+            m_expectation = c == '{' ? EXPECT_KEY_OR_END : EXPECT_VALUE_OR_END;
+            m_token = c == '{' ? TOKEN_BEGIN_OBJECT : TOKEN_BEGIN_ARRAY;
+            return m_token;
+        case '"':
+            return read_string() ? end_value(TOKEN_STRING) : set_invalid();
+        case 't':
+            return read_literal("true") ? end_value(TOKEN_TRUE) : set_invalid();
+        case 'f':
+            return read_literal("false") ? end_value(TOKEN_FALSE) : set_invalid();
+        case 'n':
+            return read_literal("null") ? end_value(TOKEN_NULL) : set_invalid();
+        default:
+            if (c == '-' || is_digit(c))
+            {
+                return read_number() ? end_value(TOKEN_NUMBER) : set_invalid();
+            }
+    }
+    return set_invalid();
+}
+
+bool JsonStreamReader::read_string()
+{
+    // Skipping opening quote.
+    ++m_position;
+    m_value.clear();
+
+    while (m_position != m_end)
+    {
+        // Copying unescaped runs at once.
+        const char* run_end = m_position;
+        while (run_end != m_end && *run_end != '"' && *run_end != '\\')
+        {
+            ++run_end;
+        }
+        m_value.append(m_position, run_end);
+        m_position = run_end;
+
+        if (m_position == m_end)
+        {
+            break;
+        }
+        if (*m_position == '"')
+        {
+            ++m_position;
+            return true;
+        }
+
+        // Escape sequence.
+        ++m_position;
+        if (m_position == m_end)
+        {
+            break;
+        }
+        const char escaped = *m_position++;
+        switch (escaped)
+        {
+            case '"':
+            case '\\':
+            case '/':
+                m_value.push_back(escaped);
+                break;
+            case 'b':
+                m_value.push_back('\b');
+                break;
+            case 'f':
+                m_value.push_back('\f');
+                break;
+            case 'n':
+                m_value.push_back('\n');
+                break;
+            case 'r':
+                m_value.push_back('\r');
+                break;
+            case 't':
+                m_value.push_back('\t');
+                break;
+            case 'u':
+            {
+                uint32_t code_point = 0;
+                for (int surrogate = 0; surrogate < 2; ++surrogate)
+                {
+                    if (m_end - m_position < 4)
+                    {
+                        return false;
+                    }
+                    uint32_t unit = 0;
+                    for (int i = 0; i < 4; ++i)
+                    {
+                        const int digit = hex_digit_value(*m_position++);
+                        if (digit < 0)
+                        {
+                            return false;
+                        }
+                        unit = (unit << 4) | static_cast<uint32_t>(digit);
+                    }
+
+                    if (surrogate == 0)
+                    {
+                        code_point = unit;
+                        if (unit < 0xD800 || unit > 0xDBFF)
+                        {
+                            break;
+                        }
+                        // High surrogate, must be followed by low one.
+                        if (m_end - m_position < 2
+                                || m_position[0] != '\\' || m_position[1] != 'u')
+                        {
+                            return false;
+                        }
+                        m_position += 2;
+                    }
+                    else
+                    {
+                        if (unit < 0xDC00 || unit > 0xDFFF)
+                        {
+                            return false;
+                        }
+                        code_point = 0x10000
+                                + ((code_point - 0xD800) << 10) + (unit - 0xDC00);
+                    }
+                }
+                append_utf8(code_point, &m_value);
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+
+    return false;
+}
+
+bool JsonStreamReader::read_number()
+{
+    const char* p = m_position;
+    if (*p == '-')
+    {
+        ++p;
+    }
+
+    if (p == m_end || !is_digit(*p))
+    {
+        return false;
+    }
+    if (*p == '0')
+    {
+        ++p;
+    }
+    else
+    {
+        while (p != m_end && is_digit(*p))
+        {
+            ++p;
+        }
+    }
+
+    if (p != m_end && *p == '.')
+    {
+        ++p;
+        if (p == m_end || !is_digit(*p))
+        {
+            return false;
+        }
+        while (p != m_end && is_digit(*p))
+        {
+            ++p;
+        }
+    }
+
+    if (p != m_end && (*p == 'e' || *p == 'E'))
+    {
+        ++p;
+        if (p != m_end && (*p == '+' || *p == '-'))
+        {
+            ++p;
+        }
+        if (p == m_end || !is_digit(*p))
+        {
+            return false;
+        }
+        while (p != m_end && is_digit(*p))
+        {
+            ++p;
+        }
+    }
+
+    m_value.assign(m_position, p);
+    m_position = p;
+
+    return true;
+}
+
+bool JsonStreamReader::read_literal(const char* literal)
+{
+    const size_t length = strlen(literal);
+    if (static_cast<size_t>(m_end - m_position) < length
+            || memcmp(m_position, literal, length) != 0)
+    {
+        return false;
+    }
+    m_position += length;
+
+    return true;
+}
+
+void JsonStreamReader::skip_whitespace()
+{
+    while (m_position != m_end
+            && (*m_position == ' ' || *m_position == '\t'
+                    || *m_position == '\n' || *m_position == '\r'))
+    {
+        ++m_position;
+    }
+}
+
+JsonStreamWriter::JsonStreamWriter()
+    : m_buffer(),
+      m_needs_separator(false)
+{
+}
+
+void JsonStreamWriter::clear()
+{
+    m_buffer.clear();
+    m_needs_separator = false;
+}
+
+void JsonStreamWriter::reserve(size_t size)
+{
+    m_buffer.reserve(size);
+}
+
+const std::string& JsonStreamWriter::get_string() const
+{
+    return m_buffer;
+}
+
+JsonStreamWriter& JsonStreamWriter::begin_object()
+{
+    write_separator();
+    m_buffer.push_back('{');
+    m_needs_separator = false;
+
+    return *this;
+}
+
+JsonStreamWriter& JsonStreamWriter::end_object()
+{
+    m_buffer.push_back('}');
+    m_needs_separator = true;
+
+    return *this;
+}
+
+JsonStreamWriter& JsonStreamWriter::begin_array()
+{
+    write_separator();
+    m_buffer.push_back('[');
+    m_needs_separator = false;
+
+    return *this;
+}
+
+JsonStreamWriter& JsonStreamWriter::end_array()
+{
+    m_buffer.push_back(']');
+    m_needs_separator = true;
+
+    return *this;
+}
+
+JsonStreamWriter& JsonStreamWriter::key(const char* name)
+{
+    write_separator();
+    write_string(name, strlen(name));
+    m_buffer.push_back(':');
+    m_needs_separator = false;
+
+    return *this;
+}
+
+JsonStreamWriter& JsonStreamWriter::value(const char* value)
+{
+    write_separator();
+    write_string(value, strlen(value));
+    m_needs_separator = true;
+
+    return *this;
+}
+
+JsonStreamWriter& JsonStreamWriter::value(const std::string& value)
+{
+    write_separator();
+    write_string(value.data(), value.size());
+    m_needs_separator = true;
+
+    return *this;
+}
+
+JsonStreamWriter& JsonStreamWriter::value(int64_t value)
+{
+    write_separator();
+    m_buffer += std::to_string(value);
+    m_needs_separator = true;
+
+    return *this;
+}
+
+JsonStreamWriter& JsonStreamWriter::raw_value(const std::string& json)
+{
+    write_separator();
+    m_buffer += json;
+    m_needs_separator = true;
+
+    return *this;
+}
+
+void JsonStreamWriter::write_separator()
+{
+    if (m_needs_separator)
+    {
+        m_buffer.push_back(',');
+    }
+}
+
+void JsonStreamWriter::write_string(const char* value, size_t size)
+{
+    m_buffer.push_back('"');
+
+    const char* run_begin = value;
+    const char* const end = value + size;
+    for (const char* p = value; p != end; ++p)
+    {
+        const unsigned char c = static_cast<unsigned char>(*p);
+        if (c >= 0x20 && c != '"' && c != '\\')
+        {
+            continue;
+        }
+
+        m_buffer.append(run_begin, p);
+        run_begin = p + 1;
+        switch (c)
+        {
+            case '"':
+                m_buffer += "\\\"";
+                break;
+            case '\\':
+                m_buffer += "\\\\";
+                break;
+            case '\n':
+                m_buffer += "\\n";
+                break;
+            case '\r':
+                m_buffer += "\\r";
+                break;
+            case '\t':
+                m_buffer += "\\t";
+                break;
+            default:
+            {
+                char escaped[7];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                m_buffer += escaped;
+            }
+        }
+    }
+    m_buffer.append(run_begin, end);
+
+    m_buffer.push_back('"');
+}
+
+} // namespace internal
+} // namespace multy_core
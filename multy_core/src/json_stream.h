@@ -0,0 +1,144 @@
+/* Copyright 2018 by Multy.io
+ * Licensed under Multy.io license.
+ *
+ * See LICENSE for details
+ */
+
+#ifndef MULTY_CORE_SRC_JSON_STREAM_H
+#define MULTY_CORE_SRC_JSON_STREAM_H
+
+#include "multy_core/api.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace multy_core
+{
+namespace internal
+{
+
+/** Streaming JSON tokenizer, reads input token by token without building any DOM.
+ *
+ * Intended for hot paths where input is expected to be well-formed:
+ * any malformed or unsupported input (like comments) yields TOKEN_INVALID,
+ * and caller is expected to fall back to jsoncpp for proper diagnostics.
+ */
+class MULTY_CORE_API JsonStreamReader
+{
+public:
+    enum TokenType
+    {
+        TOKEN_INVALID,
+        TOKEN_END,
+        TOKEN_BEGIN_OBJECT,
+        TOKEN_END_OBJECT,
+        TOKEN_BEGIN_ARRAY,
+        TOKEN_END_ARRAY,
+        TOKEN_KEY,
+        TOKEN_STRING,
+        TOKEN_NUMBER,
+        TOKEN_TRUE,
+        TOKEN_FALSE,
+        TOKEN_NULL
+    };
+
+    /** Reads a single JSON value from data, which must outlive the reader.
+     *
+     * Once that value is read, any non-whitespace input left is an error.
+     */
+    JsonStreamReader(const char* data, size_t size);
+
+    /// Advances to the next token, TOKEN_INVALID is returned forever once an error occurs.
+    TokenType next();
+    TokenType get_token() const;
+
+    /// Unescaped TOKEN_KEY or TOKEN_STRING value, or raw TOKEN_NUMBER text.
+    const std::string& get_value() const;
+
+    /// Offset of the current token in the input data.
+    size_t get_token_offset() const;
+    /// Pointer to the current token in the input data.
+    const char* get_token_data() const;
+
+    /// Skips rest of the value that starts with current token.
+    /// @return false if input is malformed.
+    bool skip_value();
+
+    /// Converts TOKEN_NUMBER to integer, false if it is not an integer or out of range.
+    bool get_int64(int64_t* value) const;
+    bool get_uint64(uint64_t* value) const;
+
+private:
+    enum Expectation
+    {
+        EXPECT_VALUE,
+        EXPECT_VALUE_OR_END,
+        EXPECT_KEY,
+        EXPECT_KEY_OR_END,
+        EXPECT_SEPARATOR,
+        EXPECT_EOF,
+        // Input is malformed, nothing is read anymore.
+        EXPECT_NOTHING
+    };
+
+    TokenType set_invalid();
+    TokenType end_value(TokenType token);
+    TokenType end_container(char container);
+    TokenType read_value();
+    bool read_string();
+    bool read_number();
+    bool read_literal(const char* literal);
+    void skip_whitespace();
+
+private:
+    const char* const m_begin;
+    const char* const m_end;
+    const char* m_position;
+    const char* m_token_begin;
+    TokenType m_token;
+    Expectation m_expectation;
+    // '{' or '[' for every container that is not closed yet.
+    std::vector<char> m_containers;
+    std::string m_value;
+};
+
+/** Appends JSON to a string buffer, with separators and escaping handled automatically.
+ *
+ * Can be reused for multiple documents: clear() keeps the buffer capacity.
+ * Well-formedness of the output is caller's responsibility.
+ */
+class MULTY_CORE_API JsonStreamWriter
+{
+public:
+    JsonStreamWriter();
+
+    void clear();
+    void reserve(size_t size);
+    const std::string& get_string() const;
+
+    JsonStreamWriter& begin_object();
+    JsonStreamWriter& end_object();
+    JsonStreamWriter& begin_array();
+    JsonStreamWriter& end_array();
+    JsonStreamWriter& key(const char* name);
+    JsonStreamWriter& value(const char* value);
+    JsonStreamWriter& value(const std::string& value);
+    JsonStreamWriter& value(int64_t value);
+    /// Writes already serialized JSON value as is.
+    JsonStreamWriter& raw_value(const std::string& json);
+
+private:
+    void write_separator();
+    void write_string(const char* value, size_t size);
+
+private:
+    std::string m_buffer;
+    bool m_needs_separator;
+};
+
+} // namespace internal
+} // namespace multy_core
+
+#endif // MULTY_CORE_SRC_JSON_STREAM_H
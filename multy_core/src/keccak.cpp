@@ -0,0 +1,388 @@
+/* Copyright 2018 by Multy.io
+ * Licensed under Multy.io license.
+ *
+ * See LICENSE for details
+ */
+
+#include "multy_core/src/keccak.h"
+
+#include "multy_core/src/cpu_features.h"
+#include "multy_core/src/exception.h"
+
+#include "third-party/portable_endian.h"
+
+#include <algorithm>
+#include <string.h>
+
+namespace
+{
+using namespace multy_core::internal;
+
+const size_t KECCAK_STATE_SIZE = 200;
+const size_t KECCAK_LANES = 25;
+
+const uint64_t ROUND_CONSTANTS[24] =
+{
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL,
+    0x8000000080008000ULL, 0x000000000000808bULL, 0x0000000080000001ULL,
+    0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008aULL,
+    0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL,
+    0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x000000000000800aULL, 0x800000008000000aULL, 0x8000000080008081ULL,
+    0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+// Always inlined, so that vector code is generated for the instruction set
+// of the caller. Rotation is a macro for the same reason: passing AVX vectors
+// by value to a function not compiled for AVX changes the ABI.
+#if defined(__GNUC__)
+#    define KECCAK_INLINE inline __attribute__((always_inline))
+#else
+#    define KECCAK_INLINE inline
+#endif
+#define KECCAK_ROTL64(x, n) (((x) << (n)) | ((x) >> (64 - (n))))
+
+// Single round of Keccak-f[1600], fully unrolled, lane (x, y) is a[x + 5 * y].
+// T is either uint64_t or a vector of uint64_t lanes, one state per lane.
+template <typename T>
+KECCAK_INLINE void keccak_round(T* a, uint64_t round_constant)
+{
+    // Theta
+    const T c0 = a[0] ^ a[5] ^ a[10] ^ a[15] ^ a[20];
+    const T c1 = a[1] ^ a[6] ^ a[11] ^ a[16] ^ a[21];
+    const T c2 = a[2] ^ a[7] ^ a[12] ^ a[17] ^ a[22];
+    const T c3 = a[3] ^ a[8] ^ a[13] ^ a[18] ^ a[23];
+    const T c4 = a[4] ^ a[9] ^ a[14] ^ a[19] ^ a[24];
+    const T d0 = c4 ^ KECCAK_ROTL64(c1, 1);
+    const T d1 = c0 ^ KECCAK_ROTL64(c2, 1);
+    const T d2 = c1 ^ KECCAK_ROTL64(c3, 1);
+    const T d3 = c2 ^ KECCAK_ROTL64(c4, 1);
+    const T d4 = c3 ^ KECCAK_ROTL64(c0, 1);
+
+    // Rho and Pi
+    const T b0 = a[0] ^ d0;
+    const T b1 = KECCAK_ROTL64(a[6] ^ d1, 44);
+    const T b2 = KECCAK_ROTL64(a[12] ^ d2, 43);
+    const T b3 = KECCAK_ROTL64(a[18] ^ d3, 21);
+    const T b4 = KECCAK_ROTL64(a[24] ^ d4, 14);
+    const T b5 = KECCAK_ROTL64(a[3] ^ d3, 28);
+    const T b6 = KECCAK_ROTL64(a[9] ^ d4, 20);
+    const T b7 = KECCAK_ROTL64(a[10] ^ d0, 3);
+    const T b8 = KECCAK_ROTL64(a[16] ^ d1, 45);
+    const T b9 = KECCAK_ROTL64(a[22] ^ d2, 61);
+    const T b10 = KECCAK_ROTL64(a[1] ^ d1, 1);
+    const T b11 = KECCAK_ROTL64(a[7] ^ d2, 6);
+    const T b12 = KECCAK_ROTL64(a[13] ^ d3, 25);
+    const T b13 = KECCAK_ROTL64(a[19] ^ d4, 8);
+    const T b14 = KECCAK_ROTL64(a[20] ^ d0, 18);
+    const T b15 = KECCAK_ROTL64(a[4] ^ d4, 27);
+    const T b16 = KECCAK_ROTL64(a[5] ^ d0, 36);
+    const T b17 = KECCAK_ROTL64(a[11] ^ d1, 10);
+    const T b18 = KECCAK_ROTL64(a[17] ^ d2, 15);
+    const T b19 = KECCAK_ROTL64(a[23] ^ d3, 56);
+    const T b20 = KECCAK_ROTL64(a[2] ^ d2, 62);
+    const T b21 = KECCAK_ROTL64(a[8] ^ d3, 55);
+    const T b22 = KECCAK_ROTL64(a[14] ^ d4, 39);
+    const T b23 = KECCAK_ROTL64(a[15] ^ d0, 41);
+    const T b24 = KECCAK_ROTL64(a[21] ^ d1, 2);
+
+    // Chi and Iota
+    a[0] = b0 ^ (~b1 & b2) ^ round_constant;
+    a[1] = b1 ^ (~b2 & b3);
+    a[2] = b2 ^ (~b3 & b4);
+    a[3] = b3 ^ (~b4 & b0);
+    a[4] = b4 ^ (~b0 & b1);
+    a[5] = b5 ^ (~b6 & b7);
+    a[6] = b6 ^ (~b7 & b8);
+    a[7] = b7 ^ (~b8 & b9);
+    a[8] = b8 ^ (~b9 & b5);
+    a[9] = b9 ^ (~b5 & b6);
+    a[10] = b10 ^ (~b11 & b12);
+    a[11] = b11 ^ (~b12 & b13);
+    a[12] = b12 ^ (~b13 & b14);
+    a[13] = b13 ^ (~b14 & b10);
+    a[14] = b14 ^ (~b10 & b11);
+    a[15] = b15 ^ (~b16 & b17);
+    a[16] = b16 ^ (~b17 & b18);
+    a[17] = b17 ^ (~b18 & b19);
+    a[18] = b18 ^ (~b19 & b15);
+    a[19] = b19 ^ (~b15 & b16);
+    a[20] = b20 ^ (~b21 & b22);
+    a[21] = b21 ^ (~b22 & b23);
+    a[22] = b22 ^ (~b23 & b24);
+    a[23] = b23 ^ (~b24 & b20);
+    a[24] = b24 ^ (~b20 & b21);
+}
+
+template <typename T>
+KECCAK_INLINE void keccak_permute(T* state)
+{
+    for (size_t round = 0; round < 24; ++round)
+    {
+        keccak_round(state, ROUND_CONSTANTS[round]);
+    }
+}
+
+inline uint64_t load_le64(const uint8_t* data)
+{
+    uint64_t value;
+    memcpy(&value, data, sizeof(value));
+    return le64toh(value);
+}
+
+inline void store_le64(uint64_t value, uint8_t* data)
+{
+    value = htole64(value);
+    memcpy(data, &value, sizeof(value));
+}
+
+// Bytes of the state are the bytes of little-endian lanes.
+inline void xor_byte(uint64_t* state, size_t index, uint8_t value)
+{
+    state[index / 8] ^= static_cast<uint64_t>(value) << (8 * (index % 8));
+}
+
+inline void xor_block(uint64_t* state, const uint8_t* data, size_t rate)
+{
+    for (size_t i = 0; i < rate / 8; ++i)
+    {
+        state[i] ^= load_le64(data + 8 * i);
+    }
+}
+
+void extract_bytes(const uint64_t* state, uint8_t* output, size_t size)
+{
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        store_le64(state[i / 8], output + i);
+    }
+    for (; i < size; ++i)
+    {
+        output[i] = static_cast<uint8_t>(state[i / 8] >> (8 * (i % 8)));
+    }
+}
+
+size_t get_rate(size_t hash_bit_size)
+{
+    INVARIANT(hash_bit_size > 0 && hash_bit_size <= 512 && hash_bit_size % 32 == 0);
+    return KECCAK_STATE_SIZE - hash_bit_size / 4;
+}
+
+// Last incomplete block of the message, padded with delimiter and 0x80.
+void make_padded_tail(const uint8_t* message, size_t message_size,
+        size_t rate, uint8_t delimiter, uint8_t* tail)
+{
+    const size_t remainder = message_size % rate;
+    memset(tail, 0, rate);
+    if (remainder != 0)
+    {
+        memcpy(tail, message + message_size - remainder, remainder);
+    }
+    tail[remainder] ^= delimiter;
+    tail[rate - 1] ^= 0x80;
+}
+
+#if MULTY_CORE_X86_SIMD
+
+typedef uint64_t U64x4 __attribute__((vector_size(32)));
+const size_t KECCAK_X4_LANES = 4;
+
+// Hashes 4 messages at once, one state per 64-bit lane of AVX2 register.
+__attribute__((target("avx2")))
+void keccak_x4_avx2(size_t hash_bit_size, uint8_t delimiter,
+        const uint8_t* inputs, size_t message_size, uint8_t* outputs)
+{
+    const size_t rate = get_rate(hash_bit_size);
+    const size_t hash_size = hash_bit_size / 8;
+
+    U64x4 state[KECCAK_LANES];
+    for (size_t i = 0; i < KECCAK_LANES; ++i)
+    {
+        state[i] = U64x4{};
+    }
+
+    const uint8_t* messages[KECCAK_X4_LANES];
+    for (size_t lane = 0; lane < KECCAK_X4_LANES; ++lane)
+    {
+        messages[lane] = inputs + lane * message_size;
+    }
+
+    const size_t full_blocks = message_size / rate;
+    for (size_t block = 0; block <= full_blocks; ++block)
+    {
+        uint8_t tails[KECCAK_X4_LANES][KECCAK_STATE_SIZE];
+        const uint8_t* data[KECCAK_X4_LANES];
+        for (size_t lane = 0; lane < KECCAK_X4_LANES; ++lane)
+        {
+            if (block < full_blocks)
+            {
+                data[lane] = messages[lane] + block * rate;
+            }
+            else
+            {
+                make_padded_tail(messages[lane], message_size, rate, delimiter,
+                        tails[lane]);
+                data[lane] = tails[lane];
+            }
+        }
+
+        for (size_t i = 0; i < rate / 8; ++i)
+        {
+            const U64x4 words = {
+                load_le64(data[0] + 8 * i),
+                load_le64(data[1] + 8 * i),
+                load_le64(data[2] + 8 * i),
+                load_le64(data[3] + 8 * i)
+            };
+            state[i] ^= words;
+        }
+        keccak_permute(state);
+    }
+
+    for (size_t lane = 0; lane < KECCAK_X4_LANES; ++lane)
+    {
+        uint64_t lane_state[KECCAK_LANES];
+        for (size_t i = 0; i < (hash_size + 7) / 8; ++i)
+        {
+            lane_state[i] = state[i][lane];
+        }
+        extract_bytes(lane_state, outputs + lane * hash_size, hash_size);
+    }
+}
+
+#endif // MULTY_CORE_X86_SIMD
+
+} // namespace
+
+namespace multy_core
+{
+namespace internal
+{
+
+void keccak_f1600(uint64_t state[25])
+{
+    keccak_permute(state);
+}
+
+void keccak_hash(size_t hash_bit_size, uint8_t delimiter,
+        const uint8_t* data, size_t size, uint8_t* output)
+{
+    INVARIANT(data != nullptr || size == 0);
+    INVARIANT(output != nullptr);
+
+    const size_t rate = get_rate(hash_bit_size);
+    uint64_t state[KECCAK_LANES] = {0};
+
+    for (; size >= rate; data += rate, size -= rate)
+    {
+        xor_block(state, data, rate);
+        keccak_f1600(state);
+    }
+
+    uint8_t tail[KECCAK_STATE_SIZE];
+    make_padded_tail(data, size, rate, delimiter, tail);
+    xor_block(state, tail, rate);
+    keccak_f1600(state);
+
+    extract_bytes(state, output, hash_bit_size / 8);
+}
+
+void keccak_hash_batch(size_t hash_bit_size, uint8_t delimiter,
+        const uint8_t* inputs, size_t message_size, size_t count,
+        uint8_t* outputs)
+{
+    INVARIANT(inputs != nullptr || message_size == 0 || count == 0);
+    INVARIANT(outputs != nullptr || count == 0);
+
+    const size_t hash_size = hash_bit_size / 8;
+    size_t i = 0;
+#if MULTY_CORE_X86_SIMD
+    if (get_cpu_features().avx2)
+    {
+        for (; i + KECCAK_X4_LANES <= count; i += KECCAK_X4_LANES)
+        {
+            keccak_x4_avx2(hash_bit_size, delimiter,
+                    inputs + i * message_size, message_size,
+                    outputs + i * hash_size);
+        }
+    }
+#endif // MULTY_CORE_X86_SIMD
+
+    for (; i < count; ++i)
+    {
+        keccak_hash(hash_bit_size, delimiter, inputs + i * message_size,
+                message_size, outputs + i * hash_size);
+    }
+}
+
+KeccakSponge::KeccakSponge(size_t hash_bit_size, uint8_t delimiter)
+    : m_state(),
+      m_rate(get_rate(hash_bit_size)),
+      m_delimiter(delimiter),
+      m_offset(0)
+{
+    reset();
+}
+
+KeccakSponge::~KeccakSponge()
+{
+    reset();
+}
+
+void KeccakSponge::absorb(const uint8_t* data, size_t size)
+{
+    INVARIANT(data != nullptr || size == 0);
+
+    while (size > 0)
+    {
+        if (m_offset == 0 && size >= m_rate)
+        {
+            xor_block(m_state.data(), data, m_rate);
+            keccak_f1600(m_state.data());
+            data += m_rate;
+            size -= m_rate;
+            continue;
+        }
+
+        const size_t chunk = std::min(size, m_rate - m_offset);
+        for (size_t i = 0; i < chunk; ++i)
+        {
+            xor_byte(m_state.data(), m_offset + i, data[i]);
+        }
+        m_offset += chunk;
+        data += chunk;
+        size -= chunk;
+
+        if (m_offset == m_rate)
+        {
+            keccak_f1600(m_state.data());
+            m_offset = 0;
+        }
+    }
+}
+
+void KeccakSponge::squeeze(uint8_t* output, size_t size)
+{
+    INVARIANT(output != nullptr);
+    // Hash is never bigger than the rate, so single permutation is enough.
+    INVARIANT(size <= m_rate);
+
+    xor_byte(m_state.data(), m_offset, m_delimiter);
+    xor_byte(m_state.data(), m_rate - 1, 0x80);
+    keccak_f1600(m_state.data());
+
+    extract_bytes(m_state.data(), output, size);
+
+    reset();
+}
+
+void KeccakSponge::reset()
+{
+    m_state.fill(0);
+    m_offset = 0;
+}
+
+} // namespace internal
+} // namespace multy_core
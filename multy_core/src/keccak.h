@@ -0,0 +1,75 @@
+/* Copyright 2018 by Multy.io
+ * Licensed under Multy.io license.
+ *
+ * See LICENSE for details
+ */
+
+#ifndef MULTY_CORE_SRC_KECCAK_H
+#define MULTY_CORE_SRC_KECCAK_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace multy_core
+{
+namespace internal
+{
+
+// Keccak-f[1600] permutation, state is 25 little-endian 64-bit lanes.
+void keccak_f1600(uint64_t state[25]);
+
+/** One-shot Keccak sponge hash.
+ *
+ * @param hash_bit_size - 224, 256, 384 or 512.
+ * @param delimiter - padding delimiter, see KeccakSponge.
+ * @param data - input, may be null only if size is 0.
+ * @param output - buffer for hash_bit_size / 8 bytes.
+ */
+void keccak_hash(size_t hash_bit_size, uint8_t delimiter,
+        const uint8_t* data, size_t size, uint8_t* output);
+
+// Same as keccak_hash() for count messages of message_size bytes each,
+// laid back to back, hashes 4 messages at once with AVX2 where available.
+void keccak_hash_batch(size_t hash_bit_size, uint8_t delimiter,
+        const uint8_t* inputs, size_t message_size, size_t count,
+        uint8_t* outputs);
+
+/** Keccak sponge that absorbs input progressively.
+ *
+ * Same construction is used by FIPS202 SHA-3 and by pre-standard Keccak
+ * (used by Ethereum), they differ only in padding delimiter.
+ */
+class KeccakSponge
+{
+public:
+    static const uint8_t SHA3_DELIMITER = 0x06;
+    static const uint8_t KECCAK_DELIMITER = 0x01;
+
+    /**
+     * @param hash_bit_size - size of the produced hash, rate is derived from it.
+     * @param delimiter - padding delimiter, one of SHA3_DELIMITER, KECCAK_DELIMITER.
+     */
+    KeccakSponge(size_t hash_bit_size, uint8_t delimiter);
+    ~KeccakSponge();
+
+    void absorb(const uint8_t* data, size_t size);
+
+    // Pads absorbed data and writes hash to the output,
+    // sponge is reset to initial state afterwards.
+    void squeeze(uint8_t* output, size_t size);
+
+    void reset();
+
+private:
+    std::array<uint64_t, 25> m_state;
+    const size_t m_rate;
+    const uint8_t m_delimiter;
+    // Number of bytes absorbed into the current block.
+    size_t m_offset;
+};
+
+} // namespace internal
+} // namespace multy_core
+
+#endif // MULTY_CORE_SRC_KECCAK_H
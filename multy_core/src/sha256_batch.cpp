@@ -0,0 +1,386 @@
+/* Copyright 2018 by Multy.io
+ * Licensed under Multy.io license.
+ *
+ * See LICENSE for details
+ */
+
+#include "multy_core/src/sha256_batch.h"
+
+#include "multy_core/src/cpu_features.h"
+#include "multy_core/src/exception.h"
+#include "multy_core/src/exception_stream.h"
+
+extern "C" {
+#include "ccan/ccan/crypto/sha256/sha256.h"
+} // extern "C"
+
+#include <string.h>
+
+#if MULTY_CORE_X86_SIMD
+#    include <immintrin.h>
+#endif
+
+namespace
+{
+using namespace multy_core::internal;
+
+const size_t SHA256_BLOCK_SIZE = 64;
+const size_t SHA256_HASH_SIZE = 32;
+
+const uint32_t SHA256_INITIAL_STATE[8] =
+{
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+const uint32_t SHA256_ROUND_CONSTANTS[64] =
+{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+inline uint32_t read_be32(const uint8_t* data)
+{
+    return (static_cast<uint32_t>(data[0]) << 24)
+            | (static_cast<uint32_t>(data[1]) << 16)
+            | (static_cast<uint32_t>(data[2]) << 8)
+            | static_cast<uint32_t>(data[3]);
+}
+
+inline void write_be32(uint32_t value, uint8_t* data)
+{
+    data[0] = static_cast<uint8_t>(value >> 24);
+    data[1] = static_cast<uint8_t>(value >> 16);
+    data[2] = static_cast<uint8_t>(value >> 8);
+    data[3] = static_cast<uint8_t>(value);
+}
+
+// Last incomplete block of the message followed by 0x80, zeroes and
+// message size in bits (big-endian), returns number of blocks in tail: 1 or 2.
+size_t make_padded_tail(
+        const uint8_t* message,
+        size_t message_size,
+        uint8_t (&tail)[2 * SHA256_BLOCK_SIZE])
+{
+    const size_t remainder = message_size % SHA256_BLOCK_SIZE;
+    const size_t tail_blocks = remainder + 9 <= SHA256_BLOCK_SIZE ? 1 : 2;
+
+    memset(tail, 0, sizeof(tail));
+    if (remainder != 0)
+    {
+        memcpy(tail, message + message_size - remainder, remainder);
+    }
+    tail[remainder] = 0x80;
+
+    const uint64_t bit_size = static_cast<uint64_t>(message_size) * 8;
+    for (size_t i = 0; i < 8; ++i)
+    {
+        tail[tail_blocks * SHA256_BLOCK_SIZE - 1 - i] =
+                static_cast<uint8_t>(bit_size >> (8 * i));
+    }
+
+    return tail_blocks;
+}
+
+void sha256_portable(const uint8_t* message, size_t message_size, uint8_t* output)
+{
+    struct sha256 result;
+    sha256(&result, message, message_size);
+    memcpy(output, &result, SHA256_HASH_SIZE);
+}
+
+#if MULTY_CORE_X86_SIMD
+
+// 32-bit lanes, each lane processes its own message.
+typedef uint32_t U32x4 __attribute__((vector_size(16)));
+typedef uint32_t U32x8 __attribute__((vector_size(32)));
+
+// Always inlined into callers compiled for specific instruction set,
+// so code is generated for that instruction set.
+#define SHA256_BATCH_INLINE inline __attribute__((always_inline))
+
+// Macro rather than a function, since passing AVX vectors by value
+// to a function not compiled for AVX changes the ABI.
+#define SHA256_BATCH_ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+template <typename V, size_t LANES>
+SHA256_BATCH_INLINE void sha256_multi_buffer(
+        const uint8_t* inputs, size_t message_size, uint8_t* outputs)
+{
+    uint8_t tails[LANES][2 * SHA256_BLOCK_SIZE];
+    size_t tail_blocks = 0;
+    for (size_t lane = 0; lane < LANES; ++lane)
+    {
+        tail_blocks = make_padded_tail(
+                inputs + lane * message_size, message_size, tails[lane]);
+    }
+    const size_t full_blocks = message_size / SHA256_BLOCK_SIZE;
+
+    V state[8];
+    for (size_t i = 0; i < 8; ++i)
+    {
+        state[i] = V{} + SHA256_INITIAL_STATE[i];
+    }
+
+    for (size_t block = 0; block < full_blocks + tail_blocks; ++block)
+    {
+        V w[16];
+        for (size_t lane = 0; lane < LANES; ++lane)
+        {
+            const uint8_t* data = block < full_blocks
+                    ? inputs + lane * message_size + block * SHA256_BLOCK_SIZE
+                    : tails[lane] + (block - full_blocks) * SHA256_BLOCK_SIZE;
+            for (size_t t = 0; t < 16; ++t)
+            {
+                w[t][lane] = read_be32(data + 4 * t);
+            }
+        }
+
+        V a = state[0], b = state[1], c = state[2], d = state[3];
+        V e = state[4], f = state[5], g = state[6], h = state[7];
+        for (size_t t = 0; t < 64; ++t)
+        {
+            if (t >= 16)
+            {
+                const V w15 = w[(t - 15) % 16];
+                const V w2 = w[(t - 2) % 16];
+                const V s0 = SHA256_BATCH_ROTR(w15, 7)
+                        ^ SHA256_BATCH_ROTR(w15, 18) ^ (w15 >> 3);
+                const V s1 = SHA256_BATCH_ROTR(w2, 17)
+                        ^ SHA256_BATCH_ROTR(w2, 19) ^ (w2 >> 10);
+                w[t % 16] += s0 + w[(t - 7) % 16] + s1;
+            }
+
+            const V S1 = SHA256_BATCH_ROTR(e, 6)
+                    ^ SHA256_BATCH_ROTR(e, 11) ^ SHA256_BATCH_ROTR(e, 25);
+            const V S0 = SHA256_BATCH_ROTR(a, 2)
+                    ^ SHA256_BATCH_ROTR(a, 13) ^ SHA256_BATCH_ROTR(a, 22);
+            const V t1 = h + S1 + ((e & f) ^ (~e & g))
+                    + SHA256_ROUND_CONSTANTS[t] + w[t % 16];
+            const V t2 = S0 + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+
+    for (size_t lane = 0; lane < LANES; ++lane)
+    {
+        for (size_t i = 0; i < 8; ++i)
+        {
+            write_be32(state[i][lane], outputs + lane * SHA256_HASH_SIZE + 4 * i);
+        }
+    }
+}
+
+__attribute__((target("sse4.1")))
+void sha256_x4_sse4(const uint8_t* inputs, size_t message_size, uint8_t* outputs)
+{
+    sha256_multi_buffer<U32x4, 4>(inputs, message_size, outputs);
+}
+
+__attribute__((target("avx2")))
+void sha256_x8_avx2(const uint8_t* inputs, size_t message_size, uint8_t* outputs)
+{
+    sha256_multi_buffer<U32x8, 8>(inputs, message_size, outputs);
+}
+
+__attribute__((target("sha,sse4.1")))
+void sha256_transform_sha_ni(uint32_t state[8], const uint8_t* data, size_t blocks)
+{
+    const __m128i byte_swap_mask = _mm_set_epi64x(
+            0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // State is kept as ABEF and CDGH, as expected by sha256rnds2.
+    __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0]));
+    __m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4]));
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);
+    state1 = _mm_shuffle_epi32(state1, 0x1B);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    for (; blocks > 0; --blocks, data += SHA256_BLOCK_SIZE)
+    {
+        const __m128i abef_save = state0;
+        const __m128i cdgh_save = state1;
+
+        // Four rounds per iteration, w[i % 4] holds current four message words.
+        __m128i w[4];
+        for (size_t i = 0; i < 16; ++i)
+        {
+            if (i < 4)
+            {
+                w[i] = _mm_shuffle_epi8(
+                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i)),
+                        byte_swap_mask);
+            }
+            else
+            {
+                __m128i next = _mm_sha256msg1_epu32(w[i % 4], w[(i + 1) % 4]);
+                next = _mm_add_epi32(next, _mm_alignr_epi8(w[(i + 3) % 4], w[(i + 2) % 4], 4));
+                w[i % 4] = _mm_sha256msg2_epu32(next, w[(i + 3) % 4]);
+            }
+
+            __m128i message = _mm_add_epi32(w[i % 4],
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                            &SHA256_ROUND_CONSTANTS[4 * i])));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, message);
+            message = _mm_shuffle_epi32(message, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, message);
+        }
+
+        state0 = _mm_add_epi32(state0, abef_save);
+        state1 = _mm_add_epi32(state1, cdgh_save);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+}
+
+void sha256_sha_ni(const uint8_t* message, size_t message_size, uint8_t* output)
+{
+    uint32_t state[8];
+    memcpy(state, SHA256_INITIAL_STATE, sizeof(state));
+
+    const size_t full_blocks = message_size / SHA256_BLOCK_SIZE;
+    if (full_blocks != 0)
+    {
+        sha256_transform_sha_ni(state, message, full_blocks);
+    }
+
+    uint8_t tail[2 * SHA256_BLOCK_SIZE];
+    const size_t tail_blocks = make_padded_tail(message, message_size, tail);
+    sha256_transform_sha_ni(state, tail, tail_blocks);
+
+    for (size_t i = 0; i < 8; ++i)
+    {
+        write_be32(state[i], output + 4 * i);
+    }
+}
+
+#endif // MULTY_CORE_X86_SIMD
+
+} // namespace
+
+namespace multy_core
+{
+namespace internal
+{
+
+Sha256BatchImplementation get_sha256_batch_implementation()
+{
+    // SHA extensions outperform multi-buffer kernels on CPUs that have them.
+    const Sha256BatchImplementation PREFERRED_ORDER[] = {
+        SHA256_BATCH_SHA_NI,
+        SHA256_BATCH_AVX2,
+        SHA256_BATCH_SSE4,
+    };
+    for (const auto implementation : PREFERRED_ORDER)
+    {
+        if (is_sha256_batch_implementation_supported(implementation))
+        {
+            return implementation;
+        }
+    }
+    return SHA256_BATCH_PORTABLE;
+}
+
+bool is_sha256_batch_implementation_supported(
+        Sha256BatchImplementation implementation)
+{
+    const CpuFeatures& features = get_cpu_features();
+    switch (implementation)
+    {
+        case SHA256_BATCH_PORTABLE:
+            return true;
+        case SHA256_BATCH_SSE4:
+            return features.sse4_1;
+        case SHA256_BATCH_AVX2:
+            return features.avx2;
+        case SHA256_BATCH_SHA_NI:
+            return features.sha;
+    }
+    return false;
+}
+
+void sha256_batch(
+        Sha256BatchImplementation implementation,
+        const uint8_t* inputs,
+        size_t message_size,
+        size_t count,
+        uint8_t* outputs)
+{
+    INVARIANT(inputs != nullptr || message_size == 0 || count == 0);
+    INVARIANT(outputs != nullptr || count == 0);
+
+    if (!is_sha256_batch_implementation_supported(implementation))
+    {
+        THROW_EXCEPTION("SHA256 batch implementation is not supported by CPU.")
+                << " Implementation: " << implementation << ".";
+    }
+
+    size_t i = 0;
+#if MULTY_CORE_X86_SIMD
+    switch (implementation)
+    {
+        case SHA256_BATCH_SHA_NI:
+            for (; i < count; ++i)
+            {
+                sha256_sha_ni(inputs + i * message_size, message_size,
+                        outputs + i * SHA256_HASH_SIZE);
+            }
+            break;
+        case SHA256_BATCH_AVX2:
+            for (; i + 8 <= count; i += 8)
+            {
+                sha256_x8_avx2(inputs + i * message_size, message_size,
+                        outputs + i * SHA256_HASH_SIZE);
+            }
+            // AVX2 implies SSE4.1, remaining messages are done 4 at once.
+            // fall through
+        case SHA256_BATCH_SSE4:
+            for (; i + 4 <= count; i += 4)
+            {
+                sha256_x4_sse4(inputs + i * message_size, message_size,
+                        outputs + i * SHA256_HASH_SIZE);
+            }
+            break;
+        case SHA256_BATCH_PORTABLE:
+            break;
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        sha256_portable(inputs + i * message_size, message_size,
+                outputs + i * SHA256_HASH_SIZE);
+    }
+}
+
+} // namespace internal
+} // namespace multy_core
@@ -0,0 +1,52 @@
+/* Copyright 2018 by Multy.io
+ * Licensed under Multy.io license.
+ *
+ * See LICENSE for details
+ */
+
+#ifndef MULTY_CORE_SRC_SHA256_BATCH_H
+#define MULTY_CORE_SRC_SHA256_BATCH_H
+
+#include "multy_core/api.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace multy_core
+{
+namespace internal
+{
+
+enum Sha256BatchImplementation
+{
+    SHA256_BATCH_PORTABLE, // one message at a time, plain C.
+    SHA256_BATCH_SSE4,     // 4 messages at once.
+    SHA256_BATCH_AVX2,     // 8 messages at once.
+    SHA256_BATCH_SHA_NI,   // one message at a time with SHA extensions.
+};
+
+/// Fastest implementation supported by the CPU, detected once.
+MULTY_CORE_API Sha256BatchImplementation get_sha256_batch_implementation();
+
+MULTY_CORE_API bool is_sha256_batch_implementation_supported(
+        Sha256BatchImplementation implementation);
+
+/** SHA2-256 of count independent messages of the same size.
+ *
+ * @param implementation - must be supported by the CPU.
+ * @param inputs - count messages of message_size bytes each, back to back.
+ * @param message_size - size of each message in bytes.
+ * @param count - number of messages.
+ * @param outputs - buffer for count hashes of 32 bytes each.
+ */
+MULTY_CORE_API void sha256_batch(
+        Sha256BatchImplementation implementation,
+        const uint8_t* inputs,
+        size_t message_size,
+        size_t count,
+        uint8_t* outputs);
+
+} // namespace internal
+} // namespace multy_core
+
+#endif // MULTY_CORE_SRC_SHA256_BATCH_H
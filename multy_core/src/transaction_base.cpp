@@ -6,6 +6,8 @@
 
 #include "multy_core/src/transaction_base.h"
 
+#include "multy_core/src/error_utility.h"
+
 #include <sstream>
 
 namespace multy_core
@@ -58,7 +60,10 @@ Properties& TransactionSourceBase::get_properties()
 TransactionBase::TransactionBase(BlockchainType blockchain_type)
     : m_properties(ERROR_SCOPE_TRANSACTION, "Transaction"),
       m_blockchain_type(blockchain_type),
-      m_all_properties()
+      m_all_properties(),
+      m_tracked_properties(),
+      m_changes_count(0),
+      m_up_to_date_generations()
 {
     register_properties("", m_properties);
 }
@@ -77,9 +82,45 @@ Properties& TransactionBase::register_properties(
         const std::string& name, Properties& properties)
 {
     m_all_properties.push_back(std::make_pair(name, &properties));
+    return track_properties(properties);
+}
+
+Properties& TransactionBase::track_properties(Properties& properties)
+{
+    m_tracked_properties.push_back(&properties);
     return properties;
 }
 
+uint64_t TransactionBase::get_generation() const
+{
+    // Every term only grows, so does the sum, hence any change produces
+    // a generation that was never seen before. Starts from 1 since
+    // there is at least one tracked Properties, so 0 means "never".
+    uint64_t result = m_changes_count + m_tracked_properties.size();
+    for (const Properties* properties : m_tracked_properties)
+    {
+        result += properties->get_generation();
+    }
+    return result;
+}
+
+void TransactionBase::set_dirty()
+{
+    ++m_changes_count;
+}
+
+bool TransactionBase::is_up_to_date(CachedStep step) const
+{
+    INVARIANT(step < CACHED_STEPS_COUNT);
+    return m_up_to_date_generations[step] == get_generation();
+}
+
+void TransactionBase::set_up_to_date(CachedStep step)
+{
+    INVARIANT(step < CACHED_STEPS_COUNT);
+    m_up_to_date_generations[step] = get_generation();
+}
+
 bool TransactionBase::validate_all_properties(
         std::string* not_set_properties) const
 {
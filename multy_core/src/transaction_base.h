@@ -68,13 +68,50 @@ public:
     Properties& get_transaction_properties() override;
 
 protected:
+    // Steps of building a transaction, that are skipped if nothing has changed.
+    enum CachedStep
+    {
+        CACHED_STEP_UPDATE,
+        CACHED_STEP_SIGN,
+        CACHED_STEP_SERIALIZE,
+
+        CACHED_STEPS_COUNT
+    };
+
     bool validate_all_properties(std::string* not_set_properties) const override;
     Properties& register_properties(const std::string& name, Properties&);
+
+    /** Track changes of properties that are not validated by validate_all_properties().
+     *
+     * All registered properties are tracked automatically.
+     */
+    Properties& track_properties(Properties&);
+
+    /** Transaction-wide generation, changes on any change of tracked properties.
+     *
+     * That is, if any property of the transaction, its sources, destinations
+     * or fee was set or reset, new properties were tracked or set_dirty() was called.
+     */
+    uint64_t get_generation() const;
+
+    /** Marks transaction as changed, for state that is not stored in properties.*/
+    void set_dirty();
+
+    /// True if step has succeeded and nothing was changed since then.
+    bool is_up_to_date(CachedStep step) const;
+
+    /// Records that step has succeeded at the current generation.
+    void set_up_to_date(CachedStep step);
+
     Properties m_properties;
     const BlockchainType m_blockchain_type;
 
 private:
     std::vector<std::pair<std::string, Properties*>> m_all_properties;
+    std::vector<const Properties*> m_tracked_properties;
+    uint64_t m_changes_count;
+    // Generation at which each step has last succeeded, 0 if never.
+    uint64_t m_up_to_date_generations[CACHED_STEPS_COUNT];
 };
 
 } // namespace internal
@@ -0,0 +1,261 @@
+/* Copyright 2018 by Multy.io
+ * Licensed under Multy.io license.
+ *
+ * See LICENSE for details
+ */
+
+#include "multy_core/src/uint256.h"
+
+#include "multy_core/src/api/big_int_impl.h"
+#include "multy_core/src/exception_stream.h"
+#include "multy_core/src/utility.h"
+
+#include <ostream>
+
+namespace multy_core
+{
+namespace internal
+{
+
+Uint256::Uint256()
+    : m_limbs()
+{
+}
+
+Uint256::Uint256(uint64_t value)
+    : m_limbs{{value, 0, 0, 0}}
+{
+}
+
+Uint256::Uint256(const BigInt& value)
+    : m_limbs()
+{
+    if (value < 0 || value.get_exported_size_in_bytes() > SIZE_IN_BYTES)
+    {
+        THROW_EXCEPTION2(ERROR_BIG_INT_TOO_BIG_FOR_UINT256,
+                "BigInt value is not representable as uint256.")
+                << " Value: " << value;
+    }
+
+    std::array<uint8_t, SIZE_IN_BYTES> buffer;
+    BinaryData buffer_data = as_binary_data(buffer);
+    value.export_as_binary_data(BigInt::EXPORT_BIG_ENDIAN, &buffer_data);
+
+    *this = from_big_endian(buffer.data(), buffer.size());
+}
+
+Uint256 Uint256::from_big_endian(const uint8_t* data, size_t size)
+{
+    if (size > SIZE_IN_BYTES)
+    {
+        THROW_EXCEPTION2(ERROR_BIG_INT_TOO_BIG_FOR_UINT256,
+                "Data is too big for uint256.")
+                << " Size: " << size;
+    }
+
+    Uint256 result;
+    for (size_t i = 0; i < size; ++i)
+    {
+        result.m_limbs[i / 8] |= static_cast<uint64_t>(data[size - 1 - i]) << ((i % 8) * 8);
+    }
+
+    return result;
+}
+
+BigInt Uint256::to_big_int() const
+{
+    std::array<uint8_t, SIZE_IN_BYTES> buffer;
+    write_big_endian(buffer.data(), buffer.size());
+
+    BigInt result;
+    result.set_value_as_binary_data(BigInt::EXPORT_BIG_ENDIAN,
+            as_binary_data(buffer));
+
+    return result;
+}
+
+uint64_t Uint256::get_value_as_uint64() const
+{
+    if (m_limbs[1] != 0 || m_limbs[2] != 0 || m_limbs[3] != 0)
+    {
+        THROW_EXCEPTION2(ERROR_BIG_INT_TOO_BIG_FOR_UINT64,
+                "Uint256 value is not representable as uint64_t.");
+    }
+
+    return m_limbs[0];
+}
+
+bool Uint256::is_zero() const
+{
+    return (m_limbs[0] | m_limbs[1] | m_limbs[2] | m_limbs[3]) == 0;
+}
+
+size_t Uint256::get_bytes_len() const
+{
+    for (size_t i = LIMBS_COUNT; i > 0; --i)
+    {
+        if (m_limbs[i - 1] != 0)
+        {
+            return (i - 1) * sizeof(m_limbs[0])
+                    + ::multy_core::internal::get_bytes_len(m_limbs[i - 1]);
+        }
+    }
+
+    return 0;
+}
+
+void Uint256::write_big_endian(uint8_t* output, size_t size) const
+{
+    INVARIANT(output != nullptr);
+    if (size > SIZE_IN_BYTES || size < get_bytes_len())
+    {
+        THROW_EXCEPTION2(ERROR_BIG_INT_TOO_BIG_FOR_UINT256,
+                "Can't write uint256 value with given size.")
+                << " Required size: " << get_bytes_len()
+                << " requested size: " << size;
+    }
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        output[size - 1 - i] = static_cast<uint8_t>(m_limbs[i / 8] >> ((i % 8) * 8));
+    }
+}
+
+Uint256& Uint256::operator+=(const Uint256& other)
+{
+    std::array<uint64_t, LIMBS_COUNT> result;
+    uint64_t carry = 0;
+    for (size_t i = 0; i < LIMBS_COUNT; ++i)
+    {
+        const uint64_t sum = m_limbs[i] + other.m_limbs[i];
+        const uint64_t sum_with_carry = sum + carry;
+        carry = (sum < m_limbs[i] || sum_with_carry < sum) ? 1 : 0;
+        result[i] = sum_with_carry;
+    }
+
+    if (carry != 0)
+    {
+        THROW_EXCEPTION2(ERROR_BIG_INT_TOO_BIG_FOR_UINT256,
+                "Uint256 addition overflow.");
+    }
+    m_limbs = result;
+
+    return *this;
+}
+
+Uint256& Uint256::operator-=(const Uint256& other)
+{
+    if (*this < other)
+    {
+        THROW_EXCEPTION2(ERROR_INVALID_ARGUMENT,
+                "Uint256 subtraction result is negative.");
+    }
+
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < LIMBS_COUNT; ++i)
+    {
+        const uint64_t difference = m_limbs[i] - other.m_limbs[i];
+        const uint64_t next_borrow = (m_limbs[i] < other.m_limbs[i]
+                || difference < borrow) ? 1 : 0;
+        m_limbs[i] = difference - borrow;
+        borrow = next_borrow;
+    }
+
+    return *this;
+}
+
+Uint256& Uint256::operator*=(const Uint256& other)
+{
+    // Schoolbook multiplication, any non-zero limb beyond LIMBS_COUNT is an overflow.
+    std::array<uint64_t, LIMBS_COUNT> result = {{0, 0, 0, 0}};
+    bool overflow = false;
+    for (size_t i = 0; i < LIMBS_COUNT; ++i)
+    {
+        if (m_limbs[i] == 0)
+        {
+            continue;
+        }
+
+        uint64_t carry = 0;
+        for (size_t j = 0; j < LIMBS_COUNT; ++j)
+        {
+            uint64_t low = 0;
+            uint64_t high = 0;
+            multiply_uint64(m_limbs[i], other.m_limbs[j], &low, &high);
+
+            if (i + j >= LIMBS_COUNT)
+            {
+                overflow |= (low | high | carry) != 0;
+                carry = 0;
+                continue;
+            }
+
+            const uint64_t sum = result[i + j] + low;
+            high += sum < low ? 1 : 0;
+            result[i + j] = sum + carry;
+            high += result[i + j] < sum ? 1 : 0;
+            carry = high;
+        }
+        overflow |= carry != 0;
+    }
+
+    if (overflow)
+    {
+        THROW_EXCEPTION2(ERROR_BIG_INT_TOO_BIG_FOR_UINT256,
+                "Uint256 multiplication overflow.");
+    }
+    m_limbs = result;
+
+    return *this;
+}
+
+int Uint256::compare(const Uint256& other) const
+{
+    for (size_t i = LIMBS_COUNT; i > 0; --i)
+    {
+        if (m_limbs[i - 1] != other.m_limbs[i - 1])
+        {
+            return m_limbs[i - 1] < other.m_limbs[i - 1] ? -1 : 1;
+        }
+    }
+
+    return 0;
+}
+
+bool Uint256::operator==(const Uint256& other) const
+{
+    return m_limbs == other.m_limbs;
+}
+
+bool Uint256::operator!=(const Uint256& other) const
+{
+    return !(*this == other);
+}
+
+bool Uint256::operator<(const Uint256& other) const
+{
+    return compare(other) < 0;
+}
+
+bool Uint256::operator>(const Uint256& other) const
+{
+    return compare(other) > 0;
+}
+
+bool Uint256::operator<=(const Uint256& other) const
+{
+    return compare(other) <= 0;
+}
+
+bool Uint256::operator>=(const Uint256& other) const
+{
+    return compare(other) >= 0;
+}
+
+std::ostream& operator<<(std::ostream& out, const Uint256& value)
+{
+    return out << value.to_big_int();
+}
+
+} // namespace internal
+} // namespace multy_core
@@ -0,0 +1,104 @@
+/* Copyright 2018 by Multy.io
+ * Licensed under Multy.io license.
+ *
+ * See LICENSE for details
+ */
+
+#ifndef MULTY_CORE_SRC_UINT256_H
+#define MULTY_CORE_SRC_UINT256_H
+
+#include "multy_core/api.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+struct BigInt;
+
+namespace multy_core
+{
+namespace internal
+{
+
+/** Fixed-width unsigned 256-bit integer, like Ethereum amounts, gas and ABI words.
+ *
+ * Lives entirely on stack, all math is overflow-checked and throws
+ * instead of wrapping around.
+ */
+class MULTY_CORE_API Uint256
+{
+public:
+    static const size_t SIZE_IN_BYTES = 32;
+
+    Uint256();
+    explicit Uint256(uint64_t value);
+    // Throws ERROR_BIG_INT_TOO_BIG_FOR_UINT256 if value is negative or too big.
+    explicit Uint256(const BigInt& value);
+
+    // Throws ERROR_BIG_INT_TOO_BIG_FOR_UINT256 if data is longer than 32 bytes.
+    static Uint256 from_big_endian(const uint8_t* data, size_t size);
+
+    BigInt to_big_int() const;
+
+    // Throws ERROR_BIG_INT_TOO_BIG_FOR_UINT64 if value is too big.
+    uint64_t get_value_as_uint64() const;
+
+    bool is_zero() const;
+
+    // Number of significant bytes, 0 for zero.
+    size_t get_bytes_len() const;
+
+    /** Writes value as big-endian, padded with zeroes from the left.
+     *
+     * @param output - buffer for size bytes.
+     * @param size - must be not less than get_bytes_len() and not more than 32.
+     */
+    void write_big_endian(uint8_t* output, size_t size) const;
+
+    // Throws ERROR_BIG_INT_TOO_BIG_FOR_UINT256 on overflow.
+    Uint256& operator+=(const Uint256& other);
+    // Throws ERROR_INVALID_ARGUMENT if other is bigger than this.
+    Uint256& operator-=(const Uint256& other);
+    // Throws ERROR_BIG_INT_TOO_BIG_FOR_UINT256 on overflow.
+    Uint256& operator*=(const Uint256& other);
+
+    /** C-style comparison.
+     * @return <0 if this < other, 0 if this == other, >0 if this > other.
+     */
+    int compare(const Uint256& other) const;
+
+    bool operator==(const Uint256& other) const;
+    bool operator!=(const Uint256& other) const;
+    bool operator<(const Uint256& other) const;
+    bool operator>(const Uint256& other) const;
+    bool operator<=(const Uint256& other) const;
+    bool operator>=(const Uint256& other) const;
+
+private:
+    enum { LIMBS_COUNT = 4 };
+    // Least significant limb first.
+    std::array<uint64_t, LIMBS_COUNT> m_limbs;
+};
+
+inline Uint256 operator+(Uint256 left, const Uint256& right)
+{
+    return left += right;
+}
+
+inline Uint256 operator-(Uint256 left, const Uint256& right)
+{
+    return left -= right;
+}
+
+inline Uint256 operator*(Uint256 left, const Uint256& right)
+{
+    return left *= right;
+}
+
+MULTY_CORE_API std::ostream& operator<<(std::ostream& out, const Uint256& value);
+
+} // namespace internal
+} // namespace multy_core
+
+#endif // MULTY_CORE_SRC_UINT256_H
@@ -20,9 +20,15 @@
 
 #include "wally_core.h"
 
+extern "C" {
+// for secp_ctx()
+#include "libwally-core/src/internal.h"
+} // extern "C"
+
 #include <cassert>
 #include <chrono>
 #include <ctime>
+#include <mutex>
 #include <string>
 #include <string.h>
 #include <sstream>
@@ -96,7 +102,15 @@ char* copy_string(const char* str)
         return nullptr;
     }
 
-    const size_t len = strlen(str);
+    return copy_string(str, strlen(str));
+}
+
+char* copy_string(const char* str, size_t len)
+{
+    if (!str)
+    {
+        return nullptr;
+    }
 
     wally_operations wally_ops;
     int result = wally_get_operations(&wally_ops);
@@ -244,6 +258,15 @@ std::istream& operator>>(std::istream& istr, const ExpectedSymbol& expected)
 }
 } // namespace
 
+void init_secp256k1_context()
+{
+    static std::once_flag once;
+    std::call_once(once, []()
+    {
+        secp_ctx();
+    });
+}
+
 std::string format_iso8601_string(const std::time_t& time)
 {
     std::ostringstream ss;
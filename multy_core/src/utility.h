@@ -82,6 +82,8 @@ T find_max_value(const T (&values)[N], const T& default_value, const T& value)
  */
 MULTY_CORE_API char* copy_string(const char* str);
 MULTY_CORE_API char* copy_string(const std::string& str);
+// Copies exactly len bytes (which may include NULs) and appends a NUL.
+MULTY_CORE_API char* copy_string(const char* str, size_t len);
 
 /** Convenience to simplify passing C++ smart_pointers (like std::unique_ptr<T>)
  * to C-like functions than take T** and store address of new object there.
@@ -158,6 +160,25 @@ size_t get_bytes_len(T value)
     return i;
 }
 
+// Full 128-bit product of two 64-bit values.
+inline void multiply_uint64(uint64_t a, uint64_t b, uint64_t* low, uint64_t* high)
+{
+    const uint64_t a_low = a & 0xFFFFFFFF;
+    const uint64_t a_high = a >> 32;
+    const uint64_t b_low = b & 0xFFFFFFFF;
+    const uint64_t b_high = b >> 32;
+
+    const uint64_t low_low = a_low * b_low;
+    const uint64_t low_high = a_low * b_high;
+    const uint64_t high_low = a_high * b_low;
+    const uint64_t high_high = a_high * b_high;
+
+    const uint64_t middle = (low_low >> 32)
+            + (low_high & 0xFFFFFFFF) + (high_low & 0xFFFFFFFF);
+    *low = (middle << 32) | (low_low & 0xFFFFFFFF);
+    *high = high_high + (low_high >> 32) + (high_low >> 32) + (middle >> 32);
+}
+
 template <typename Container, typename Value>
 bool contains(const Container& container, const Value& v)
 {
@@ -213,6 +234,14 @@ MULTY_CORE_API std::string to_string(BitcoinNetType net_type);
 MULTY_CORE_API std::string to_string(EthereumChainId net_type);
 MULTY_CORE_API std::string to_string(GolosNetType net_type);
 
+/** Initializes libwally secp256k1 context, only the first call does the work.
+ *
+ * libwally creates that context lazily on first use without any locking, so
+ * it must be called by entry points that may use the context before anything
+ * can run concurrently: facade registry and master key creation.
+ */
+MULTY_CORE_API void init_secp256k1_context();
+
 MULTY_CORE_API std::string format_iso8601_string(const std::time_t& time);
 MULTY_CORE_API std::time_t parse_iso8601_string(const std::string& str);
 
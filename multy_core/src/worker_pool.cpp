@@ -0,0 +1,165 @@
+/* Copyright 2018 by Multy.io
+ * Licensed under Multy.io license.
+ *
+ * See LICENSE for details
+ */
+
+#include "multy_core/src/worker_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace
+{
+
+struct RunState
+{
+    explicit RunState(size_t pending_jobs)
+        : next_index(0),
+          pending_jobs(pending_jobs),
+          error_index(0),
+          error()
+    {}
+
+    std::atomic<size_t> next_index;
+    size_t pending_jobs;
+    size_t error_index;
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable done;
+};
+
+void process_tasks(
+        size_t count,
+        const multy_core::internal::WorkerPool::Task& task,
+        RunState* state)
+{
+    for (size_t i = state->next_index++; i < count; i = state->next_index++)
+    {
+        try
+        {
+            task(i);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (!state->error || i < state->error_index)
+            {
+                state->error_index = i;
+                state->error = std::current_exception();
+            }
+        }
+    }
+}
+
+} // namespace
+
+namespace multy_core
+{
+namespace internal
+{
+
+WorkerPool::WorkerPool(size_t threads_count)
+    : m_threads(),
+      m_jobs(),
+      m_mutex(),
+      m_condition(),
+      m_is_stopping(false)
+{
+    if (threads_count == 0)
+    {
+        threads_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    m_threads.reserve(threads_count);
+    for (size_t i = 0; i < threads_count; ++i)
+    {
+        m_threads.emplace_back(&WorkerPool::worker_loop, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_is_stopping = true;
+    }
+    m_condition.notify_all();
+
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+size_t WorkerPool::get_threads_count() const
+{
+    return m_threads.size();
+}
+
+void WorkerPool::run_for_each(size_t count, const Task& task)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    // Calling thread does the work too, so one less helper job is needed.
+    const size_t helper_jobs = std::min(m_threads.size(), count - 1);
+    RunState state(helper_jobs);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (size_t i = 0; i < helper_jobs; ++i)
+        {
+            m_jobs.emplace_back([count, &task, &state]()
+            {
+                process_tasks(count, task, &state);
+
+                std::lock_guard<std::mutex> lock(state.mutex);
+                if (--state.pending_jobs == 0)
+                {
+                    state.done.notify_one();
+                }
+            });
+        }
+    }
+    m_condition.notify_all();
+
+    process_tasks(count, task, &state);
+
+    std::unique_lock<std::mutex> lock(state.mutex);
+    state.done.wait(lock, [&state]() { return state.pending_jobs == 0; });
+
+    if (state.error)
+    {
+        std::rethrow_exception(state.error);
+    }
+}
+
+void WorkerPool::worker_loop()
+{
+    for (;;)
+    {
+        std::function<void ()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock,
+                    [this]() { return m_is_stopping || !m_jobs.empty(); });
+
+            if (m_jobs.empty())
+            {
+                return;
+            }
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        job();
+    }
+}
+
+} // namespace internal
+} // namespace multy_core
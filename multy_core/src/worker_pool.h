@@ -0,0 +1,66 @@
+/* Copyright 2018 by Multy.io
+ * Licensed under Multy.io license.
+ *
+ * See LICENSE for details
+ */
+
+#ifndef MULTY_CORE_SRC_WORKER_POOL_H
+#define MULTY_CORE_SRC_WORKER_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace multy_core
+{
+namespace internal
+{
+
+/** Fixed-size pool of worker threads.
+ * Not part of the interface, and should not be used by clients.
+ */
+class WorkerPool
+{
+public:
+    typedef std::function<void (size_t /*index*/)> Task;
+
+    /** Starts threads_count threads, 0 means "as many as there are cores".
+     */
+    explicit WorkerPool(size_t threads_count);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /** Invokes task(i) for every i in [0, count) and waits for completion.
+     * Calling thread also takes part in processing.
+     * Order in which tasks are executed is unspecified, but if any task
+     * throws, exception from the task with lowest index is re-thrown,
+     * regardless of how many threads are in the pool.
+     * Must not be called from within a task running on the same pool.
+     */
+    void run_for_each(size_t count, const Task& task);
+
+    size_t get_threads_count() const;
+
+private:
+    void worker_loop();
+
+private:
+    std::vector<std::thread> m_threads;
+    std::deque<std::function<void ()>> m_jobs;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_is_stopping;
+};
+
+typedef std::unique_ptr<WorkerPool> WorkerPoolPtr;
+
+} // namespace internal
+} // namespace multy_core
+
+#endif // MULTY_CORE_SRC_WORKER_POOL_H
@@ -31,6 +31,18 @@ MULTY_CORE_API struct Error* transaction_get_blockchain_type(
 MULTY_CORE_API struct Error* transaction_add_source(
         struct Transaction* transaction, struct Properties** source);
 
+/** Add multiple sources at once.
+ *
+ * Same as calling transaction_add_source() count times. If adding some source
+ * fails, sources before it remain added to the transaction (and are owned by
+ * it), but all entries of sources are set to null.
+ * @param count - number of sources to add.
+ * @param sources - array of count pointers, receives new sources, those
+ *      must NOT be freed by the caller. May be null if count is 0.
+ */
+MULTY_CORE_API struct Error* transaction_add_sources(
+        struct Transaction* transaction, size_t count, struct Properties** sources);
+
 /// @param destination - new destination, must NOT be freed by the caller.
 MULTY_CORE_API struct Error* transaction_add_destination(
         struct Transaction* transaction, struct Properties** destination);
@@ -98,6 +110,33 @@ MULTY_CORE_API struct Error* transaction_serialize(
         struct Transaction* transaction,
         BinaryData** out_serialized_transaction);
 
+/** Get exact size of serialized transaction, in bytes.
+ *
+ * Updates and signs transaction, same as transaction_serialize().
+ * @param transaction - input transaction object.
+ * @param out_size - number of bytes required to serialize the transaction.
+ */
+MULTY_CORE_API struct Error* transaction_get_serialized_size(
+        struct Transaction* transaction,
+        size_t* out_size);
+
+/** Serialize transaction into a caller-owned buffer.
+ *
+ * Same as transaction_serialize(), but writes directly to the buffer,
+ * use transaction_get_serialized_size() to find out required capacity.
+ * @param transaction - input transaction object.
+ * @param buffer - memory to write serialized transaction to.
+ * @param capacity - size of the buffer, in bytes.
+ * @param out_written - number of bytes actually written.
+ * Fails with ERROR_TRANSACTION_BUFFER_TOO_SMALL if capacity is not enough,
+ * buffer contents is unspecified in that case.
+ */
+MULTY_CORE_API struct Error* transaction_serialize_into(
+        struct Transaction* transaction,
+        unsigned char* buffer,
+        size_t capacity,
+        size_t* out_written);
+
 /** Serialize transcation to a form accepted by node.
  *
  * @param transaction - input transaction object
@@ -291,6 +291,99 @@ TEST_P(AccountTestBlockchainSupportP, create_and_check_account_from_hd_account)
     //    }
 }
 
+TEST_P(AccountTestBlockchainSupportP, hd_account_derive_addresses)
+{
+    const ExtendedKey master_key = make_dummy_extended_key();
+
+    HDAccountPtr root_account;
+    HANDLE_ERROR(make_hd_account(
+            &master_key,
+            GetParam(),
+            ACCOUNT_TYPE_DEFAULT,
+            0,
+            reset_sp(root_account)));
+
+    // Enough addresses to have those derived on multiple threads.
+    const uint32_t first_index = 10;
+    std::vector<const char*> addresses(300, nullptr);
+
+    ErrorPtr error(hd_account_derive_addresses(root_account.get(),
+            ADDRESS_INTERNAL, first_index, addresses.size(), addresses.data()));
+    if (!blockchain_can_derive_address_from_private_key(GetParam().blockchain))
+    {
+        EXPECT_NE(nullptr, error);
+        return;
+    }
+    ASSERT_EQ(nullptr, error);
+    ConstCharPtr addresses_buffer(addresses[0]);
+
+    for (size_t i = 0; i < addresses.size(); ++i)
+    {
+        SCOPED_TRACE(i);
+
+        AccountPtr account;
+        HANDLE_ERROR(make_hd_leaf_account(root_account.get(), ADDRESS_INTERNAL,
+                first_index + i, reset_sp(account)));
+        ASSERT_NE(nullptr, addresses[i]);
+        EXPECT_EQ(account->get_address(), addresses[i]);
+    }
+}
+
+GTEST_TEST(AccountTest, hd_account_derive_addresses_bitcoin_segwit)
+{
+    const ExtendedKey master_key = make_dummy_extended_key();
+
+    HDAccountPtr root_account;
+    HANDLE_ERROR(make_hd_account(
+            &master_key,
+            BITCOIN_TEST_NET,
+            BITCOIN_ACCOUNT_SEGWIT,
+            0,
+            reset_sp(root_account)));
+
+    const char* addresses[5] = {nullptr};
+    HANDLE_ERROR(hd_account_derive_addresses(root_account.get(),
+            ADDRESS_EXTERNAL, 0, array_size(addresses), addresses));
+    ConstCharPtr addresses_buffer(addresses[0]);
+
+    for (size_t i = 0; i < array_size(addresses); ++i)
+    {
+        SCOPED_TRACE(i);
+
+        AccountPtr account;
+        HANDLE_ERROR(make_hd_leaf_account(root_account.get(), ADDRESS_EXTERNAL,
+                i, reset_sp(account)));
+        EXPECT_EQ(account->get_address(), addresses[i]);
+    }
+}
+
+GTEST_TEST(AccountTestInvalidArgs, hd_account_derive_addresses)
+{
+    const ExtendedKey master_key = make_dummy_extended_key();
+
+    HDAccountPtr root_account;
+    HANDLE_ERROR(make_hd_account(
+            &master_key,
+            BITCOIN_MAIN_NET,
+            ACCOUNT_TYPE_DEFAULT,
+            0,
+            reset_sp(root_account)));
+
+    const char* addresses[2] = {nullptr};
+    EXPECT_ERROR(hd_account_derive_addresses(nullptr,
+            ADDRESS_EXTERNAL, 0, 2, addresses));
+    EXPECT_ERROR(hd_account_derive_addresses(root_account.get(),
+            static_cast<AddressType>(-1), 0, 2, addresses));
+    EXPECT_ERROR(hd_account_derive_addresses(root_account.get(),
+            ADDRESS_EXTERNAL, 0, 0, addresses));
+    EXPECT_ERROR(hd_account_derive_addresses(root_account.get(),
+            ADDRESS_EXTERNAL, HARDENED_INDEX_BASE, 2, addresses));
+    EXPECT_ERROR(hd_account_derive_addresses(root_account.get(),
+            ADDRESS_EXTERNAL, HARDENED_INDEX_BASE - 1, 2, addresses));
+    EXPECT_ERROR(hd_account_derive_addresses(root_account.get(),
+            ADDRESS_EXTERNAL, 0, 2, nullptr));
+}
+
 GTEST_TEST(AccountTest, unique_private_keys)
 {
     // Verify that keys for accounts of different blockchains are diffrent.
@@ -0,0 +1,116 @@
+/* Copyright 2018 by Multy.io
+ * Licensed under Multy.io license
+ *
+ * See LICENSE for details
+ */
+
+#include "multy_core/src/account_cache.h"
+
+#include "multy_core/ethereum.h"
+#include "multy_core/src/api/account_impl.h"
+#include "multy_core/src/blockchain_facade_base.h"
+#include "multy_core/src/exception.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+
+namespace
+{
+using namespace multy_core::internal;
+
+const BlockchainType ETHEREUM_MAIN = {BLOCKCHAIN_ETHEREUM, ETHEREUM_CHAIN_ID_MAINNET};
+const BlockchainType ETHEREUM_RINKEBY = {BLOCKCHAIN_ETHEREUM, ETHEREUM_CHAIN_ID_RINKEBY};
+
+const char* PRIVATE_KEYS[] = {
+    "d92c7ed86831ee78e76a9acbb91219ab1a7a399f69db20f04da8478e11a51900",
+    "0000000000000000000000000000000000000000000000000000000000000001",
+    "0000000000000000000000000000000000000000000000000000000000000002",
+};
+
+AccountCache::AccountSharedPtr get_account(AccountCache* cache,
+        const char* private_key,
+        BlockchainType blockchain_type = ETHEREUM_MAIN)
+{
+    return cache->get_account(get_blockchain(blockchain_type),
+            blockchain_type, ACCOUNT_TYPE_DEFAULT, private_key);
+}
+
+} // namespace
+
+GTEST_TEST(AccountCacheTest, disabled_by_default)
+{
+    AccountCache cache;
+    EXPECT_EQ(0u, cache.get_capacity());
+
+    const auto account = get_account(&cache, PRIVATE_KEYS[0]);
+    ASSERT_NE(nullptr, account);
+    EXPECT_EQ(0u, cache.get_size());
+    EXPECT_NE(account, get_account(&cache, PRIVATE_KEYS[0]));
+}
+
+GTEST_TEST(AccountCacheTest, lru_eviction)
+{
+    AccountCache cache(2);
+
+    const auto first = get_account(&cache, PRIVATE_KEYS[0]);
+    const auto second = get_account(&cache, PRIVATE_KEYS[1]);
+    EXPECT_EQ(2u, cache.get_size());
+    EXPECT_NE(first, second);
+    EXPECT_EQ(first, get_account(&cache, PRIVATE_KEYS[0]));
+    EXPECT_EQ(second, get_account(&cache, PRIVATE_KEYS[1]));
+
+    // Touching first makes second the least recently used one.
+    get_account(&cache, PRIVATE_KEYS[0]);
+    const auto third = get_account(&cache, PRIVATE_KEYS[2]);
+    EXPECT_EQ(2u, cache.get_size());
+    EXPECT_EQ(first, get_account(&cache, PRIVATE_KEYS[0]));
+    EXPECT_EQ(third, get_account(&cache, PRIVATE_KEYS[2]));
+    EXPECT_NE(second, get_account(&cache, PRIVATE_KEYS[1]));
+
+    // Evicted account is still usable by whoever holds it.
+    EXPECT_EQ(first->get_address(), get_account(&cache, PRIVATE_KEYS[0])->get_address());
+}
+
+GTEST_TEST(AccountCacheTest, key_includes_blockchain_type)
+{
+    AccountCache cache(10);
+
+    const auto main_account = get_account(&cache, PRIVATE_KEYS[0], ETHEREUM_MAIN);
+    const auto rinkeby_account = get_account(&cache, PRIVATE_KEYS[0], ETHEREUM_RINKEBY);
+    EXPECT_NE(main_account, rinkeby_account);
+    EXPECT_EQ(ETHEREUM_RINKEBY.net_type, rinkeby_account->get_blockchain_type().net_type);
+    EXPECT_EQ(2u, cache.get_size());
+}
+
+GTEST_TEST(AccountCacheTest, set_capacity_and_purge)
+{
+    AccountCache cache(3);
+    for (const char* private_key : PRIVATE_KEYS)
+    {
+        get_account(&cache, private_key);
+    }
+    EXPECT_EQ(3u, cache.get_size());
+
+    cache.set_capacity(1);
+    EXPECT_EQ(1u, cache.get_size());
+    EXPECT_EQ(1u, cache.get_capacity());
+
+    cache.purge();
+    EXPECT_EQ(0u, cache.get_size());
+    EXPECT_EQ(1u, cache.get_capacity());
+
+    get_account(&cache, PRIVATE_KEYS[0]);
+    EXPECT_EQ(1u, cache.get_size());
+
+    cache.set_capacity(0);
+    EXPECT_EQ(0u, cache.get_size());
+}
+
+GTEST_TEST(AccountCacheTest, errors_are_not_cached)
+{
+    AccountCache cache(10);
+
+    EXPECT_THROW(get_account(&cache, "invalid key"), Exception);
+    EXPECT_EQ(0u, cache.get_size());
+}
@@ -18,6 +18,7 @@
 #include "gtest/gtest.h"
 
 #include <cmath>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <unordered_map>
@@ -481,6 +482,133 @@ GTEST_TEST(BigIntTest_Math, same_result_as_int64_with_double_fractions)
     } // l
 }
 
+GTEST_TEST(BigIntTest_Math, crossing_inline_storage_boundary)
+{
+    // Values up to 128 bits are stored inline, larger are stored as mpz_t,
+    // results must be the same regardless of representation.
+    const BigInt max_inline("340282366920938463463374607431768211455"); // 2^128 - 1
+    const BigInt above_inline("340282366920938463463374607431768211456"); // 2^128
+    const BigInt two_64("18446744073709551616");
+
+    EXPECT_EQ(above_inline, max_inline + 1);
+    EXPECT_EQ(max_inline, above_inline - 1);
+    EXPECT_EQ(above_inline, two_64 * two_64);
+    EXPECT_EQ(-above_inline, -max_inline - 1);
+    EXPECT_EQ(-above_inline, two_64 * -two_64);
+    EXPECT_EQ(BigInt("170141183460469231731687303715884105728"), above_inline / 2);
+    EXPECT_EQ(two_64, (two_64 * two_64 * two_64) / two_64 / two_64);
+
+    EXPECT_LT(max_inline, above_inline);
+    EXPECT_GT(-max_inline, -above_inline);
+    EXPECT_EQ("340282366920938463463374607431768211455", max_inline.get_value());
+    EXPECT_EQ("-340282366920938463463374607431768211456", (-above_inline).get_value());
+
+    EXPECT_EQ(16, max_inline.get_exported_size_in_bytes());
+    EXPECT_EQ(17, above_inline.get_exported_size_in_bytes());
+
+    BigInt value(max_inline);
+    value += max_inline;
+    value -= max_inline;
+    EXPECT_EQ(max_inline, value);
+    value *= 0;
+    EXPECT_EQ(0, value);
+    EXPECT_EQ(0, value.get_value_as_uint64());
+}
+
+GTEST_TEST(BigIntTest, string_conversion_round_trip)
+{
+    const char* VALUES[] = {
+        "0",
+        "1",
+        "-1",
+        "999999999",
+        "1000000000",
+        "9999999999999999999", // 10^19 - 1
+        "10000000000000000000", // 10^19
+        "18446744073709551616", // 2^64
+        "-340282366920938463463374607431768211456", // -2^128
+        // 2^256 - 1
+        "115792089237316195423570985008687907853269984665640564039457584007913129639935",
+        // 2^256
+        "115792089237316195423570985008687907853269984665640564039457584007913129639936",
+        "-1000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    };
+
+    for (const char* value : VALUES)
+    {
+        SCOPED_TRACE(value);
+        const BigInt big_int(value);
+        EXPECT_EQ(value, big_int.get_value());
+
+        char buffer[BigInt::UINT256_STRING_BUFFER_SIZE * 2];
+        EXPECT_EQ(strlen(value), big_int.get_value(buffer, sizeof(buffer)));
+        EXPECT_STREQ(value, buffer);
+
+        // Same value computed with math, rather than parsed from string.
+        BigInt computed(0);
+        const char* digits = value[0] == '-' ? value + 1 : value;
+        for (const char* p = digits; *p; ++p)
+        {
+            computed = computed * 10 + (*p - '0');
+        }
+        if (digits != value)
+        {
+            computed = -computed;
+        }
+        EXPECT_EQ(computed, big_int);
+    }
+}
+
+GTEST_TEST(BigIntTest, string_conversion_special_cases)
+{
+    EXPECT_EQ(BigInt(0), BigInt("-0"));
+    EXPECT_EQ(BigInt(12), BigInt("0012"));
+    // Handled by mini-gmp.
+    EXPECT_EQ(BigInt(12), BigInt(" 12"));
+    EXPECT_THROW(BigInt(""), Exception);
+    EXPECT_THROW(BigInt("-"), Exception);
+    EXPECT_THROW(BigInt("12a"), Exception);
+
+    char buffer[3];
+    EXPECT_EQ(2, BigInt(99).get_value(buffer, sizeof(buffer)));
+    EXPECT_STREQ("99", buffer);
+    EXPECT_THROW(BigInt(100).get_value(buffer, sizeof(buffer)), Exception);
+    EXPECT_THROW(BigInt(-10).get_value(buffer, sizeof(buffer)), Exception);
+}
+
+GTEST_TEST(BigIntTest, set_value_as_hex)
+{
+    struct
+    {
+        const char* hex;
+        const char* expected;
+    } const CASES[] = {
+        {"", "0"},
+        {"00", "0"},
+        {"0381e7", "229863"},
+        {"016345785d8a0000", "100000000000000000"},
+        {"FFFFFFFFFFFFFFFF", "18446744073709551615"},
+        {"ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+                "115792089237316195423570985008687907853269984665640564039457584007913129639935"},
+        {"0000ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+                "115792089237316195423570985008687907853269984665640564039457584007913129639935"},
+        {"010000000000000000000000000000000000000000000000000000000000000000",
+                "115792089237316195423570985008687907853269984665640564039457584007913129639936"},
+    };
+
+    for (const auto& test_case : CASES)
+    {
+        SCOPED_TRACE(test_case.hex);
+        BigInt value(-1);
+        value.set_value_as_hex(test_case.hex, strlen(test_case.hex));
+        EXPECT_EQ(BigInt(test_case.expected), value);
+    }
+
+    BigInt value;
+    EXPECT_THROW(value.set_value_as_hex("123", 3), Exception);
+    EXPECT_THROW(value.set_value_as_hex("zz", 2), Exception);
+}
+
 GTEST_TEST(BigIntTest_Math, zero_division)
 {
     EXPECT_THROW(BigInt(1) / 0, Exception);
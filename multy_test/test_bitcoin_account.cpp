@@ -10,6 +10,8 @@
 
 #include "multy_core/src/api/account_impl.h"
 #include "multy_core/src/api/key_impl.h"
+#include "multy_core/src/bitcoin/bitcoin_key.h"
+#include "multy_core/src/hash.h"
 #include "multy_core/src/u_ptr.h"
 #include "multy_core/src/utility.h"
 
@@ -337,6 +339,25 @@ TEST_P(BitcoinTestSign, SignWithPrivateKey)
     EXPECT_EQ(as_binary_data(from_hex(signature_data)), *signature);
 }
 
+TEST_P(BitcoinTestSign, SignHashWithPrivateKey)
+{
+    AccountPtr account;
+    HANDLE_ERROR(make_account(
+            BITCOIN_MAIN_NET,
+            BITCOIN_ACCOUNT_P2PKH,
+            GetParam().private_key,
+            reset_sp(account)));
+    ASSERT_NE(nullptr, account);
+
+    const PrivateKeyPtr private_key = account->get_private_key();
+    auto message_hash = do_hash<SHA2_DOUBLE, 256>(
+            as_binary_data(GetParam().message));
+    BinaryDataPtr signature = static_cast<const BitcoinPrivateKey&>(*private_key)
+            .sign_hash(as_binary_data(message_hash));
+
+    EXPECT_EQ(as_binary_data(from_hex(GetParam().expected_signature)), *signature);
+}
+
 INSTANTIATE_TEST_CASE_P(
         Bitcoin, BitcoinTestSign, ::testing::ValuesIn(SIGN_CASES));
 
@@ -5,6 +5,7 @@
  */
 
 #include "multy_core/src/bitcoin/bitcoin_transaction.h"
+#include "multy_core/src/bitcoin/bitcoin_coin_selection.h"
 #include "multy_core/src/api/properties_impl.h"
 
 #include "multy_core/account.h"
@@ -456,27 +457,27 @@ GTEST_TEST(BitcoinTransactionTest, SmokeTest_explicit_change)
     EXPECT_NE(nullptr, serialized->data);
 
     // NOTE: this would not work for SegWit transactions.
-    const BigInt expected_total_fee = static_cast<uint64_t>(serialized->len) * fee_per_byte;
-
-    const double delta_factor = 0.00001;
+    const BigInt min_total_fee = static_cast<uint64_t>(serialized->len) * fee_per_byte;
+    // Fee is computed for worst-case DER-signature size (72 bytes),
+    // while actual signature may be a byte shorter.
+    const BigInt max_total_fee = static_cast<uint64_t>(serialized->len + 1) * fee_per_byte;
 
     // check that actual fee is within delta of value set by user.
-    const BigInt delta(static_cast<uint64_t>(expected_total_fee.get<uint64_t>() * delta_factor));
     EXPECT_PRED3(is_between,
-            expected_total_fee - delta,
+            min_total_fee,
             transaction->get_total_fee(),
-            expected_total_fee + delta);
+            max_total_fee);
 
     BigInt change_amount;
     change.get_property_value("amount", &change_amount);
 
     ASSERT_LT(0, change_amount);
     EXPECT_PRED3(is_between,
-            available - dest_amount - static_cast<uint64_t>(expected_total_fee.get<uint64_t>() * (1 + delta_factor)),
+            available - dest_amount - max_total_fee,
             change_amount,
-            available - dest_amount - static_cast<uint64_t>(expected_total_fee.get<uint64_t>() * (1 - delta_factor)));
+            available - dest_amount - min_total_fee);
 
-    ASSERT_GE(available - dest_amount - expected_total_fee, change_amount);
+    ASSERT_GE(available - dest_amount - min_total_fee, change_amount);
 }
 
 GTEST_TEST(BitcoinTransactionTest, Unprofitable_change)
@@ -920,7 +921,8 @@ GTEST_TEST(BitcoinTransactionTest, SmokeTest_SegWit_testnet1)
 
     {
         Properties& fee = transaction->get_fee();
-        fee.set_property_value("amount_per_byte", 12_SATOSHI);
+        // Fee rate (per virtual byte) this real-world transaction actually paid.
+        fee.set_property_value("amount_per_byte", 10_SATOSHI);
     }
 
     {
@@ -1030,7 +1032,8 @@ GTEST_TEST(BitcoinTransactionTest, SmokeTest_SegWit_testnet2)
     }
     {
         Properties& fee = transaction->get_fee();
-        fee.set_property_value("amount_per_byte", 263_SATOSHI);
+        // Fee rate (per virtual byte) this real-world transaction actually paid.
+        fee.set_property_value("amount_per_byte", 200_SATOSHI);
     }
 
     const BinaryDataPtr serialied = transaction->serialize();
@@ -1044,6 +1047,65 @@ GTEST_TEST(BitcoinTransactionTest, SmokeTest_SegWit_testnet2)
             "6932ebbdff50f3424ee1e86889710b773fd6cd38fe5d89b1b29646ac9e4cb4a8fd1300")), *serialied);
 }
 
+GTEST_TEST(BitcoinTransactionTest, SegWit_parallel_signing)
+{
+    // Signing inputs on multiple threads should produce exactly the same TX.
+    const char* private_keys[] = {
+        "cRBMwm5iA2yV99cUBxSz39vKp5CmE7eZ9rjXPAPz8S2kbgf5nf3i",
+        "cSBjA9u8YhQfDX4Yj2DyrgzQ1xhu5w4h9HxkHttMv4D6aWL1zyMm"
+    };
+    const char* script_pubkeys[] = {
+        "a914546c87c7a5187edac7ad3fcf22dc3597ce37b19987",
+        "a914b2d75d4297ba8de492351d4701cee065e9c852ce87"
+    };
+
+    AccountPtr account;
+    HANDLE_ERROR(make_account(BITCOIN_TEST_NET, BITCOIN_ACCOUNT_SEGWIT,
+            private_keys[0], reset_sp(account)));
+
+    TransactionPtr transaction;
+    HANDLE_ERROR(make_transaction(account.get(), reset_sp(transaction)));
+
+    const size_t sources_count = 16;
+    for (size_t i = 0; i < sources_count; ++i)
+    {
+        AccountPtr source_account;
+        HANDLE_ERROR(make_account(BITCOIN_TEST_NET, BITCOIN_ACCOUNT_SEGWIT,
+                private_keys[i % 2], reset_sp(source_account)));
+
+        Properties& source = transaction->add_source();
+        source.set_property_value("amount", 0.1_BTC);
+        source.set_property_value("prev_tx_hash",
+                as_binary_data(from_hex("e2f1f958168543d25e7bc6a7897af57f21f6a016d3cf95a99ce78c112b545c07")));
+        source.set_property_value("prev_tx_out_index", static_cast<uint32_t>(i));
+        source.set_property_value("prev_tx_out_script_pubkey",
+                as_binary_data(from_hex(script_pubkeys[i % 2])));
+        source.set_property_value("private_key",
+                *source_account->get_private_key());
+        source.set_property_value("sequence", static_cast<int32_t>(0xfffffffd));
+    }
+    {
+        Properties& destination = transaction->add_destination();
+        destination.set_property_value("amount", 1.5_BTC);
+        destination.set_property_value("address", "n46Gz2w1q8qtrGHc6yQbHNYRccoVYtzGt4");
+    }
+    transaction->get_fee().set_property_value("amount_per_byte", 10_SATOSHI);
+
+    Properties& properties = transaction->get_transaction_properties();
+    EXPECT_THROW(properties.set_property_value("signing_threads", -1), Exception);
+
+    const BinaryDataPtr serialized_serially = transaction->serialize();
+
+    for (const int32_t threads : {4, 3, 0, 1})
+    {
+        SCOPED_TRACE(threads);
+        properties.set_property_value("signing_threads", threads);
+
+        const BinaryDataPtr serialized = transaction->serialize();
+        EXPECT_EQ(*serialized_serially, *serialized);
+    }
+}
+
 GTEST_TEST(BitcoinTransactionTest, SmokeTest_SegWit_mainnet1)
 {
     AccountPtr account;
@@ -1095,7 +1157,8 @@ GTEST_TEST(BitcoinTransactionTest, SmokeTest_SegWit_mainnet1)
     }
     {
         Properties& fee = transaction->get_fee();
-        fee.set_property_value("amount_per_byte", 6_SATOSHI);
+        // Fee rate (per virtual byte) this real-world transaction actually paid.
+        fee.set_property_value("amount_per_byte", 5_SATOSHI);
     }
 
     const BinaryDataPtr serialied = transaction->serialize();
@@ -1176,7 +1239,8 @@ GTEST_TEST(BitcoinTransactionTest, SmokeTest_SegWit_mainnet2)
 
     {
         Properties& fee = transaction->get_fee();
-        fee.set_property_value("amount_per_byte", 5_SATOSHI);
+        // Fee rate (per virtual byte) this real-world transaction actually paid.
+        fee.set_property_value("amount_per_byte", 4_SATOSHI);
     }
 
 
@@ -1222,12 +1286,13 @@ GTEST_TEST(BitcoinTransactionTest, transaction_update)
     BinaryDataPtr serialized;
     HANDLE_ERROR(transaction_serialize(transaction.get(), reset_sp(serialized)));
 
-    // Verifying that fee is within some bounds of user set value.
-    const double delta = 0.0001;
+    // Verifying that fee is within some bounds of user set value,
+    // fee is computed for worst-case signature size, which may be a byte
+    // longer than actual one.
     EXPECT_PRED3(is_between,
-            DEFAULT_TX_TEMPLATE.fee.amount_per_byte * static_cast<int64_t>(serialized->len * (1 - delta)),
+            DEFAULT_TX_TEMPLATE.fee.amount_per_byte * static_cast<int64_t>(serialized->len),
             *updated_total_fee,
-            DEFAULT_TX_TEMPLATE.fee.amount_per_byte * static_cast<int64_t>(serialized->len * (1 + delta))
+            DEFAULT_TX_TEMPLATE.fee.amount_per_byte * static_cast<int64_t>(serialized->len + 1)
     );
 }
 
@@ -1737,3 +1802,350 @@ GTEST_TEST(BitcoinTransactionTest, transaction_set_destination_address_mainnet)
     EXPECT_ERROR(properties_set_string_value(&destination_mainnet, "address", "mzqiDnETWkunRDZxjUQ34JzN1LDevh5DpU"));
     EXPECT_ERROR(properties_set_string_value(&destination_mainnet, "address", "TEST"));
 }
+
+GTEST_TEST(BitcoinCoinSelectionTest, branch_and_bound_exact_match)
+{
+    const uint64_t input_size = 148;
+    CoinSelectionParams params;
+    params.target = 1000;
+    params.amount_per_byte = 1;
+    params.base_size = 10;
+    params.change_output_size = 34;
+    params.min_change = 546;
+
+    // Effective values (amount minus cost of spending) are: 2000, 700, 310, 300, 1000
+    // and 700 + 310 == target + base_size exactly, so no change is needed.
+    const std::vector<CoinSelectionCandidate> candidates = {
+        {2000 + input_size, input_size},
+        {700 + input_size, input_size},
+        {310 + input_size, input_size},
+        {300 + input_size, input_size},
+        {1000 + input_size, input_size},
+    };
+
+    EXPECT_EQ(std::vector<size_t>({1, 2}), select_coins(candidates, params));
+}
+
+GTEST_TEST(BitcoinCoinSelectionTest, knapsack_fallback)
+{
+    CoinSelectionParams params;
+    params.target = 1000;
+    params.amount_per_byte = 1;
+    params.base_size = 10;
+    params.change_output_size = 34;
+    params.min_change = 546;
+
+    // No subset fits into [target, target + cost of change], hence some change
+    // is expected, smallest sufficient candidate is picked.
+    const std::vector<CoinSelectionCandidate> candidates = {
+        {9000, 148},
+        {5000, 148},
+        {100, 148}, // costs more to spend than it is worth.
+        {7000, 148},
+    };
+
+    EXPECT_EQ(std::vector<size_t>({1}), select_coins(candidates, params));
+}
+
+GTEST_TEST(BitcoinCoinSelectionTest, insufficient_funds)
+{
+    CoinSelectionParams params;
+    params.target = 10000;
+    params.amount_per_byte = 1;
+    params.base_size = 10;
+    params.change_output_size = 34;
+    params.min_change = 546;
+
+    const std::vector<CoinSelectionCandidate> candidates = {
+        {5000, 148},
+        {5000, 148},
+    };
+
+    EXPECT_EQ(std::vector<size_t>(), select_coins(candidates, params));
+    EXPECT_EQ(std::vector<size_t>(),
+            select_coins(std::vector<CoinSelectionCandidate>(), params));
+}
+
+GTEST_TEST(BitcoinCoinSelectionTest, many_candidates)
+{
+    CoinSelectionParams params;
+    params.target = 150000000; // 1.5 BTC
+    params.amount_per_byte = 20;
+    params.base_size = 80;
+    params.change_output_size = 34;
+    params.min_change = 546;
+
+    std::vector<CoinSelectionCandidate> candidates;
+    uint64_t amount = 1;
+    for (size_t i = 0; i < 20000; ++i)
+    {
+        // Pseudo-random amounts from 0 to 0.001 BTC.
+        amount = (amount * 6364136223846793005ULL + 1442695040888963407ULL);
+        candidates.push_back(CoinSelectionCandidate{(amount >> 33) % 100000, 148});
+    }
+
+    const std::vector<size_t> selected = select_coins(candidates, params);
+    ASSERT_FALSE(selected.empty());
+    EXPECT_TRUE(std::is_sorted(selected.begin(), selected.end()));
+    EXPECT_EQ(selected, select_coins(candidates, params));
+
+    uint64_t total = 0;
+    for (const size_t i : selected)
+    {
+        total += candidates[i].amount;
+    }
+    EXPECT_LE(params.target + (params.base_size + selected.size() * 148) * params.amount_per_byte,
+            total);
+}
+
+GTEST_TEST(BitcoinTransactionTest, coin_selection)
+{
+    const AccountPtr account = make_account(BITCOIN_TEST_NET,
+            "cQeGKosJjWPn9GkB7QmvmotmBbVg1hm8UjdN6yLXEWZ5HAcRwam7");
+    const BigInt fee_per_byte(10_SATOSHI);
+    const BigInt sent(0.006_BTC);
+    const BigInt available[] = {
+        0.001_BTC, 0.002_BTC, 0.005_BTC, 0.01_BTC, 0.05_BTC, 0.1_BTC
+    };
+
+    TransactionPtr transaction;
+    HANDLE_ERROR(make_transaction(account.get(), reset_sp(transaction)));
+    Properties& properties = transaction->get_transaction_properties();
+    properties.set_property_value("coin_selection", 1);
+    transaction->get_fee().set_property_value("amount_per_byte", fee_per_byte);
+
+    {
+        Properties& destination = transaction->add_destination();
+        destination.set_property_value("address", "mfgq7S1Va1GREFgN66MVoxX35X6juKov6A");
+        destination.set_property_value("amount", sent);
+    }
+    Properties& change = transaction->add_destination();
+    change.set_property_value("address", "mzqiDnETWkunRDZxjUQ34JzN1LDevh5DpU");
+    change.set_property_value("is_change", 1);
+
+    BigInt total_available(0);
+    for (size_t i = 0; i < array_size(available); ++i)
+    {
+        Properties& source = transaction->add_source();
+        source.set_property_value("amount", available[i]);
+        source.set_property_value("prev_tx_hash",
+                as_binary_data(from_hex("48979223adb5f7f340c4f27d6cc45a38adb37876b2d7e34d2457cbf57342a391")));
+        source.set_property_value("prev_tx_out_index", static_cast<int32_t>(i));
+        source.set_property_value("prev_tx_out_script_pubkey",
+                as_binary_data(from_hex("76a914d3f68b887224cabcc90a9581c7bbdace878666db88ac")));
+        source.set_property_value("private_key", *account->get_private_key());
+        total_available += available[i];
+    }
+    EXPECT_THROW(properties.set_property_value("coin_selection", 0), Exception);
+
+    const BinaryDataPtr serialized = transaction->serialize();
+    ASSERT_NE(nullptr, serialized);
+    // Number of inputs, right after 4-byte version.
+    const size_t inputs_count = serialized->data[4];
+    EXPECT_LT(0, inputs_count);
+    EXPECT_GT(array_size(available), inputs_count);
+
+    BigInt change_amount;
+    change.get_property_value("amount", &change_amount);
+    const BigInt total_fee = transaction->get_total_fee();
+    EXPECT_PRED3(is_between,
+            fee_per_byte * static_cast<int64_t>(serialized->len),
+            total_fee,
+            // Either fee is computed for worst-case signatures, or the change
+            // was too small to be added and went to the fee.
+            fee_per_byte * static_cast<int64_t>(serialized->len + inputs_count)
+                    + (change_amount == 0 ? BigInt(546 + 34 * 10) : BigInt(0)));
+    EXPECT_GT(total_available, sent + change_amount + total_fee);
+
+    // Selection is repeatable.
+    EXPECT_EQ(*serialized, *transaction->serialize());
+}
+
+GTEST_TEST(BitcoinTransactionTest, coin_selection_insufficient_funds)
+{
+    const AccountPtr account = make_account(BITCOIN_TEST_NET,
+            "cQeGKosJjWPn9GkB7QmvmotmBbVg1hm8UjdN6yLXEWZ5HAcRwam7");
+
+    TransactionPtr transaction;
+    HANDLE_ERROR(make_transaction(account.get(), reset_sp(transaction)));
+    transaction->get_transaction_properties().set_property_value("coin_selection", 1);
+    transaction->get_fee().set_property_value("amount_per_byte", 10_SATOSHI);
+    {
+        Properties& destination = transaction->add_destination();
+        destination.set_property_value("address", "mfgq7S1Va1GREFgN66MVoxX35X6juKov6A");
+        destination.set_property_value("amount", 0.01_BTC);
+    }
+    {
+        Properties& source = transaction->add_source();
+        source.set_property_value("amount", 0.01_BTC);
+        source.set_property_value("prev_tx_hash",
+                as_binary_data(from_hex("48979223adb5f7f340c4f27d6cc45a38adb37876b2d7e34d2457cbf57342a391")));
+        source.set_property_value("prev_tx_out_index", 0);
+        source.set_property_value("prev_tx_out_script_pubkey",
+                as_binary_data(from_hex("76a914d3f68b887224cabcc90a9581c7bbdace878666db88ac")));
+        source.set_property_value("private_key", *account->get_private_key());
+    }
+
+    EXPECT_ERROR_WITH_CODE(transaction_update(transaction.get()),
+            ERROR_TRANSACTION_INSUFFICIENT_FUNDS);
+}
+
+GTEST_TEST(BitcoinTransactionTest, change_amount_dust_boundary)
+{
+    // Verify that change gets all leftover after paying the fee, unless
+    // leftover is a dust, in which case it all goes to the fee.
+    const AccountPtr account = make_account(BITCOIN_TEST_NET,
+            "cQeGKosJjWPn9GkB7QmvmotmBbVg1hm8UjdN6yLXEWZ5HAcRwam7");
+    const BigInt min_change(546_SATOSHI);
+    const BigInt sent = DEFAULT_TX_TEMPLATE.destinations[0].amount;
+
+    TransactionTemplate TEST_TX = DEFAULT_TX_TEMPLATE;
+    TEST_TX.fee.amount_per_byte = 7_SATOSHI;
+    const auto get_fee_and_change = [&](const BigInt& available, BigInt* fee, BigInt* change)
+    {
+        TEST_TX.sources[0].available = available;
+        TransactionPtr transaction = make_transaction_from_template(
+                TEST_TX, account, account->get_private_key());
+        transaction->update();
+
+        *fee = transaction->get_total_fee();
+        *change = available - sent - *fee;
+    };
+
+    BigInt total_fee;
+    BigInt change;
+    get_fee_and_change(0.1_BTC, &total_fee, &change);
+    ASSERT_LT(min_change, change);
+    EXPECT_EQ(0, total_fee.get_value_as_uint64() % 7);
+
+    // Leftover is exactly min_change, so it goes to change.
+    const BigInt available = 0.1_BTC - change + min_change;
+    BigInt fee_with_min_change;
+    get_fee_and_change(available, &fee_with_min_change, &change);
+    EXPECT_EQ(total_fee, fee_with_min_change);
+    EXPECT_EQ(min_change, change);
+
+    // Leftover is dust, so no change at all, and fee gets it all.
+    BigInt fee_without_change;
+    get_fee_and_change(available - 1, &fee_without_change, &change);
+    EXPECT_EQ(BigInt(0), change);
+    EXPECT_EQ(total_fee + min_change - 1, fee_without_change);
+}
+
+GTEST_TEST(BitcoinTransactionTest, SegWit_fee_and_change)
+{
+    AccountPtr account;
+    HANDLE_ERROR(make_account(BITCOIN_TEST_NET, BITCOIN_ACCOUNT_SEGWIT,
+            "cRBMwm5iA2yV99cUBxSz39vKp5CmE7eZ9rjXPAPz8S2kbgf5nf3i",
+            reset_sp(account)));
+
+    const BigInt available(0.30048219_BTC);
+    const BigInt sent(0.1_BTC);
+    const BigInt fee_per_byte(10_SATOSHI);
+
+    TransactionPtr transaction;
+    HANDLE_ERROR(make_transaction(account.get(), reset_sp(transaction)));
+    {
+        Properties& source = transaction->add_source();
+        source.set_property_value("amount", available);
+        source.set_property_value("prev_tx_hash",
+                as_binary_data(from_hex("e2f1f958168543d25e7bc6a7897af57f21f6a016d3cf95a99ce78c112b545c07")));
+        source.set_property_value("prev_tx_out_index", 0u);
+        source.set_property_value("prev_tx_out_script_pubkey",
+                as_binary_data(from_hex("a914546c87c7a5187edac7ad3fcf22dc3597ce37b19987")));
+        source.set_property_value("private_key", *account->get_private_key());
+    }
+    Properties& destination = transaction->add_destination();
+    destination.set_property_value("amount", sent);
+    destination.set_property_value("address", "n46Gz2w1q8qtrGHc6yQbHNYRccoVYtzGt4");
+
+    Properties& change = transaction->add_destination();
+    change.set_property_value("address", "2MzwcmDo5WBjrjHzfYuyzsdZHmo682krVnf");
+    change.set_property_value("is_change", 1);
+
+    transaction->get_fee().set_property_value("amount_per_byte", fee_per_byte);
+
+    BigIntPtr estimated_fee;
+    HANDLE_ERROR(transaction_estimate_total_fee(transaction.get(), 1, 2, reset_sp(estimated_fee)));
+
+    const BinaryDataPtr serialized = transaction->serialize();
+    BigInt change_amount;
+    change.get_property_value("amount", &change_amount);
+    const BigInt total_fee = transaction->get_total_fee();
+
+    EXPECT_LT(0, change_amount);
+    EXPECT_EQ(available, sent + change_amount + total_fee);
+    EXPECT_EQ(sent + total_fee, transaction->get_total_spent());
+
+    // Single P2SH-P2WPKH input with compressed public key, witness takes:
+    // elements count + signature with hash type + public key,
+    // actual signature is at most 72 bytes, which is accounted by fee.
+    const uint64_t max_witness_size = 1 + (1 + 72 + 1) + (1 + 33);
+    const uint64_t min_witness_size = max_witness_size - 1;
+    // 2 bytes for marker and flag.
+    const uint64_t max_vsize = (
+            (serialized->len - 2 - min_witness_size) * 4 + min_witness_size + 2 + 3 + 1 * 4) / 4;
+    const uint64_t min_vsize = (
+            (serialized->len - 2 - max_witness_size) * 4 + max_witness_size + 2 + 3) / 4;
+    EXPECT_PRED3(is_between,
+            fee_per_byte * min_vsize,
+            total_fee,
+            fee_per_byte * max_vsize);
+    EXPECT_LE(total_fee, *estimated_fee);
+
+    // Leftover is too small for a change output, hence it all goes to the fee.
+    destination.set_property_value("amount", available - total_fee - 300_SATOSHI);
+    transaction->update();
+    change.get_property_value("amount", &change_amount);
+    EXPECT_EQ(BigInt(0), change_amount);
+    EXPECT_EQ(available, transaction->get_total_spent());
+}
+
+GTEST_TEST(BitcoinTransactionTest, serialize_into)
+{
+    const AccountPtr account = make_account(BITCOIN_TEST_NET,
+            "cQeGKosJjWPn9GkB7QmvmotmBbVg1hm8UjdN6yLXEWZ5HAcRwam7");
+
+    TransactionPtr transaction;
+    HANDLE_ERROR(make_transaction(account.get(), reset_sp(transaction)));
+    transaction->get_fee().set_property_value("amount_per_byte", 10_SATOSHI);
+    {
+        Properties& source = transaction->add_source();
+        source.set_property_value("amount", 1.0_BTC);
+        source.set_property_value("prev_tx_hash",
+                as_binary_data(from_hex("48979223adb5f7f340c4f27d6cc45a38adb37876b2d7e34d2457cbf57342a391")));
+        source.set_property_value("prev_tx_out_index", 0);
+        source.set_property_value("prev_tx_out_script_pubkey",
+                as_binary_data(from_hex("76a914d3f68b887224cabcc90a9581c7bbdace878666db88ac")));
+        source.set_property_value("private_key", *account->get_private_key());
+    }
+    {
+        Properties& destination = transaction->add_destination();
+        destination.set_property_value("address", "mfgq7S1Va1GREFgN66MVoxX35X6juKov6A");
+        destination.set_property_value("amount", 0.5_BTC);
+    }
+    {
+        Properties& change = transaction->add_destination();
+        change.set_property_value("address", "mpJDSHJcytfxp9asgo2pqihabHmmJkqJuM");
+        change.set_property_value("is_change", 1);
+    }
+
+    const BinaryDataPtr serialized = transaction->serialize();
+
+    size_t size = 0;
+    HANDLE_ERROR(transaction_get_serialized_size(transaction.get(), &size));
+    EXPECT_EQ(serialized->len, size);
+
+    std::vector<unsigned char> buffer(size + 1, 0xFF);
+    size_t written = 0;
+    HANDLE_ERROR(transaction_serialize_into(
+            transaction.get(), buffer.data(), buffer.size(), &written));
+    EXPECT_EQ(size, written);
+    EXPECT_EQ(*serialized, BinaryData({buffer.data(), written}));
+    // Nothing is written past the serialized transaction.
+    EXPECT_EQ(0xFF, buffer.back());
+
+    EXPECT_ERROR_WITH_CODE(transaction_serialize_into(
+            transaction.get(), buffer.data(), size - 1, &written),
+            ERROR_TRANSACTION_BUFFER_TOO_SMALL);
+}
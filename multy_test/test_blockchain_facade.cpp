@@ -0,0 +1,106 @@
+/* Copyright 2018 by Multy.io
+ * Licensed under Multy.io license
+ *
+ * See LICENSE for details
+ */
+
+#include "multy_core/src/blockchain_facade_base.h"
+
+#include "multy_core/account.h"
+#include "multy_core/ethereum.h"
+#include "multy_core/src/api/account_impl.h"
+#include "multy_core/src/api/key_impl.h"
+#include "multy_core/src/binary_data_utility.h"
+#include "multy_core/src/exception.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using namespace multy_core::internal;
+
+const Blockchain SUPPORTED_BLOCKCHAINS[] = {
+    BLOCKCHAIN_BITCOIN,
+    BLOCKCHAIN_ETHEREUM,
+#if MULTY_WITH_GOLOS
+    BLOCKCHAIN_GOLOS,
+#endif
+#if MULTY_WITH_EOS
+    BLOCKCHAIN_EOS,
+#endif
+};
+
+} // namespace
+
+GTEST_TEST(BlockchainFacadeRegistryTest, get_blockchain)
+{
+    for (const auto blockchain : SUPPORTED_BLOCKCHAINS)
+    {
+        SCOPED_TRACE(blockchain);
+        EXPECT_EQ(&get_blockchain(blockchain), &get_blockchain(blockchain));
+    }
+    EXPECT_NE(&get_blockchain(BLOCKCHAIN_BITCOIN), &get_blockchain(BLOCKCHAIN_ETHEREUM));
+
+    EXPECT_THROW(get_blockchain(static_cast<Blockchain>(-1)), Exception);
+    EXPECT_THROW(get_blockchain(static_cast<Blockchain>(1)), Exception);
+}
+
+GTEST_TEST(BlockchainFacadeRegistryTest, concurrent_access)
+{
+    // Every thread gets facades and makes and uses accounts on its own,
+    // with no external synchronization, as documented in README.
+    const size_t THREADS_COUNT = 8;
+    const BlockchainType ETHEREUM_MAIN = {BLOCKCHAIN_ETHEREUM, ETHEREUM_CHAIN_ID_MAINNET};
+    const char* PRIVATE_KEY = "d92c7ed86831ee78e76a9acbb91219ab1a7a399f69db20f04da8478e11a51900";
+
+    std::atomic<bool> start(false);
+    std::atomic<size_t> failures(0);
+    std::vector<std::vector<const BlockchainFacadeBase*>> facades(THREADS_COUNT);
+    std::vector<std::string> addresses(THREADS_COUNT);
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < THREADS_COUNT; ++i)
+    {
+        threads.emplace_back([&, i]()
+        {
+            while (!start)
+            {
+                std::this_thread::yield();
+            }
+
+            try
+            {
+                for (const auto blockchain : SUPPORTED_BLOCKCHAINS)
+                {
+                    facades[i].push_back(&get_blockchain(blockchain));
+                }
+                const auto account = get_blockchain(ETHEREUM_MAIN).make_account(
+                        ETHEREUM_MAIN, ACCOUNT_TYPE_DEFAULT, PRIVATE_KEY);
+                account->get_private_key()->sign(as_binary_data("message"));
+                addresses[i] = account->get_address();
+            }
+            catch (...)
+            {
+                ++failures;
+            }
+        });
+    }
+    start = true;
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(0u, failures);
+    for (size_t i = 1; i < THREADS_COUNT; ++i)
+    {
+        SCOPED_TRACE(i);
+        EXPECT_EQ(facades[0], facades[i]);
+        EXPECT_EQ(addresses[0], addresses[i]);
+    }
+}
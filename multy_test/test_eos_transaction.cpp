@@ -8,6 +8,9 @@
 #include "multy_core/transaction.h"
 #include "multy_core/big_int.h"
 
+#include "multy_core/src/api/big_int_impl.h"
+#include "multy_core/src/api/properties_impl.h"
+#include "multy_core/src/api/transaction_impl.h"
 
 #include "multy_test/supported_blockchains.h"
 #include "multy_test/utility.h"
@@ -15,6 +18,7 @@
 #include "gtest/gtest.h"
 
 #include <memory>
+#include <vector>
 
 namespace
 {
@@ -142,3 +146,59 @@ GTEST_TEST(EosTransactionTest, SmokeTest_testnet_2)
             ",\"packed_trx\":\"8690555b6535ffd893a9000000000100a6823403ea3055000000572d3ccdcd010000000000d3b0a900000000a8ed3232260000000000d3b0a900806"
             "9d85490b1ca102700000000000004454f5300000000056d756c747900\",\"compression\":\"none\",\"packed_context_free_data\":\"\"}"), std::string(signatures.get()));
 }
+
+GTEST_TEST(EosTransactionTest, serialize_into)
+{
+    AccountPtr account;
+    HANDLE_ERROR(make_account(
+            EOS_TEST_NET,
+            ACCOUNT_TYPE_DEFAULT,
+            "5JViCsGPFdFBUxzsLzXyYX4XdSuovADMFdkucEzTkioMSVK9NPG",
+            reset_sp(account)));
+
+    TransactionPtr transaction;
+    HANDLE_ERROR(make_transaction(account.get(), reset_sp(transaction)));
+    {
+        Properties& properties = transaction->get_transaction_properties();
+        properties.set_property_value("block_num", 6432047);
+        properties.set_property_value("ref_block_prefix", BigInt("262535889"));
+        properties.set_property_value("expiration", "2018-07-19T16:35:07Z");
+    }
+    {
+        Properties& source = transaction->add_source();
+        source.set_property_value("amount", BigInt(20000));
+        source.set_property_value("address", "pasha");
+    }
+    {
+        Properties& destination = transaction->add_destination();
+        destination.set_property_value("amount", BigInt(10));
+        destination.set_property_value("address", "test.pasha");
+    }
+
+    const bytes expected = from_hex(
+            "d9bd505b2f25d1faa50f000000000100a6823403ea3055000000572d3ccdcd010000000000d3b0a900000000a8ed3232210000000000d3b0a9008069d85490b1ca0a0000000000000004454f53000000000000");
+
+    // Before serialize(), TX is written directly into the buffer.
+    size_t size = 0;
+    HANDLE_ERROR(transaction_get_serialized_size(transaction.get(), &size));
+    EXPECT_EQ(expected.size(), size);
+
+    std::vector<unsigned char> buffer(expected.size() + 1, 0xFF);
+    size_t written = 0;
+    EXPECT_ERROR_WITH_CODE(transaction_serialize_into(
+            transaction.get(), buffer.data(), expected.size() - 1, &written),
+            ERROR_TRANSACTION_BUFFER_TOO_SMALL);
+
+    HANDLE_ERROR(transaction_serialize_into(
+            transaction.get(), buffer.data(), buffer.size(), &written));
+    EXPECT_EQ(expected.size(), written);
+    EXPECT_EQ(as_binary_data(expected), BinaryData({buffer.data(), written}));
+    // Nothing is written past the serialized transaction.
+    EXPECT_EQ(0xFF, buffer.back());
+
+    // After serialize(), cached TX is copied.
+    EXPECT_EQ(as_binary_data(expected), *transaction->serialize());
+    HANDLE_ERROR(transaction_serialize_into(
+            transaction.get(), buffer.data(), buffer.size(), &written));
+    EXPECT_EQ(as_binary_data(expected), BinaryData({buffer.data(), written}));
+}
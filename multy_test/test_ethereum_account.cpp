@@ -284,6 +284,33 @@ GTEST_TEST(EtheremAccountTest, account_change_private_key)
     }
 }
 
+GTEST_TEST(EtheremAccountTest, account_change_private_key_updates_address)
+{
+    const char* serialized_private_key = "5a37680b86fabdec299fa02bdfba8c9dfad08d796dc58c1d07527a751905bf71";
+    const char* changed_private_key = "0037680b86fabdec299fa02bdfba8c9dfad08d796dc58c1d07527a751905bf71";
+
+    AccountPtr account;
+    HANDLE_ERROR(make_account(ETHEREUM_TEST_NET, ACCOUNT_TYPE_DEFAULT,
+            serialized_private_key, reset_sp(account)));
+    AccountPtr changed_account;
+    HANDLE_ERROR(make_account(ETHEREUM_TEST_NET, ACCOUNT_TYPE_DEFAULT,
+            changed_private_key, reset_sp(changed_account)));
+
+    const std::string address = account->get_address();
+    const std::string public_key = account->get_public_key()->to_string();
+    ASSERT_NE(changed_account->get_address(), address);
+
+    // Public key and address derived from the private key must follow it.
+    HANDLE_ERROR(account_change_private_key(account.get(), 0, 0));
+    EXPECT_EQ(changed_account->get_address(), account->get_address());
+    EXPECT_EQ(changed_account->get_public_key()->to_string(),
+            account->get_public_key()->to_string());
+
+    HANDLE_ERROR(account_change_private_key(account.get(), 0, 0x5a));
+    EXPECT_EQ(address, account->get_address());
+    EXPECT_EQ(public_key, account->get_public_key()->to_string());
+}
+
 GTEST_TEST(EtheremAccountInvalidArgsTest, account_change_private_key)
 {
     AccountPtr account;
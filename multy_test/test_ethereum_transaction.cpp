@@ -17,6 +17,7 @@
 #include "multy_core/src/api/account_impl.h"
 #include "multy_core/src/api/key_impl.h"
 #include "multy_core/src/api/transaction_builder_impl.h"
+#include "multy_core/src/exception.h"
 #include "multy_core/src/u_ptr.h"
 #include "multy_core/src/utility.h"
 
@@ -27,6 +28,7 @@
 #include "gtest/gtest.h"
 
 #include <memory>
+#include <vector>
 
 namespace
 {
@@ -930,6 +932,47 @@ static const PayloadTestCase PAYLOAD_CASES[] =
 INSTANTIATE_TEST_CASE_P(
         EthereumTransaction, PayloadTestP, ::testing::ValuesIn(PAYLOAD_CASES));
 
+GTEST_TEST(EthereumTransactionTest, serialize_is_updated_on_any_change)
+{
+    AccountPtr account;
+    HANDLE_ERROR(make_account(
+            ETHEREUM_TEST_NET,
+            ACCOUNT_TYPE_DEFAULT,
+            "5a37680b86fabdec299fa02bdfba8c9dfad08d796dc58c1d07527a751905bf71",
+            reset_sp(account)));
+
+    TransactionPtr transaction;
+    HANDLE_ERROR(make_transaction(account.get(), reset_sp(transaction)));
+
+    transaction->get_transaction_properties().set_property_value("nonce", BigInt("0"));
+    transaction->add_source().set_property_value("amount", BigInt(7.5_ETH));
+    Properties& destination = transaction->add_destination();
+    destination.set_property_value("address", "d1b48a11e2251555c3c6d8b93e13f9aa2f51ea19");
+    destination.set_property_value("amount", BigInt(1_WEI));
+    Properties& fee = transaction->get_fee();
+    fee.set_property_value("gas_price", BigInt(1_WEI));
+    fee.set_property_value("gas_limit", BigInt(21001));
+
+    const BinaryDataPtr expected = transaction->serialize();
+    // Nothing changed, so same result is returned without re-signing.
+    EXPECT_EQ(*expected, *transaction->serialize());
+    EXPECT_EQ(expected->len, transaction->get_serialized_size());
+
+    // Changing fee, that is not part of transaction properties,
+    // still makes transaction to be updated and re-signed.
+    fee.set_property_value("gas_limit", BigInt(21000));
+    const BinaryDataPtr changed = transaction->serialize();
+    EXPECT_NE(*expected, *changed);
+    EXPECT_EQ(BigInt(21000), transaction->get_total_fee());
+
+    fee.set_property_value("gas_limit", BigInt(21001));
+    EXPECT_EQ(*expected, *transaction->serialize());
+    EXPECT_EQ(BigInt(21001), transaction->get_total_fee());
+
+    destination.set_property_value("amount", BigInt(8.5_ETH));
+    EXPECT_THROW(transaction->serialize(), Exception);
+}
+
 GTEST_TEST(EthereumTransactionTest, transfer_more_than_18ETH)
 {
     AccountPtr account;
@@ -1037,3 +1080,59 @@ GTEST_TEST(EthereumTransactionBuilderTest, Create_multisig_wallet_sign_bug)
     const BinaryDataPtr serialied = transaction->serialize();
     ASSERT_EQ(as_binary_data(from_hex("f901110384ee6b2800834c4b409404f68589f53cfdf408025cd7cea8a40dbf488e4988016345785d8a0000b8a4f8f738080000000000000000000000000000000000000000000000000000000000000040000000000000000000000000000000000000000000000000000000000000000200000000000000000000000000000000000000000000000000000000000000020000000000000000000000007ebc184b7af2e4e93a0572704bbaf0ff0b752722000000000000000000000000479ce7fb73dd636ff6efe2c11cde5965ca1d6fef2ba00093cf261eec56b16cdc69cd7cf454d8fe76800e011c3525f14f4ea4f5d2a6d1a02dcee51e773072dc54382d6527c0dc0410ac67dc331fc330504f8fb950d40525")), *serialied);
 }
+
+GTEST_TEST(EthereumTransactionTest, serialize_into)
+{
+    AccountPtr account;
+    HANDLE_ERROR(make_account(
+            ETHEREUM_TEST_NET,
+            ACCOUNT_TYPE_DEFAULT,
+            "5a37680b86fabdec299fa02bdfba8c9dfad08d796dc58c1d07527a751905bf71",
+            reset_sp(account)));
+
+    TransactionPtr transaction;
+    HANDLE_ERROR(make_transaction(account.get(), reset_sp(transaction)));
+
+    transaction->get_transaction_properties().set_property_value("nonce", BigInt("3"));
+    transaction->add_source().set_property_value("amount", BigInt(7.5_ETH));
+    {
+        Properties& destination = transaction->add_destination();
+        destination.set_property_value("address", "d1b48a11e2251555c3c6d8b93e13f9aa2f51ea19");
+        destination.set_property_value("amount", BigInt(1000_WEI));
+    }
+    {
+        Properties& fee = transaction->get_fee();
+        fee.set_property_value("gas_price", BigInt(3000.0_GWEI));
+        fee.set_property_value("gas_limit", BigInt(121000));
+    }
+    transaction->set_message(as_binary_data(from_hex("ffff")));
+
+    const bytes expected = from_hex(
+            "f86a038602ba7def30008301d8a894d1b48a11e2251555c3c6d8b93e13f9aa2f51ea198203e882ffff2ca0122bf1a37f949f0fc34354ca737eec7fd654e2172ecf893497d6e8356217512da05f01213f5d1c25d4b55e8c7219e572f92b00ec74a2662ae93c45928eb5133942");
+
+    // Before serialize(), TX is written directly into the buffer.
+    size_t size = 0;
+    HANDLE_ERROR(transaction_get_serialized_size(transaction.get(), &size));
+    EXPECT_EQ(expected.size(), size);
+
+    std::vector<unsigned char> buffer(expected.size() + 1, 0xFF);
+    size_t written = 0;
+    EXPECT_ERROR_WITH_CODE(transaction_serialize_into(
+            transaction.get(), buffer.data(), expected.size() - 1, &written),
+            ERROR_TRANSACTION_BUFFER_TOO_SMALL);
+
+    HANDLE_ERROR(transaction_serialize_into(
+            transaction.get(), buffer.data(), buffer.size(), &written));
+    EXPECT_EQ(expected.size(), written);
+    EXPECT_EQ(as_binary_data(expected), BinaryData({buffer.data(), written}));
+    // Nothing is written past the serialized transaction.
+    EXPECT_EQ(0xFF, buffer.back());
+
+    // After serialize(), cached TX is copied.
+    EXPECT_EQ(as_binary_data(expected), *transaction->serialize());
+    HANDLE_ERROR(transaction_get_serialized_size(transaction.get(), &size));
+    EXPECT_EQ(expected.size(), size);
+    HANDLE_ERROR(transaction_serialize_into(
+            transaction.get(), buffer.data(), buffer.size(), &written));
+    EXPECT_EQ(as_binary_data(expected), BinaryData({buffer.data(), written}));
+}
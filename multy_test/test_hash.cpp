@@ -0,0 +1,265 @@
+/* Copyright 2018 by Multy.io
+ * Licensed under Multy.io license
+ *
+ * See LICENSE for details
+ */
+
+#include "multy_core/src/hash.h"
+#include "multy_core/src/bitcoin/bitcoin_stream.h"
+#include "multy_core/src/sha256_batch.h"
+
+#include "multy_test/value_printers.h"
+#include "multy_test/utility.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace
+{
+using namespace test_utility;
+using namespace multy_core::internal;
+
+struct HasherTestCase
+{
+    HasherType type;
+    size_t hash_bit_size;
+};
+
+void PrintTo(const HasherTestCase& test_case, std::ostream* out)
+{
+    *out << "HasherTestCase{" << test_case.type
+         << ", " << test_case.hash_bit_size << "}";
+}
+
+const HasherTestCase HASHER_TEST_CASES[] = {
+    {SHA2, 256},
+    {SHA2, 512},
+    {SHA2_DOUBLE, 256},
+    {SHA2_DOUBLE, 512},
+    {SHA3, 224},
+    {SHA3, 256},
+    {SHA3, 384},
+    {SHA3, 512},
+    {KECCAK, 256},
+    {RIPEMD, 160},
+    {BITCOIN_HASH, 160},
+};
+
+// Sizes around block boundaries of all hashes: 64, 72, 104, 128, 136, 144.
+const size_t INPUT_SIZES[] = {
+    0, 1, 63, 64, 65, 71, 72, 73, 104, 127, 128, 129, 135, 136, 137, 144, 1000
+};
+
+const size_t CHUNK_SIZES[] = {1, 7, 64, 200};
+
+std::vector<uint8_t> make_input(size_t size)
+{
+    std::vector<uint8_t> result(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        result[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+    return result;
+}
+
+class HasherTestP : public ::testing::TestWithParam<HasherTestCase>
+{
+};
+
+} // namespace
+
+TEST_P(HasherTestP, update_finalize_matches_hash)
+{
+    const HasherTestCase& param = GetParam();
+    HasherPtr hasher = make_hasher(param.type, param.hash_bit_size);
+
+    std::vector<uint8_t> expected(param.hash_bit_size / 8);
+    std::vector<uint8_t> actual(param.hash_bit_size / 8);
+    BinaryData expected_data = as_binary_data(expected);
+    BinaryData actual_data = as_binary_data(actual);
+
+    for (const size_t input_size : INPUT_SIZES)
+    {
+        SCOPED_TRACE(input_size);
+        // One-shot hashing requires non-null data even for empty input.
+        const std::vector<uint8_t> input_buffer = make_input(input_size + 1);
+        const BinaryData input{input_buffer.data(), input_size};
+        hasher->hash(input, &expected_data);
+
+        for (const size_t chunk_size : CHUNK_SIZES)
+        {
+            SCOPED_TRACE(chunk_size);
+            // Same hasher is reused, since finalize() resets its state.
+            for (size_t offset = 0; offset < input.len; offset += chunk_size)
+            {
+                const size_t size = std::min(chunk_size, input.len - offset);
+                hasher->update(BinaryData{input.data + offset, size});
+            }
+            hasher->finalize(&actual_data);
+            ASSERT_EQ(expected, actual);
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+        Hasher,
+        HasherTestP,
+        ::testing::ValuesIn(HASHER_TEST_CASES));
+
+GTEST_TEST(HasherTest, empty_update_does_not_affect_hash)
+{
+    HasherPtr hasher = make_hasher(KECCAK, 256);
+    const std::vector<uint8_t> input = make_input(10);
+
+    hasher->update(BinaryData{nullptr, 0});
+    hasher->update(as_binary_data(input));
+    hasher->update(BinaryData{nullptr, 0});
+
+    hash<256> actual;
+    BinaryData actual_data = as_binary_data(actual);
+    hasher->finalize(&actual_data);
+
+    const hash<256> expected = do_hash<KECCAK, 256>(input);
+    EXPECT_EQ(expected, actual);
+}
+
+GTEST_TEST(HasherTest, BitcoinHashStream)
+{
+    const uint32_t value = 0x01020304;
+    const std::vector<uint8_t> data = make_input(100);
+
+    BitcoinDataStream data_stream;
+    data_stream << value << as_binary_data(data);
+
+    HasherPtr hasher = make_hasher(SHA2_DOUBLE, 256);
+    BitcoinHashStream hash_stream(hasher.get());
+    hash_stream << value << as_binary_data(data);
+
+    hash<256> actual;
+    BinaryData actual_data = as_binary_data(actual);
+    hasher->finalize(&actual_data);
+
+    const hash<256> expected = do_hash<SHA2_DOUBLE, 256>(data_stream.get_content());
+    EXPECT_EQ(expected, actual);
+}
+
+GTEST_TEST(HasherTest, do_hash_inplace_writes_only_hash_size)
+{
+    const std::vector<uint8_t> input = make_input(10);
+    std::array<uint8_t, 64> buffer;
+    buffer.fill(0xFF);
+
+    do_hash_inplace<SHA2_DOUBLE, 256>(input, &buffer);
+
+    const hash<256> expected = do_hash<SHA2_DOUBLE, 256>(input);
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), buffer.begin()));
+    EXPECT_TRUE(std::all_of(buffer.begin() + expected.size(), buffer.end(),
+            [](uint8_t b) { return b == 0xFF; }));
+}
+
+GTEST_TEST(HasherTest, sha256_batch_all_implementations)
+{
+    const Sha256BatchImplementation IMPLEMENTATIONS[] = {
+        SHA256_BATCH_PORTABLE,
+        SHA256_BATCH_SSE4,
+        SHA256_BATCH_AVX2,
+        SHA256_BATCH_SHA_NI,
+    };
+    // Counts to cover full groups of 8 and 4 messages and remainders.
+    const size_t COUNTS[] = {0, 1, 3, 4, 5, 8, 13, 17};
+
+    for (const auto implementation : IMPLEMENTATIONS)
+    {
+        if (!is_sha256_batch_implementation_supported(implementation))
+        {
+            continue;
+        }
+        SCOPED_TRACE(implementation);
+
+        for (const size_t message_size : INPUT_SIZES)
+        {
+            SCOPED_TRACE(message_size);
+            for (const size_t count : COUNTS)
+            {
+                SCOPED_TRACE(count);
+                const std::vector<uint8_t> inputs = make_input(message_size * count + 1);
+                std::vector<uint8_t> outputs(count * 32);
+                sha256_batch(implementation, inputs.data(), message_size, count,
+                        outputs.data());
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const hash<256> expected = do_hash<SHA2, 256>(
+                            BinaryData{inputs.data() + i * message_size, message_size});
+                    ASSERT_TRUE(std::equal(expected.begin(), expected.end(),
+                            outputs.begin() + i * 32));
+                }
+            }
+        }
+    }
+}
+
+GTEST_TEST(HasherTest, hash_bitcoin_160_batch)
+{
+    const size_t PUBLIC_KEY_SIZE = 33;
+    const size_t COUNT = 11;
+    const std::vector<uint8_t> inputs = make_input(PUBLIC_KEY_SIZE * COUNT);
+    std::vector<uint8_t> outputs(COUNT * 20);
+    BinaryData output_data = as_binary_data(outputs);
+
+    hash_bitcoin_160_batch(as_binary_data(inputs), PUBLIC_KEY_SIZE, &output_data);
+
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        const hash<160> expected = do_hash<BITCOIN_HASH, 160>(
+                BinaryData{inputs.data() + i * PUBLIC_KEY_SIZE, PUBLIC_KEY_SIZE});
+        ASSERT_TRUE(std::equal(expected.begin(), expected.end(),
+                outputs.begin() + i * 20));
+    }
+}
+
+GTEST_TEST(HasherTest, keccak_256_known_values)
+{
+    // Ethereum Keccak-256 of empty input and of "abc".
+    EXPECT_EQ(as_binary_data(from_hex(
+            "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470")),
+            as_binary_data(do_hash<KECCAK, 256>(BinaryData{
+                    reinterpret_cast<const unsigned char*>(""), 0})));
+    EXPECT_EQ(as_binary_data(from_hex(
+            "4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45")),
+            as_binary_data(do_hash<KECCAK, 256>(std::string("abc"))));
+}
+
+GTEST_TEST(HasherTest, hash_keccak_256_batch)
+{
+    // Sizes around Keccak-256 block size of 136 bytes.
+    const size_t MESSAGE_SIZES[] = {1, 64, 135, 136, 300};
+    const size_t COUNTS[] = {1, 3, 4, 9};
+
+    for (const size_t message_size : MESSAGE_SIZES)
+    {
+        SCOPED_TRACE(message_size);
+        for (const size_t count : COUNTS)
+        {
+            SCOPED_TRACE(count);
+            const std::vector<uint8_t> inputs = make_input(message_size * count + 1);
+            std::vector<uint8_t> outputs(count * 32);
+            BinaryData output_data = as_binary_data(outputs);
+
+            hash_keccak_256_batch(
+                    BinaryData{inputs.data(), message_size * count},
+                    message_size, &output_data);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const hash<256> expected = do_hash<KECCAK, 256>(
+                        BinaryData{inputs.data() + i * message_size, message_size});
+                ASSERT_TRUE(std::equal(expected.begin(), expected.end(),
+                        outputs.begin() + i * 32));
+            }
+        }
+    }
+}
@@ -6,8 +6,19 @@
 
 #include "test_json_api_transaction.h"
 
+#include "multy_core/json_api.h"
+#include "multy_core/src/json_helpers.h"
+#include "multy_core/src/utility.h"
+#include "multy_core/src/u_ptr.h"
+
+#include "json/json.h"
+
+#include <string>
+#include <vector>
+
 namespace
 {
+using namespace multy_core::internal;
 using namespace test_utility;
 
 const JsonTransactionApiTestCase ETH_MULTISIG_TEST_CASES[] = {
@@ -559,4 +570,340 @@ INSTANTIATE_TEST_CASE_P(
         JsonTransactionApiErrorTestP,
         ::testing::ValuesIn(ETH_ERC721_TRANSFER_ERROR_TEST_CASES));
 
+// Same request as "MS new request" above, but in a shape that is less common.
+const JsonTransactionApiTestCase ETH_KEY_ORDER_TEST_CASES[] = {
+    // Sections and keys in reverse order, each depends on the one that follows.
+    {
+        R"json({
+    "transaction": {
+        "fee": {
+            "gas_limit": "141346",
+            "gas_price": "5000000000"
+        },
+        "nonce": 2
+    },
+    "builder": {
+        "payload": {
+            "dest_address": "0x2B74679D2a190Fd679a85cE7767c05605237f030",
+            "wallet_address": "0x9b9A4102fB0F17aa2eE8e1Dbf8E8e3a62Cc01A3F",
+            "amount": "400000000000000000",
+            "balance": "1000000000000000000"
+        },
+        "action": "new_request",
+        "type": "multisig"
+    },
+    "account": {
+        "private_key": "d92c7ed86831ee78e76a9acbb91219ab1a7a399f69db20f04da8478e11a51900",
+        "type": 0
+    },
+    "net_type": 4,
+    "blockchain": "Ethereum"
+})json",
+        TX("0xf8ea0285012a05f20083022822949b9a4102fb0f17aa2ee8e1dbf8e8e3a62cc01"
+        "a3f80b884c64274740000000000000000000000002b74679d2a190fd679a85ce7767c0"
+        "5605237f030000000000000000000000000000000000000000000000000058d15e1762"
+        "8000000000000000000000000000000000000000000000000000000000000000000600"
+        "0000000000000000000000000000000000000000000000000000000000000002ca067f"
+        "31718d0d0371f0417df1bad027b7f13172be53002835f60c6e893b666d187a06f6aebe"
+        "a21b40a0d89ce16272b9db1ddbeebe3a7fdcc3c10f44da07b12b74f97")
+    },
+    // Escaped strings, unknown keys and a numeric BigInt value.
+    {
+        R"json({
+    "blockchain": "\u0045thereum",
+    "net_type": 4,
+    "comment": {"ignored": [1, 2.5e3, true, null, "\ud83d\ude00"]},
+    "account": {
+        "type": 0,
+        "private_key": "d92c7ed86831ee78e76a9acbb91219ab1a7a399f69db20f04da8478e11a51900"
+    },
+    "builder": {
+        "type": "multisig",
+        "action": "new_request",
+        "payload": {
+            "balance": 1000000000000000000,
+            "amount": "400000000000000000",
+            "wallet_address": "0x9b9A4102fB0F17aa2eE8e1Dbf8E8e3a62Cc01A3F",
+            "dest_address": "0x2B74679D2a190Fd679a85cE7767c05605237f030"
+        }
+    },
+    "transaction": {
+        "nonce": 2,
+        "fee": {
+            "gas_price": "5000000000",
+            "gas_limit": "141346"
+        }
+    }
+})json",
+        TX("0xf8ea0285012a05f20083022822949b9a4102fb0f17aa2ee8e1dbf8e8e3a62cc01"
+        "a3f80b884c64274740000000000000000000000002b74679d2a190fd679a85ce7767c0"
+        "5605237f030000000000000000000000000000000000000000000000000058d15e1762"
+        "8000000000000000000000000000000000000000000000000000000000000000000600"
+        "0000000000000000000000000000000000000000000000000000000000000002ca067f"
+        "31718d0d0371f0417df1bad027b7f13172be53002835f60c6e893b666d187a06f6aebe"
+        "a21b40a0d89ce16272b9db1ddbeebe3a7fdcc3c10f44da07b12b74f97")
+    },
+    // Comments are only supported by jsoncpp.
+    {
+        R"json({
+    // Multisig request
+    "blockchain": "Ethereum",
+    "net_type": 4,
+    "account": {
+        "type": 0,
+        "private_key": "d92c7ed86831ee78e76a9acbb91219ab1a7a399f69db20f04da8478e11a51900"
+    },
+    "builder": {
+        "type": "multisig",
+        "action": "new_request",
+        "payload": {
+            "balance": "1000000000000000000",
+            "amount": "400000000000000000",
+            "wallet_address": "0x9b9A4102fB0F17aa2eE8e1Dbf8E8e3a62Cc01A3F",
+            "dest_address": "0x2B74679D2a190Fd679a85cE7767c05605237f030"
+        }
+    },
+    "transaction": {
+        "nonce": 2,
+        "fee": {
+            "gas_price": "5000000000",
+            "gas_limit": "141346"
+        }
+    }
+})json",
+        TX("0xf8ea0285012a05f20083022822949b9a4102fb0f17aa2ee8e1dbf8e8e3a62cc01"
+        "a3f80b884c64274740000000000000000000000002b74679d2a190fd679a85ce7767c0"
+        "5605237f030000000000000000000000000000000000000000000000000058d15e1762"
+        "8000000000000000000000000000000000000000000000000000000000000000000600"
+        "0000000000000000000000000000000000000000000000000000000000000002ca067f"
+        "31718d0d0371f0417df1bad027b7f13172be53002835f60c6e893b666d187a06f6aebe"
+        "a21b40a0d89ce16272b9db1ddbeebe3a7fdcc3c10f44da07b12b74f97")
+    }
+};
+
+INSTANTIATE_TEST_CASE_P(
+        EthereumKeyOrder,
+        JsonTransactionApiTestP,
+        ::testing::ValuesIn(ETH_KEY_ORDER_TEST_CASES));
+
+const JsonTransactionApiErrorTestCase ETH_KEY_ORDER_ERROR_TEST_CASES[] = {
+    // Fee is set first regardless of the key order, so fee error is reported.
+    {
+        R"json({
+    "blockchain": "Ethereum",
+    "net_type": 4,
+    "account": {
+        "type": 0,
+        "private_key": "d92c7ed86831ee78e76a9acbb91219ab1a7a399f69db20f04da8478e11a51900"
+    },
+    "builder": {
+        "type": "multisig",
+        "action": "new_request",
+        "payload": {
+            "balance": "1000000000000000000",
+            "amount": "400000000000000000",
+            "wallet_address": "0x9b9A4102fB0F17aa2eE8e1Dbf8E8e3a62Cc01A3F",
+            "dest_address": "0x2B74679D2a190Fd679a85cE7767c05605237f030"
+        }
+    },
+    "transaction": {
+        "nonce": -5,
+        "fee": {
+            "gas_price": "5000000000",
+            "gas_tip": "1"
+        }
+    }
+})json",
+        ExpectedError{
+            ".*Property with name \"gas_tip\" does not exists.*",
+            ExpectedError::ANY_CODE
+        }
+    },
+    // Transaction errors are reported as is.
+    {
+        R"json({
+    "blockchain": "Ethereum",
+    "net_type": 4,
+    "account": {
+        "type": 0,
+        "private_key": "d92c7ed86831ee78e76a9acbb91219ab1a7a399f69db20f04da8478e11a51900"
+    },
+    "builder": {
+        "type": "multisig",
+        "action": "new_request",
+        "payload": {
+            "balance": "1000",
+            "amount": "400000000000000000",
+            "wallet_address": "0x9b9A4102fB0F17aa2eE8e1Dbf8E8e3a62Cc01A3F",
+            "dest_address": "0x2B74679D2a190Fd679a85cE7767c05605237f030"
+        }
+    },
+    "transaction": {
+        "nonce": 2,
+        "fee": {
+            "gas_price": "5000000000",
+            "gas_limit": "141346"
+        }
+    }
+})json",
+        ExpectedError{
+            ".*Transaction is trying to spend more than available.*",
+            ExpectedError::ANY_CODE
+        }
+    }
+};
+
+INSTANTIATE_TEST_CASE_P(
+        EthereumKeyOrder,
+        JsonTransactionApiErrorTestP,
+        ::testing::ValuesIn(ETH_KEY_ORDER_ERROR_TEST_CASES));
+
+std::vector<JsonTransactionApiTestCase> get_all_test_cases()
+{
+    std::vector<JsonTransactionApiTestCase> result;
+    for (const auto& test_case : ETH_TEST_CASES)
+    {
+        result.push_back(test_case);
+    }
+    for (const auto& test_case : ETH_MULTISIG_TEST_CASES)
+    {
+        result.push_back(test_case);
+    }
+    for (const auto& test_case : ETH_ERC20_TEST_CASES)
+    {
+        result.push_back(test_case);
+    }
+    for (const auto& test_case : ETH_ERC721_TEST_CASES)
+    {
+        result.push_back(test_case);
+    }
+    return result;
+}
+
+void check_batch_results(const std::vector<JsonTransactionApiTestCase>& test_cases,
+        size_t invalid_request_index,
+        const char* batch_results)
+{
+    const Json::Value results = parse_json(batch_results);
+    ASSERT_EQ(test_cases.size() + 1, results.size());
+
+    for (size_t i = 0, case_index = 0; i < results.size(); ++i)
+    {
+        SCOPED_TRACE(i);
+        const Json::Value& result = results[static_cast<Json::ArrayIndex>(i)];
+        if (i == invalid_request_index)
+        {
+            ASSERT_TRUE(result.isMember("error"));
+            EXPECT_NE(0, result["error"]["code"].asInt());
+            EXPECT_NE(std::string::npos,
+                    result["error"]["message"].asString().find("Foo"));
+            continue;
+        }
+        EXPECT_EQ(parse_json(
+                test_cases[case_index++].expected_tx), result);
+    }
+}
+
+GTEST_TEST(JsonTransactionApiBatchTest, make_transactions_from_json_array)
+{
+    const std::vector<JsonTransactionApiTestCase> test_cases = get_all_test_cases();
+    const size_t INVALID_REQUEST_INDEX = 2;
+
+    Json::Value requests(Json::arrayValue);
+    for (size_t i = 0; i < test_cases.size(); ++i)
+    {
+        if (i == INVALID_REQUEST_INDEX)
+        {
+            requests.append(parse_json(R"json({"blockchain": "Foo"})json"));
+        }
+        requests.append(parse_json(test_cases[i].json_request));
+    }
+    const std::string requests_json = to_string(requests);
+
+    for (const size_t threads_count : {0, 1, 3})
+    {
+        SCOPED_TRACE(threads_count);
+        ConstCharPtr results;
+        HANDLE_ERROR(make_transactions_from_json(
+                requests_json.c_str(), threads_count, reset_sp(results)));
+        check_batch_results(test_cases, INVALID_REQUEST_INDEX, results.get());
+    }
+}
+
+GTEST_TEST(JsonTransactionApiBatchTest, make_transactions_from_json_ndjson)
+{
+    const std::vector<JsonTransactionApiTestCase> test_cases = get_all_test_cases();
+    const Json::ArrayIndex INVALID_REQUEST_INDEX = 0;
+
+    Json::StreamWriterBuilder writer;
+    writer["indentation"] = "";
+
+    // Invalid JSON on the first line and an empty line at the end.
+    std::string requests_ndjson = "{\"blockchain\": \"Foo\"\n";
+    for (const auto& test_case : test_cases)
+    {
+        requests_ndjson += Json::writeString(writer,
+                parse_json(test_case.json_request));
+        requests_ndjson += "\n";
+    }
+    requests_ndjson += "\n";
+
+    ConstCharPtr results;
+    HANDLE_ERROR(make_transactions_from_json(
+            requests_ndjson.c_str(), 0, reset_sp(results)));
+
+    const Json::Value results_json = parse_json(results.get());
+    ASSERT_EQ(test_cases.size() + 1, results_json.size());
+    EXPECT_TRUE(results_json[INVALID_REQUEST_INDEX].isMember("error"));
+    for (size_t i = 0; i < test_cases.size(); ++i)
+    {
+        SCOPED_TRACE(i);
+        EXPECT_EQ(parse_json(test_cases[i].expected_tx),
+                results_json[static_cast<Json::ArrayIndex>(i + 1)]);
+    }
+}
+
+GTEST_TEST(JsonTransactionApiBatchTest, make_transactions_from_json_invalid_args)
+{
+    ConstCharPtr results;
+    EXPECT_ERROR(make_transactions_from_json(nullptr, 0, reset_sp(results)));
+    EXPECT_ERROR(make_transactions_from_json("[]", 0, nullptr));
+    EXPECT_ERROR(make_transactions_from_json("[{]", 0, reset_sp(results)));
+
+    HANDLE_ERROR(make_transactions_from_json("", 0, reset_sp(results)));
+    EXPECT_STREQ("[]", results.get());
+}
+
+GTEST_TEST(JsonTransactionApiAccountCacheTest, account_cache)
+{
+    const JsonTransactionApiTestCase& test_case = ETH_KEY_ORDER_TEST_CASES[0];
+    size_t cache_size = 0;
+
+    HANDLE_ERROR(json_api_set_account_cache_capacity(2));
+    for (int i = 0; i < 3; ++i)
+    {
+        SCOPED_TRACE(i);
+        ConstCharPtr actual_tx;
+        HANDLE_ERROR(make_transaction_from_json(
+                test_case.json_request, reset_sp(actual_tx)));
+        EXPECT_EQ(parse_json(test_case.expected_tx), parse_json(actual_tx.get()));
+
+        HANDLE_ERROR(json_api_get_account_cache_size(&cache_size));
+        EXPECT_EQ(1u, cache_size);
+    }
+
+    HANDLE_ERROR(json_api_purge_account_cache());
+    HANDLE_ERROR(json_api_get_account_cache_size(&cache_size));
+    EXPECT_EQ(0u, cache_size);
+
+    HANDLE_ERROR(json_api_set_account_cache_capacity(0));
+    ConstCharPtr actual_tx;
+    HANDLE_ERROR(make_transaction_from_json(
+            test_case.json_request, reset_sp(actual_tx)));
+    HANDLE_ERROR(json_api_get_account_cache_size(&cache_size));
+    EXPECT_EQ(0u, cache_size);
+
+    EXPECT_ERROR(json_api_get_account_cache_size(nullptr));
+}
+
 } // unnamed namespace
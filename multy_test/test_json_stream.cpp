@@ -0,0 +1,220 @@
+/* Copyright 2018 by Multy.io
+ * Licensed under Multy.io license
+ *
+ * See LICENSE for details
+ */
+
+#include "multy_core/src/json_stream.h"
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <limits>
+#include <string>
+
+namespace
+{
+using namespace multy_core::internal;
+
+typedef JsonStreamReader Reader;
+
+JsonStreamReader make_reader(const char* json)
+{
+    return JsonStreamReader(json, strlen(json));
+}
+
+// Reads all tokens, returns false if input is malformed.
+bool read_all(const char* json)
+{
+    JsonStreamReader reader = make_reader(json);
+    for (;;)
+    {
+        switch (reader.next())
+        {
+            case Reader::TOKEN_INVALID:
+                return false;
+            case Reader::TOKEN_END:
+                return true;
+            default:
+                break;
+        }
+    }
+}
+
+} // namespace
+
+GTEST_TEST(JsonStreamReaderTest, tokens)
+{
+    JsonStreamReader reader = make_reader(
+            R"json( {"a": [1, -2.5e3, "x", true, false, null], "b": {}} )json");
+
+    EXPECT_EQ(Reader::TOKEN_BEGIN_OBJECT, reader.next());
+    EXPECT_EQ(1, reader.get_token_offset());
+
+    EXPECT_EQ(Reader::TOKEN_KEY, reader.next());
+    EXPECT_EQ("a", reader.get_value());
+    EXPECT_EQ(Reader::TOKEN_BEGIN_ARRAY, reader.next());
+    EXPECT_EQ(Reader::TOKEN_NUMBER, reader.next());
+    EXPECT_EQ("1", reader.get_value());
+    EXPECT_EQ(Reader::TOKEN_NUMBER, reader.next());
+    EXPECT_EQ("-2.5e3", reader.get_value());
+    EXPECT_EQ(Reader::TOKEN_STRING, reader.next());
+    EXPECT_EQ("x", reader.get_value());
+    EXPECT_EQ(Reader::TOKEN_TRUE, reader.next());
+    EXPECT_EQ(Reader::TOKEN_FALSE, reader.next());
+    EXPECT_EQ(Reader::TOKEN_NULL, reader.next());
+    EXPECT_EQ(Reader::TOKEN_END_ARRAY, reader.next());
+
+    EXPECT_EQ(Reader::TOKEN_KEY, reader.next());
+    EXPECT_EQ("b", reader.get_value());
+    EXPECT_EQ(Reader::TOKEN_BEGIN_OBJECT, reader.next());
+    EXPECT_EQ(Reader::TOKEN_END_OBJECT, reader.next());
+
+    EXPECT_EQ(Reader::TOKEN_END_OBJECT, reader.next());
+    EXPECT_EQ(Reader::TOKEN_END, reader.next());
+    EXPECT_EQ(Reader::TOKEN_END, reader.get_token());
+}
+
+GTEST_TEST(JsonStreamReaderTest, string_escapes)
+{
+    JsonStreamReader reader = make_reader(
+            R"json("a\"b\\c\/d\b\f\n\r\t\u0041\u00e9\u20ac\ud83d\ude00")json");
+
+    ASSERT_EQ(Reader::TOKEN_STRING, reader.next());
+    EXPECT_EQ("a\"b\\c/d\b\f\n\r\tA\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80",
+            reader.get_value());
+    EXPECT_EQ(Reader::TOKEN_END, reader.next());
+}
+
+GTEST_TEST(JsonStreamReaderTest, invalid_input)
+{
+    const char* INVALID_INPUTS[] = {
+        "",
+        "{",
+        "}",
+        "[1,]",
+        "{\"a\" 1}",
+        "{\"a\": 1,}",
+        "{1: 1}",
+        "[1 2]",
+        "[}",
+        "{]",
+        "\"abc",
+        "\"\\x\"",
+        "\"\\u12\"",
+        "\"\\ud83d\"",
+        "\"\\ud83d\\u0041\"",
+        "01",
+        "-",
+        "1.",
+        "1e",
+        "tru",
+        "nul",
+        "1 2",
+        "{} // comment",
+        "/* comment */ {}",
+    };
+
+    for (const char* input : INVALID_INPUTS)
+    {
+        SCOPED_TRACE(input);
+        EXPECT_FALSE(read_all(input));
+    }
+
+    JsonStreamReader reader = make_reader("[1 2]");
+    EXPECT_EQ(Reader::TOKEN_BEGIN_ARRAY, reader.next());
+    EXPECT_EQ(Reader::TOKEN_NUMBER, reader.next());
+    EXPECT_EQ(Reader::TOKEN_INVALID, reader.next());
+    // Stays invalid.
+    EXPECT_EQ(Reader::TOKEN_INVALID, reader.next());
+    EXPECT_FALSE(reader.skip_value());
+}
+
+GTEST_TEST(JsonStreamReaderTest, skip_value)
+{
+    const char* json = R"json({"skip": {"a": [1, {"b": []}]}, "next": 1})json";
+    JsonStreamReader reader = make_reader(json);
+
+    ASSERT_EQ(Reader::TOKEN_BEGIN_OBJECT, reader.next());
+    ASSERT_EQ(Reader::TOKEN_KEY, reader.next());
+    ASSERT_EQ(Reader::TOKEN_BEGIN_OBJECT, reader.next());
+    const size_t skipped_offset = reader.get_token_offset();
+    EXPECT_TRUE(reader.skip_value());
+    EXPECT_EQ(Reader::TOKEN_END_OBJECT, reader.get_token());
+
+    ASSERT_EQ(Reader::TOKEN_KEY, reader.next());
+    EXPECT_EQ("next", reader.get_value());
+    ASSERT_EQ(Reader::TOKEN_NUMBER, reader.next());
+    // Skipping a scalar is a no-op.
+    EXPECT_TRUE(reader.skip_value());
+    EXPECT_EQ(Reader::TOKEN_END_OBJECT, reader.next());
+    EXPECT_EQ(Reader::TOKEN_END, reader.next());
+
+    // Skipped value can be read later from its offset.
+    JsonStreamReader skipped_reader(json + skipped_offset, strlen(json) - skipped_offset);
+    ASSERT_EQ(Reader::TOKEN_BEGIN_OBJECT, skipped_reader.next());
+    ASSERT_EQ(Reader::TOKEN_KEY, skipped_reader.next());
+    EXPECT_EQ("a", skipped_reader.get_value());
+}
+
+GTEST_TEST(JsonStreamReaderTest, integers)
+{
+    JsonStreamReader reader = make_reader(
+            "[0, -9223372036854775808, 18446744073709551615, "
+            "18446744073709551616, 1.0, 1e3, \"1\"]");
+    int64_t int_value = 0;
+    uint64_t uint_value = 0;
+
+    ASSERT_EQ(Reader::TOKEN_BEGIN_ARRAY, reader.next());
+
+    ASSERT_EQ(Reader::TOKEN_NUMBER, reader.next());
+    EXPECT_TRUE(reader.get_int64(&int_value));
+    EXPECT_EQ(0, int_value);
+    EXPECT_TRUE(reader.get_uint64(&uint_value));
+    EXPECT_EQ(0u, uint_value);
+
+    ASSERT_EQ(Reader::TOKEN_NUMBER, reader.next());
+    EXPECT_TRUE(reader.get_int64(&int_value));
+    EXPECT_EQ(std::numeric_limits<int64_t>::min(), int_value);
+    EXPECT_FALSE(reader.get_uint64(&uint_value));
+
+    ASSERT_EQ(Reader::TOKEN_NUMBER, reader.next());
+    EXPECT_FALSE(reader.get_int64(&int_value));
+    EXPECT_TRUE(reader.get_uint64(&uint_value));
+    EXPECT_EQ(std::numeric_limits<uint64_t>::max(), uint_value);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        SCOPED_TRACE(i);
+        ASSERT_EQ(Reader::TOKEN_NUMBER, reader.next());
+        EXPECT_FALSE(reader.get_int64(&int_value));
+        EXPECT_FALSE(reader.get_uint64(&uint_value));
+    }
+
+    ASSERT_EQ(Reader::TOKEN_STRING, reader.next());
+    EXPECT_FALSE(reader.get_int64(&int_value));
+    EXPECT_FALSE(reader.get_uint64(&uint_value));
+}
+
+GTEST_TEST(JsonStreamWriterTest, write)
+{
+    JsonStreamWriter writer;
+    writer.begin_object()
+            .key("a").begin_array()
+                    .value(int64_t(-1))
+                    .value("x")
+                    .value(std::string("q\"\\\n\x01"))
+                    .raw_value("{\"raw\":true}")
+                    .begin_object().end_object()
+            .end_array()
+            .key("b").value(int64_t(2))
+            .end_object();
+
+    EXPECT_EQ(R"json({"a":[-1,"x","q\"\\\n\u0001",{"raw":true},{}],"b":2})json",
+            writer.get_string());
+
+    writer.clear();
+    EXPECT_EQ("", writer.get_string());
+    writer.begin_array().value("y").end_array();
+    EXPECT_EQ(R"json(["y"])json", writer.get_string());
+}
@@ -13,6 +13,8 @@
 #include "multy_core/src/api/big_int_impl.h"
 #include "multy_core/src/api/key_impl.h"
 #include "multy_core/src/exception.h"
+#include "multy_core/src/exception_stream.h"
+#include "multy_core/src/property_predicates.h"
 #include "multy_core/src/u_ptr.h"
 #include "multy_core/src/utility.h"
 
@@ -23,6 +25,7 @@
 #include "gtest/gtest.h"
 
 #include <memory>
+#include <type_traits>
 
 struct BinaryData;
 namespace
@@ -161,6 +164,39 @@ GTEST_TEST(PropertiesTestInvalidArgs, properties_set_private_key_value)
     EXPECT_NE(nullptr, priv_key_property1);
 }
 
+GTEST_TEST(PropertiesTestInvalidArgs, properties_set_values)
+{
+    Properties properties(ERROR_SCOPE_GENERIC, "TEST");
+    int32_t int_property = 0;
+    std::string string_property = "2";
+    properties.bind_property("i", &int_property);
+    properties.bind_property("s", &string_property);
+
+    PropertyValue values[2];
+    values[0].name = "i";
+    values[0].type = PROPERTY_VALUE_TYPE_INT32;
+    values[0].value.int32_value = 1;
+    values[1].name = "s";
+    values[1].type = PROPERTY_VALUE_TYPE_STRING;
+    values[1].value.string_value = nullptr;
+
+    // Arguments are checked before anything is set.
+    EXPECT_ERROR(properties_set_values(&properties, values, 2));
+    EXPECT_EQ(0, int_property);
+
+    values[1].name = nullptr;
+    values[1].value.string_value = "1";
+    EXPECT_ERROR(properties_set_values(&properties, values, 2));
+    EXPECT_EQ(0, int_property);
+
+    values[1].name = "unknown";
+    EXPECT_ERROR(properties_set_values(&properties, values, 2));
+    EXPECT_STREQ("2", string_property.c_str());
+
+    EXPECT_ERROR(properties_set_values(nullptr, values, 1));
+    EXPECT_ERROR(properties_set_values(&properties, nullptr, 1));
+}
+
 GTEST_TEST(PropertiesTestInvalidArgs, properties_reset_value)
 {
     Properties properties(ERROR_SCOPE_GENERIC, "TEST");
@@ -469,6 +505,68 @@ GTEST_TEST(PropertiesTest, properties_set_private_key_value)
     EXPECT_EQ(*priv_key_property, *priv_key_property1);
 }
 
+GTEST_TEST(PropertiesTest, properties_set_values)
+{
+    Properties properties(ERROR_SCOPE_GENERIC, "TEST");
+    int32_t int_property = 0;
+    std::string string_property;
+    BigInt amount_property(0);
+    BinaryDataPtr binary_data_property;
+    properties.bind_property("i", &int_property);
+    properties.bind_property("s", &string_property);
+    properties.bind_property("a", &amount_property);
+    properties.bind_property("b", &binary_data_property);
+
+    const BigInt amount(42);
+    const unsigned char data[] = {1U, 2U, 3U};
+    const BinaryData binary_data = {data, sizeof(data)};
+
+    PropertyValue values[4];
+    values[0].name = "i";
+    values[0].type = PROPERTY_VALUE_TYPE_INT32;
+    values[0].value.int32_value = 7;
+    values[1].name = "s";
+    values[1].type = PROPERTY_VALUE_TYPE_STRING;
+    values[1].value.string_value = "str";
+    values[2].name = "a";
+    values[2].type = PROPERTY_VALUE_TYPE_BIG_INT;
+    values[2].value.big_int_value = &amount;
+    values[3].name = "b";
+    values[3].type = PROPERTY_VALUE_TYPE_BINARY_DATA;
+    values[3].value.binary_data_value = &binary_data;
+
+    HANDLE_ERROR(properties_set_values(&properties, nullptr, 0));
+    HANDLE_ERROR(properties_set_values(&properties, values, 4));
+
+    EXPECT_EQ(7, int_property);
+    EXPECT_STREQ("str", string_property.c_str());
+    EXPECT_EQ(amount, amount_property);
+    ASSERT_NE(nullptr, binary_data_property);
+    EXPECT_EQ(binary_data, *binary_data_property);
+    EXPECT_TRUE(properties.validate(nullptr));
+}
+
+GTEST_TEST(PropertiesTest, get_generation)
+{
+    Properties properties(ERROR_SCOPE_GENERIC, "TEST");
+    int32_t int_property = 0;
+    properties.bind_property("i", &int_property);
+
+    const uint64_t initial = properties.get_generation();
+
+    properties.set_property_value("i", 1);
+    const uint64_t after_set = properties.get_generation();
+    EXPECT_LT(initial, after_set);
+
+    // Validation resets dirty flag, but doesn't change generation.
+    EXPECT_TRUE(properties.validate(nullptr));
+    EXPECT_FALSE(properties.is_dirty());
+    EXPECT_EQ(after_set, properties.get_generation());
+
+    properties.reset_property("i");
+    EXPECT_LT(after_set, properties.get_generation());
+}
+
 GTEST_TEST(PropertiesTest, properties_reset_value)
 {
     Properties properties(ERROR_SCOPE_GENERIC, "TEST");
@@ -872,3 +970,51 @@ REGISTER_TYPED_TEST_CASE_P(FunctionalPropertyT_TestP,
         Properties_SmokeTest, FunctionalPropertyT_SmokeTest);
 
 INSTANTIATE_TYPED_TEST_CASE_P(PropertiesTest, FunctionalPropertyT_TestP, PropertyT_Types);
+
+GTEST_TEST(PropertiesTest, PropertyT_predicates)
+{
+    const int32_t limit = 10;
+    const auto capturing_predicate = [limit](const int32_t& new_value)
+    {
+        if (new_value > limit)
+        {
+            THROW_EXCEPTION("Value is too big.");
+        }
+    };
+    const auto stateless_predicate = [](const int32_t& new_value)
+    {
+        verify_bigger_than<int32_t, 0>(new_value);
+    };
+
+    // Only capturing lambdas are wrapped into std::function.
+    static_assert(std::is_same<Property::PredicateFunction<int32_t>,
+            decltype(Property::make_predicate<int32_t>(stateless_predicate))>::value,
+            "stateless predicate should be a plain function");
+    static_assert(std::is_same<Property::PredicateFunction<int32_t>,
+            decltype(Property::make_predicate<int32_t>(&verify_bigger_than<int32_t, 0>))>::value,
+            "function predicate should be a plain function");
+    static_assert(std::is_same<Property::Predicate<int32_t>,
+            decltype(Property::make_predicate<int32_t>(capturing_predicate))>::value,
+            "capturing predicate should be a std::function");
+
+    Properties properties(ERROR_SCOPE_GENERIC, "TEST");
+    PropertyT<int32_t> function_property(properties, "function",
+            Property::REQUIRED, &verify_bigger_than<int32_t, 0>);
+    PropertyT<int32_t> stateless_property(properties, "stateless",
+            Property::REQUIRED, stateless_predicate);
+    PropertyT<int32_t> capturing_property(properties, "capturing",
+            Property::REQUIRED, capturing_predicate);
+    PropertyT<int32_t> no_predicate_property(properties, "none");
+
+    EXPECT_THROW(function_property.set_value(-1), Exception);
+    EXPECT_THROW(stateless_property.set_value(-1), Exception);
+    EXPECT_THROW(capturing_property.set_value(11), Exception);
+    EXPECT_FALSE(properties.validate(nullptr));
+
+    function_property.set_value(1);
+    stateless_property.set_value(1);
+    capturing_property.set_value(10);
+    no_predicate_property.set_value(-1);
+    EXPECT_TRUE(properties.validate(nullptr));
+    EXPECT_EQ(10, *capturing_property);
+}
@@ -19,6 +19,7 @@
 #include "gtest/gtest.h"
 
 #include <memory>
+#include <vector>
 
 namespace
 {
@@ -60,6 +61,15 @@ GTEST_TEST(TransactionTestInvalidArgs, transaction_add_source)
     EXPECT_ERROR(transaction_add_source(&transaction, nullptr));
 }
 
+GTEST_TEST(TransactionTestInvalidArgs, transaction_add_sources)
+{
+    TestTransaction transaction;
+    Properties* sources[2];
+
+    EXPECT_ERROR(transaction_add_sources(nullptr, 2, sources));
+    EXPECT_ERROR(transaction_add_sources(&transaction, 2, nullptr));
+}
+
 GTEST_TEST(TransactionTestInvalidArgs, transaction_add_destination)
 {
     TestTransaction transaction;
@@ -135,6 +145,28 @@ GTEST_TEST(TransactionTestInvalidArgs, transaction_serialize_encoded)
     EXPECT_ERROR(transaction_serialize_encoded(&transaction, nullptr));
 }
 
+GTEST_TEST(TransactionTestInvalidArgs, transaction_get_serialized_size)
+{
+    TestTransaction transaction;
+    size_t size = 0;
+
+    EXPECT_ERROR(transaction_get_serialized_size(nullptr, &size));
+    EXPECT_ERROR(transaction_get_serialized_size(&transaction, nullptr));
+}
+
+GTEST_TEST(TransactionTestInvalidArgs, transaction_serialize_into)
+{
+    TestTransaction transaction;
+    unsigned char buffer[16];
+    size_t written = 0;
+
+    EXPECT_ERROR(transaction_serialize_into(nullptr, buffer, sizeof(buffer), &written));
+    EXPECT_ERROR(transaction_serialize_into(&transaction, nullptr, sizeof(buffer), &written));
+    EXPECT_ERROR(transaction_serialize_into(&transaction, buffer, sizeof(buffer), nullptr));
+    EXPECT_ERROR_WITH_CODE(transaction_serialize_into(&transaction, buffer, 1, &written),
+            ERROR_TRANSACTION_BUFFER_TOO_SMALL);
+}
+
 GTEST_TEST(TransactionTestInvalidArgs, transaction_set_message)
 {
     TestTransaction transaction;
@@ -182,6 +214,45 @@ GTEST_TEST(TransactionTest, transaction_add_source)
     HANDLE_ERROR(transaction_add_source(&transaction, &properties));
 }
 
+GTEST_TEST(TransactionTest, transaction_add_sources)
+{
+    TestTransaction transaction;
+    Properties* sources[3] = {nullptr, nullptr, nullptr};
+
+    HANDLE_ERROR(transaction_add_sources(&transaction, 0, nullptr));
+    HANDLE_ERROR(transaction_add_sources(&transaction, 3, sources));
+    for (Properties* source : sources)
+    {
+        EXPECT_NE(nullptr, source);
+    }
+}
+
+GTEST_TEST(TransactionTest, transaction_add_sources_partial_failure)
+{
+    AccountPtr account;
+    HANDLE_ERROR(make_account(
+            ETHEREUM_TEST_NET,
+            ACCOUNT_TYPE_DEFAULT,
+            "5a37680b86fabdec299fa02bdfba8c9dfad08d796dc58c1d07527a751905bf71",
+            reset_sp(account)));
+
+    TransactionPtr transaction;
+    HANDLE_ERROR(make_transaction(account.get(), reset_sp(transaction)));
+
+    // Ethereum transaction supports only one source, so second one fails.
+    Properties* dummy = reinterpret_cast<Properties*>(1);
+    Properties* sources[2] = {dummy, dummy};
+    EXPECT_ERROR_WITH_CODE(transaction_add_sources(transaction.get(), 2, sources),
+            ERROR_TRANSACTION_TOO_MANY_SOURCES);
+    EXPECT_EQ(nullptr, sources[0]);
+    EXPECT_EQ(nullptr, sources[1]);
+
+    // First source remains added.
+    Properties* source = nullptr;
+    EXPECT_ERROR_WITH_CODE(transaction_add_source(transaction.get(), &source),
+            ERROR_TRANSACTION_TOO_MANY_SOURCES);
+}
+
 GTEST_TEST(TransactionTest, transaction_add_destination)
 {
     TestTransaction transaction;
@@ -242,6 +313,24 @@ GTEST_TEST(TransactionTest, transaction_serialize_encoded)
     HANDLE_ERROR(transaction_serialize_encoded(&transaction, reset_sp(serialized)));
 }
 
+GTEST_TEST(TransactionTest, transaction_serialize_into)
+{
+    TestTransaction transaction;
+    BinaryDataPtr serialized;
+    HANDLE_ERROR(transaction_serialize(&transaction, reset_sp(serialized)));
+
+    size_t size = 0;
+    HANDLE_ERROR(transaction_get_serialized_size(&transaction, &size));
+    EXPECT_EQ(serialized->len, size);
+
+    std::vector<unsigned char> buffer(size);
+    size_t written = 0;
+    HANDLE_ERROR(transaction_serialize_into(
+            &transaction, buffer.data(), buffer.size(), &written));
+    EXPECT_EQ(size, written);
+    EXPECT_EQ(*serialized, as_binary_data(buffer));
+}
+
 GTEST_TEST(TransactionTest, transaction_set_message)
 {
     TestTransaction transaction;
@@ -0,0 +1,94 @@
+/* Copyright 2018 by Multy.io
+ * Licensed under Multy.io license
+ *
+ * See LICENSE for details
+ */
+
+#include "multy_core/src/uint256.h"
+
+#include "multy_core/src/api/big_int_impl.h"
+#include "multy_core/src/exception.h"
+
+#include "multy_test/value_printers.h"
+#include "multy_test/utility.h"
+
+#include "gtest/gtest.h"
+
+#include <array>
+
+namespace
+{
+using namespace test_utility;
+using namespace multy_core::internal;
+
+// 2^256 - 1
+const char* MAX_UINT256 =
+        "115792089237316195423570985008687907853269984665640564039457584007913129639935";
+
+} // namespace
+
+GTEST_TEST(Uint256Test, big_int_round_trip)
+{
+    const char* VALUES[] = {
+        "0",
+        "1",
+        "255",
+        "18446744073709551615",
+        "18446744073709551616",
+        "340282366920938463463374607431768211456",
+        MAX_UINT256
+    };
+
+    for (const char* value : VALUES)
+    {
+        SCOPED_TRACE(value);
+        EXPECT_EQ(BigInt(value), Uint256(BigInt(value)).to_big_int());
+    }
+}
+
+GTEST_TEST(Uint256Test, invalid_big_int)
+{
+    EXPECT_THROW(Uint256(BigInt(-1)), Exception);
+    EXPECT_THROW(Uint256(BigInt(MAX_UINT256) + 1), Exception);
+}
+
+GTEST_TEST(Uint256Test, math)
+{
+    const Uint256 max(BigInt{MAX_UINT256});
+    const Uint256 two_64 = Uint256(UINT64_MAX) + Uint256(1);
+
+    EXPECT_EQ(BigInt("36893488147419103230"),
+            (Uint256(UINT64_MAX) + Uint256(UINT64_MAX)).to_big_int());
+    EXPECT_EQ(BigInt("340282366920938463463374607431768211456"),
+            (two_64 * two_64).to_big_int());
+    EXPECT_EQ(BigInt("340282366920938463426481119284349108225"),
+            (Uint256(UINT64_MAX) * Uint256(UINT64_MAX)).to_big_int());
+    EXPECT_EQ(Uint256(UINT64_MAX), two_64 - Uint256(1));
+    EXPECT_EQ(max, (max - Uint256(1)) + Uint256(1));
+    EXPECT_EQ(Uint256(0), max - max);
+
+    EXPECT_THROW(max + Uint256(1), Exception);
+    EXPECT_THROW(Uint256(0) - Uint256(1), Exception);
+    EXPECT_THROW(two_64 * two_64 * two_64 * two_64, Exception);
+    EXPECT_THROW(max * Uint256(2), Exception);
+    EXPECT_EQ(max, max * Uint256(1));
+    EXPECT_EQ(Uint256(), max * Uint256());
+
+    EXPECT_LT(Uint256(UINT64_MAX), two_64);
+    EXPECT_GT(max, two_64);
+    EXPECT_EQ(0, max.compare(max));
+}
+
+GTEST_TEST(Uint256Test, write_big_endian)
+{
+    const Uint256 value(0x0102);
+    EXPECT_EQ(2, value.get_bytes_len());
+    EXPECT_EQ(0, Uint256().get_bytes_len());
+
+    std::array<uint8_t, 4> buffer;
+    value.write_big_endian(buffer.data(), buffer.size());
+    EXPECT_EQ(as_binary_data(from_hex("00000102")), as_binary_data(buffer));
+
+    EXPECT_THROW(value.write_big_endian(buffer.data(), 1), Exception);
+    EXPECT_EQ(value, Uint256::from_big_endian(buffer.data(), buffer.size()));
+}
@@ -6,13 +6,17 @@
 
 #include "multy_core/src/utility.h"
 #include "multy_core/src/exception.h"
+#include "multy_core/src/worker_pool.h"
 
 #include "multy_test/value_printers.h"
 #include "multy_test/utility.h"
 
 #include "gtest/gtest.h"
 
+#include <atomic>
 #include <memory>
+#include <stdexcept>
+#include <vector>
 
 namespace
 {
@@ -269,3 +273,48 @@ GTEST_TEST(UtilityTest, skip_leading_zeroes)
     ASSERT_EQ(null_binary_data, as_binary_data("\0\0"));
     ASSERT_EQ(null_binary_data, as_binary_data("\0test\0"));
 }
+
+GTEST_TEST(UtilityTest, worker_pool_run_for_each)
+{
+    WorkerPool pool(3);
+    ASSERT_EQ(3, pool.get_threads_count());
+
+    std::vector<int> values(1000, 0);
+    pool.run_for_each(values.size(), [&values](size_t i)
+    {
+        values[i] += static_cast<int>(i);
+    });
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        ASSERT_EQ(static_cast<int>(i), values[i]);
+    }
+
+    std::atomic<size_t> calls(0);
+    pool.run_for_each(0, [&calls](size_t) { ++calls; });
+    EXPECT_EQ(0, calls);
+}
+
+GTEST_TEST(UtilityTest, worker_pool_rethrows_first_error)
+{
+    WorkerPool pool(4);
+
+    std::atomic<size_t> calls(0);
+    try
+    {
+        pool.run_for_each(100, [&calls](size_t i)
+        {
+            ++calls;
+            if (i % 10 == 7)
+            {
+                throw std::runtime_error(std::to_string(i));
+            }
+        });
+        FAIL() << "Expected an exception.";
+    }
+    catch (const std::runtime_error& e)
+    {
+        EXPECT_STREQ("7", e.what());
+    }
+    // All tasks are executed even if some of them fail.
+    EXPECT_EQ(100, calls);
+}